@@ -3,7 +3,8 @@
 #include <cstring>
 #include <vector>
 #include <mutex>
-#include <queue>
+#include <algorithm>
+#include <chrono>
 #include <atomic>
 #include "app_config.hpp"
 #include "cg_enums.h"
@@ -43,6 +44,8 @@ typedef SOCKET socket_t;
 #include <arpa/inet.h>
 #include <errno.h>
 #include <fcntl.h> // For fcntl(), F_GETFL, F_SETFL, O_NONBLOCK
+#include <poll.h>
+#include <sys/uio.h> // For writev()
 
 typedef int socket_t;
 #define CLOSESOCKET close
@@ -54,53 +57,271 @@ std::atomic<socket_t> server_fd{INVALID_SOCKET};
 socket_t client_socket = INVALID_SOCKET;
 
 static CG_MUTEX queue_mutex;
-using Msg = std::vector<uint8_t>; // Node ID, Data
 
-static std::queue<Msg> msg_to_host;
+// Messages to host are packed directly into preallocated slots.
+// A slot starts with the 32-bit length of the message expected by the host.
+// Slot storage is only reallocated when a message bigger than all previous
+// ones is sent, so in steady state no heap allocation is done.
+struct HostMsg
+{
+    std::vector<uint8_t> data;
+    std::size_t size = 0;
+};
+
+static HostMsg msg_to_host[MAX_NB_HOST_MSGS];
+static std::size_t msg_read = 0;
+static std::size_t msg_write = 0;
+static std::size_t msg_nb = 0;
+
+// Return slot where a message of size bytes can be written
+// or nullptr if the queue is full. Must be called with the queue mutex.
+static uint8_t *reserve_host_msg(std::size_t size)
+{
+    // Messages to host are ignored when there is
+    // an overflow of the FIFO
+    if ((client_socket == INVALID_SOCKET) || (msg_nb >= MAX_NB_HOST_MSGS))
+    {
+        return nullptr;
+    }
+    HostMsg &msg = msg_to_host[msg_write];
+    if (msg.data.size() < size + 4)
+    {
+        msg.data.resize(std::max<std::size_t>(size + 4, HOST_MSG_SLOT_SIZE));
+    }
+    uint32_t msg_len = (uint32_t)size;
+    memcpy(msg.data.data(), &msg_len, 4);
+    msg.size = size + 4;
+    return msg.data.data() + 4;
+}
+
+static void commit_host_msg()
+{
+    msg_write++;
+    if (msg_write == MAX_NB_HOST_MSGS)
+    {
+        msg_write = 0;
+    }
+    msg_nb++;
+}
+
+// Small events are coalesced in a batch frame built in the slot at
+// msg_write. The batch is closed when it reaches HOST_BATCH_MAX_SIZE bytes
+// or when it is older than HOST_BATCH_WINDOW_MS (checked by process_queue).
+static bool batch_open = false;
+static uint32_t batch_nb_events = 0;
+static std::chrono::steady_clock::time_point batch_start;
+
+static void write_u32(uint8_t *dst, uint32_t v)
+{
+    memcpy(dst, &v, 4);
+}
+
+// Must be called with the queue mutex
+static void close_batch_locked()
+{
+    if (batch_open)
+    {
+        batch_open = false;
+        commit_host_msg();
+    }
+}
+
+// Must be called with the queue mutex
+static void add_to_batch_locked(int nodeid, const Event &evt, std::size_t size)
+{
+    if (batch_open && (msg_to_host[msg_write].size + 4 + size > HOST_BATCH_MAX_SIZE))
+    {
+        close_batch_locked();
+    }
+    if (!batch_open)
+    {
+        uint8_t *dst = reserve_host_msg(8);
+        if (dst == nullptr)
+        {
+            return;
+        }
+        write_u32(dst, kBatchFrameMarker);
+        write_u32(dst + 4, 0);
+        batch_open = true;
+        batch_nb_events = 0;
+        batch_start = std::chrono::steady_clock::now();
+    }
+
+    HostMsg &msg = msg_to_host[msg_write];
+    if (msg.data.size() < msg.size + 4 + size)
+    {
+        msg.data.resize(std::max<std::size_t>(msg.size + 4 + size, HOST_BATCH_MAX_SIZE));
+    }
+    uint8_t *dst = msg.data.data() + msg.size;
+    write_u32(dst, (uint32_t)size);
+    if (pack(nodeid, evt, dst + 4, size, true) != size)
+    {
+        return;
+    }
+    msg.size += 4 + size;
+    batch_nb_events++;
+    // Frame length and number of events in the batch
+    write_u32(msg.data.data(), (uint32_t)(msg.size - 4));
+    write_u32(msg.data.data() + 8, batch_nb_events);
+
+    if ((msg.size >= HOST_BATCH_MAX_SIZE) || (HOST_BATCH_WINDOW_MS == 0))
+    {
+        close_batch_locked();
+    }
+}
 
 void send_data_to_host(const char *data, std::size_t size)
 {
     CG_MUTEX_ERROR_TYPE error;
     CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
-    if (client_socket != INVALID_SOCKET)
+    // The open batch uses the slot at msg_write and must be sent first
+    close_batch_locked();
+    uint8_t *dst = reserve_host_msg(size);
+    if (dst != nullptr)
+    {
+        memcpy(dst, data, size);
+        commit_host_msg();
+    }
+    CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
+}
+
+#if !defined(_WIN32)
+static bool flush_queue_locked();
+
+// Send all the segments with writev, waiting when the
+// non blocking socket is full.
+// The queue mutex is held so the wait is limited to HOST_SEND_TIMEOUT_MS.
+// If the host stops reading in the middle of the frame, the connection
+// is shut down since the stream of frames can't be resynchronized.
+static bool writev_all(socket_t sock, const cg_iovec *segments, std::size_t nb)
+{
+    struct iovec iov[HOST_MAX_SEGMENTS];
+    if (nb > HOST_MAX_SEGMENTS)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < nb; i++)
+    {
+        iov[i].iov_base = const_cast<void *>(segments[i].base);
+        iov[i].iov_len = segments[i].len;
+    }
+
+    struct iovec *current = iov;
+    int remaining = (int)nb;
+    bool started = false;
+    while (remaining > 0)
     {
-        // Message is nodeid and event
-        // Messages to host are ignored when there is
-        // an overflow of the FIFO
-        if (msg_to_host.size() < MAX_NB_HOST_MSGS)
+        ssize_t sent = writev(sock, current, remaining);
+        if (sent < 0)
+        {
+            if ((errno == EWOULDBLOCK) || (errno == EAGAIN))
+            {
+                struct pollfd pfd = {sock, POLLOUT, 0};
+                if (poll(&pfd, 1, HOST_SEND_TIMEOUT_MS) > 0)
+                {
+                    continue;
+                }
+                if (started)
+                {
+                    CMSISSTREAM_LOG_ERR("Host stalled in the middle of a frame\n");
+                    shutdown(sock, SHUT_RDWR);
+                }
+                else
+                {
+                    CMSISSTREAM_LOG_ERR("Host not reading: event dropped\n");
+                }
+                return false;
+            }
+            CMSISSTREAM_LOG_ERR("Send failed: %d\n", errno);
+            return false;
+        }
+        started = true;
+        while ((remaining > 0) && ((std::size_t)sent >= current->iov_len))
+        {
+            sent -= current->iov_len;
+            current++;
+            remaining--;
+        }
+        if (remaining > 0)
         {
-            msg_to_host.push(std::vector<uint8_t>(data, data + size));
+            current->iov_base = (uint8_t *)current->iov_base + sent;
+            current->iov_len -= sent;
+        }
+    }
+    return true;
+}
+
+// Big events are not copied into the queue. The tensor and buffer
+// payloads are sent directly from their storage with one writev.
+// Events with more than HOST_MAX_SEGMENTS segments are copied
+// into the queue.
+static void send_event_gather(int nodeid, const Event &evt, std::size_t size)
+{
+    static PackGather packer;
+    CG_MUTEX_ERROR_TYPE error;
+    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+    close_batch_locked();
+    if ((client_socket != INVALID_SOCKET) && flush_queue_locked())
+    {
+        bool too_many_segments = false;
+        (void)packer.pack(nodeid, evt,
+                          [&too_many_segments](const cg_iovec *segments, std::size_t nb,
+                                               std::size_t)
+                          {
+                              if (nb > HOST_MAX_SEGMENTS)
+                              {
+                                  too_many_segments = true;
+                                  return false;
+                              }
+                              return writev_all(client_socket, segments, nb);
+                          },
+                          true, true);
+        if (too_many_segments)
+        {
+            uint8_t *dst = reserve_host_msg(size);
+            if (dst != nullptr)
+            {
+                if (pack(nodeid, evt, dst, size, true) == size)
+                {
+                    commit_host_msg();
+                }
+                (void)flush_queue_locked();
+            }
         }
     }
     CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
 }
+#endif
 
 void send_event_to_host(int nodeid, Event &&evt)
 {
-    Pack packer;
     // event id, valued id, value
     // value can be normal value
     // or combined value
-    packer.pack(nodeid, std::move(evt),true);
+    std::size_t size = packedSize(nodeid, evt, true);
 
-    std::vector<uint8_t> d = packer.vector();
-    // for(const uint8_t &byte : d)
-    //{
-    //     printf("\\x%02x", byte);
-    // }
-    // std::cout << std::endl;
+#if !defined(_WIN32)
+    if (size + 4 > HOST_MSG_SLOT_SIZE)
+    {
+        send_event_gather(nodeid, evt, size);
+        return;
+    }
+#endif
 
-    send_data_to_host((const char *)d.data(), d.size());
+    CG_MUTEX_ERROR_TYPE error;
+    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+    add_to_batch_locked(nodeid, evt, size);
+    CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
 }
 
 void clean_queue()
 {
     CG_MUTEX_ERROR_TYPE error;
     CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
-    while (!msg_to_host.empty())
-    {
-        msg_to_host.pop();
-    }
+    batch_open = false;
+    msg_read = 0;
+    msg_write = 0;
+    msg_nb = 0;
     CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
 }
 
@@ -120,29 +341,19 @@ std::size_t send_all(socket_t sock, const char *data, std::size_t len)
     return total_sent;
 }
 
-void process_queue()
+// Must be called with the queue mutex
+static bool flush_queue_locked()
 {
-    CG_MUTEX_ERROR_TYPE error;
-    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
-    // std::cout << "process_queue: msg_to_host.size()=" << msg_to_host.size() << std::endl;
-
-    while (!msg_to_host.empty())
+    bool ok = true;
+    while (msg_nb != 0)
     {
         if (client_socket != INVALID_SOCKET)
         {
-            Msg msg = msg_to_host.front();
-            msg_to_host.pop();
-
+            const HostMsg &msg = msg_to_host[msg_read];
             std::size_t bytes_sent;
-            std::size_t msg_len;
-            // Size of message not include the msg length field
-            msg_len = msg.size();
-            char *data = (char *)malloc(msg_len + 4);
-            memcpy(data, &msg_len, 4);                // Copy size at the beginning
-            memcpy(data + 4, msg.data(), msg.size()); // Copy data after size and node ID
-
-            bytes_sent = send_all(client_socket, data, msg_len + 4);
-            free(data);
+
+            // Slot already contains the message length
+            bytes_sent = send_all(client_socket, (const char *)msg.data.data(), msg.size);
             if (bytes_sent == SOCKET_ERROR)
             {
 #if defined(_WIN32)
@@ -151,9 +362,30 @@ void process_queue()
                 int err = errno;
 #endif
                 printf("Send failed: %d\n", err);
+                ok = false;
             }
         }
+        msg_read++;
+        if (msg_read == MAX_NB_HOST_MSGS)
+        {
+            msg_read = 0;
+        }
+        msg_nb--;
+    }
+    return ok;
+}
+
+void process_queue()
+{
+    CG_MUTEX_ERROR_TYPE error;
+    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+    // std::cout << "process_queue: msg_nb=" << msg_nb << std::endl;
+    if (batch_open &&
+        (std::chrono::steady_clock::now() - batch_start >= std::chrono::milliseconds(HOST_BATCH_WINDOW_MS)))
+    {
+        close_batch_locked();
     }
+    (void)flush_queue_locked();
     CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
     // std::cout << "process_queue: done\n";
 }
@@ -162,16 +394,46 @@ void process_queue()
 class MessageReceiver
 {
     socket_t sock;
-    std::vector<uint8_t> buffer;
+    // Length of the message being received
+    uint8_t header[4];
+    std::size_t header_pos = 0;
+    // Messages are received directly in a frame that can be
+    // aliased by the unpacked tensors and buffers
+    RecvFrame *frame = nullptr;
+    std::size_t frame_pos = 0;
 
 public:
     MessageReceiver(socket_t socket_fd,EventQueue *queue) : sock(socket_fd),queue_(queue) {}
 
+    ~MessageReceiver()
+    {
+        if (frame != nullptr)
+        {
+            frame->release();
+        }
+    }
+
     bool receiveMessages()
     {
-        char temp[4096];
-        int bytes_received = recv(sock, temp, sizeof(temp), 0);
-        if (bytes_received <= 0)
+        uint8_t *dst;
+        std::size_t remaining;
+        if (frame == nullptr)
+        {
+            dst = header + header_pos;
+            remaining = sizeof(header) - header_pos;
+        }
+        else
+        {
+            dst = frame->data() + frame_pos;
+            remaining = frame->size() - frame_pos;
+        }
+
+        int bytes_received = 0;
+        if (remaining > 0)
+        {
+            bytes_received = recv(sock, (char *)dst, (int)remaining, 0);
+        }
+        if ((remaining > 0) && (bytes_received <= 0))
         {
 #if defined(_WIN32)
             int err = WSAGetLastError();
@@ -212,29 +474,37 @@ public:
 #endif
         }
 
-        buffer.insert(buffer.end(), temp, temp + bytes_received);
-
-        // Process all complete messages in buffer
-        while (true)
+        if (frame == nullptr)
         {
-            // std::cout << "Buffer size: " << buffer.size() << std::endl;
-            if (buffer.size() < 4)
-                break; // Not enough data for header
+            header_pos += bytes_received;
+            if (header_pos < sizeof(header))
+                return true; // Not enough data for header
 
             // Extract message length
             uint32_t msg_len;
-            std::memcpy(&msg_len, buffer.data(), 4);
+            std::memcpy(&msg_len, header, 4);
             // std::cout << "Message len: " << msg_len << std::endl;
             //  msg_len = ntohl(msg_len); // Assume network byte order
+            header_pos = 0;
+            frame_pos = 0;
+            frame = RecvFrame::create(msg_len);
+            if (frame == nullptr)
+            {
+                std::cerr << "Can't allocate receive frame\n";
+                return false;
+            }
+        }
+        else
+        {
+            frame_pos += bytes_received;
+        }
 
-            if (buffer.size() < 4 + msg_len)
-                break; // Wait for full message
-
-            // Extract full message
-            std::vector<uint8_t> message(buffer.begin() + 4, buffer.begin() + 4 + msg_len);
-            handleMessage(message);
-            // Remove processed message from buffer
-            buffer.erase(buffer.begin(), buffer.begin() + 4 + msg_len);
+        if (frame_pos == frame->size())
+        {
+            handleMessage(frame);
+            // Tensors received in the message keep the frame alive
+            frame->release();
+            frame = nullptr;
             // To send data to host
             process_queue();
         }
@@ -242,13 +512,29 @@ public:
         return true;
     }
 
-    void handleMessage(const std::vector<uint8_t> &message)
+    void handleMessage(RecvFrame *message)
     {
         uint32_t node_id;
 
-        Unpack unpack(message.data(), message.size());
+        if (UnpackBatch::isBatch(message->data(), message->size()))
+        {
+            UnpackBatch unpack(message);
+            Event evt;
+            while (unpack.next(node_id, evt))
+            {
+                dispatchEvent(node_id, std::move(evt));
+            }
+            return;
+        }
+
+        Unpack unpack(message);
 
         Event evt = unpack.unpack(node_id);
+        dispatchEvent(node_id, std::move(evt));
+    }
+
+    void dispatchEvent(uint32_t node_id, Event &&evt)
+    {
         // std::cout << "Received event: " << evt.event_id << std::endl;
         // std::cout << "for node " << node_id << std::endl;
 
@@ -6,6 +6,23 @@
 
 #define MAX_NB_HOST_MSGS 50
 
+// Initial size of a message slot (including the 4 bytes length)
+#define HOST_MSG_SLOT_SIZE 256
+
+// Bigger events are sent without copy with writev.
+// Maximum number of segments for such an event.
+#define HOST_MAX_SEGMENTS 32
+
+// Maximum time to wait for room in the socket buffer when sending
+// such an event. The queue mutex is held during the wait.
+#define HOST_SEND_TIMEOUT_MS 100
+
+// Small events sent to the host are coalesced in batch frames.
+// A batch is sent when older than HOST_BATCH_WINDOW_MS (0 to disable
+// coalescing) or bigger than HOST_BATCH_MAX_SIZE bytes.
+#define HOST_BATCH_WINDOW_MS 5
+#define HOST_BATCH_MAX_SIZE 1024
+
 #if defined(CG_HOST)
 extern void listen_to_host(arm_cmsis_stream::EventQueue *queue);
 extern void close_host();
@@ -57,9 +57,9 @@ def sendMsg(s, id,selector,data):
 
 def read_msg(b):
     #print(b)
-    unpack = Unpack(b)
-    nodeid,evt= unpack.unpack_event()
-    return (nodeid,evt)
+    # A message may be a batch frame containing several events
+    # Return the list of (nodeid,evt)
+    return unpack_events(b)
 
 
 class StreamNode:
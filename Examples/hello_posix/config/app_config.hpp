@@ -10,6 +10,7 @@
 
 #include "cg_enums.h"
 #include "stream_rtos_events.h"
+#include "stream_node_profiler.hpp"
 #include "stream_runtime_init.hpp"
 
 extern "C" {
@@ -19,10 +20,20 @@ extern "C" {
 // FIFO buffers are aligned for generated schedules that use memory sharing.
 #define CG_BEFORE_BUFFER alignas(16)
 
+// Switch to a standby context at the start of an iteration
+#define CG_BEFORE_ITERATION                                                         \
+    {                                                                               \
+        if (stream_iteration_switch())                                              \
+        {                                                                           \
+            cgStaticError = CG_PAUSED_SCHEDULER;                                    \
+            goto errorHandling;                                                     \
+        }                                                                           \
+    }
+
 #define CG_BEFORE_NODE_EXECUTION(id)                                                \
     {                                                                               \
-        uint32_t res = cg_streamEvent.wait(STREAM_PAUSE_EVENT | STREAM_DONE_EVENT,  \
-                                           true, 0);                                \
+        uint32_t res = cg_currentStreamEvent->wait(STREAM_PAUSE_EVENT |             \
+                                                   STREAM_DONE_EVENT, true, 0);     \
         if ((res & STREAM_DONE_EVENT) != 0U)                                        \
         {                                                                           \
             cgStaticError = CG_STOP_SCHEDULER;                                      \
@@ -33,4 +44,10 @@ extern "C" {
             cgStaticError = CG_PAUSED_SCHEDULER;                                    \
             goto errorHandling;                                                     \
         }                                                                           \
+        STREAM_PROFILE_BEFORE_NODE(id);                                             \
     }
+
+// Node execution statistics (stream_node_profiler.hpp)
+#define CG_AFTER_NODE_EXECUTION(id) STREAM_PROFILE_AFTER_NODE(id)
+
+#define CG_NODE_NOT_EXECUTED(id) STREAM_PROFILE_NODE_SKIPPED(id)
@@ -55,6 +55,20 @@ static void resume_scheduler_app(const stream_execution_context_t *context)
     }
 }
 
+static bool start_node_init_app(const stream_execution_context_t *context, int32_t nodeID)
+{
+    CStreamNode *cnode = static_cast<CStreamNode *>(context->get_node_by_id(nodeID));
+    if ((cnode == nullptr) ||
+        (cnode->obj == nullptr) ||
+        (cnode->stream_intf == nullptr) ||
+        !cnode->stream_intf->needsAsynchronousInit(cnode->obj)) {
+        return false;
+    }
+    StreamNode *node = static_cast<StreamNode *>(cnode->obj);
+    (void)node->processEvent(0, Event(kStartNodeInitialization, kHighPriority));
+    return true;
+}
+
 static void *get_hello_node(int32_t nodeID)
 {
     return static_cast<void *>(get_scheduler_hello_node(nodeID));
@@ -81,6 +95,9 @@ static void handle_error(int32_t origin, int32_t error_code, int32_t info)
 static bool application_handler(int src_node_id, void *data, Event &&evt)
 {
     int network_id = static_cast<int>(reinterpret_cast<intptr_t>(data));
+    if (stream_node_init_event(src_node_id, evt)) {
+        return true;
+    }
     if (evt.event_id == kValue) {
         int32_t msg = evt.get<int32_t>();
         CMSISSTREAM_LOG_DBG("Application handler received event from node %d in network %d with value: %d\n",
@@ -136,7 +153,15 @@ void stream_configure_and_start()
         get_hello_node,
         queue_app[0],
         STREAM_HELLO_NB_IDENTIFIED_NODES,
-        STREAM_HELLO_SCHED_LEN};
+        STREAM_HELLO_SCHED_LEN,
+        start_node_init_app,
+        nullptr};
+
+    err = stream_init_nodes(&contexts[0]);
+    if (err != CG_SUCCESS) {
+        CMSISSTREAM_LOG_ERR("Error: Failure during asynchronous node initialization for hello graph.\n");
+        goto error;
+    }
 
     resume_scheduler_app(&contexts[currentNetwork]);
     if (!stream_start_threads(&contexts[currentNetwork])) {
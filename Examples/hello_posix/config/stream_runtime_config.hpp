@@ -70,6 +70,75 @@
 
 // </h>
 
+// <h>Sharded Runtime Configuration
+
+// <o CMSISSTREAM_NB_EVENT_WORKERS>Number of event workers <1..64>
+// <i>Threads serving the event queues of all the shards started with stream_start_shard.
+// <d> 2
+#define CMSISSTREAM_NB_EVENT_WORKERS 2
+
+// <o CMSISSTREAM_EVENT_SHARD_QUANTUM>Events per shard turn <1..1024>
+// <i>Maximum number of events processed for one shard before a worker moves to the next ready shard.
+// <d> 8
+#define CMSISSTREAM_EVENT_SHARD_QUANTUM 8
+
+// </h>
+
+// <h>Node Initialization Configuration
+
+// <o CMSISSTREAM_NB_INIT_WORKERS>Number of initialization workers <1..64>
+// <i>Threads starting the asynchronous initializations of the nodes in stream_init_nodes.
+// <d> 4
+#define CMSISSTREAM_NB_INIT_WORKERS 4
+
+// </h>
+
+// <h>Profiling Configuration
+
+// <q CMSISSTREAM_NODE_PROFILER>Node execution profiler
+// <i>Node hooks of app_config.hpp update the StreamNodeProfiler of the execution context when one is set.
+// <d> 0
+#define CMSISSTREAM_NODE_PROFILER 0
+
+// </h>
+
+// <h>Event Log Configuration
+
+// <o CMSISSTREAM_EVENT_LOG_FLUSH_MS>Event log flush period (ms) <1..60000>
+// <i>Period of the background thread writing the pages of a StreamEventLog to the file.
+// <d> 100
+#define CMSISSTREAM_EVENT_LOG_FLUSH_MS 100
+
+// </h>
+
+// <h>Shared Buffer Configuration
+
+// <o CMSISSTREAM_MAPPING_CACHE_BYTES>Mapping cache budget (bytes)
+// <i>Shared buffers no more used by a descriptor stay mapped while the mapped bytes are below this budget.
+// <d> 67108864
+#define CMSISSTREAM_MAPPING_CACHE_BYTES 67108864
+
+// </h>
+
+// <h>IPC Configuration
+
+// <o CMSISSTREAM_IPC_SPIN_COUNT>IPC spin count
+// <i>Iterations a shared memory IPC receiver (or a sender waiting for room) spins before sleeping on a futex.
+// <d> 2000
+#define CMSISSTREAM_IPC_SPIN_COUNT 2000
+
+// <o CMSISSTREAM_IPC_BATCH_BYTES>Socket IPC batch size (bytes)
+// <i>A socket IPC sender waits when the events waiting to be sent are bigger than this size.
+// <d> 65536
+#define CMSISSTREAM_IPC_BATCH_BYTES 65536
+
+// <o CMSISSTREAM_IPC_MAX_FDS>Socket IPC file descriptors per frame <1..253>
+// <i>Maximum number of shared buffer file descriptors sent with one frame (SCM_RIGHTS).
+// <d> 64
+#define CMSISSTREAM_IPC_MAX_FDS 64
+
+// </h>
+
 // <<< end of configuration section >>>
 
 #define CMSISSTREAM_LOG_ERR(fmt, ...) std::fprintf(stderr, "[ERR] " fmt, ##__VA_ARGS__)
@@ -63,6 +63,10 @@ public:
     static NodeBase* mkNode(const RuntimeContext &ctx, 
                             const Node *ndesc)
     {
+        if (!has_ios(ndesc,1,0))
+        {
+            return(nullptr);
+        }
         auto inputs = ndesc->inputs();
         RuntimeEdge &i = *ctx.fifos[inputs->Get(0)->id()];
     
@@ -128,6 +132,10 @@ public:
     static NodeBase* mkNode(const RuntimeContext &ctx, 
                             const Node *ndesc)
     {
+        if (!has_ios(ndesc,0,1))
+        {
+            return(nullptr);
+        }
         auto outputs = ndesc->outputs();
         RuntimeEdge &i = *ctx.fifos[outputs->Get(0)->id()];
 
@@ -177,7 +185,14 @@ public:
     static NodeBase* mkNode(const RuntimeContext &ctx, 
                             const Node *ndesc)
     {
-        
+        // The node data must contain the increment
+        if (!has_ios(ndesc,1,1) ||
+            (ndesc->node_data() == nullptr) ||
+            (ndesc->node_data()->size() != sizeof(int32_t)))
+        {
+            return(nullptr);
+        }
+
         auto inputs = ndesc->inputs();
         RuntimeEdge &i = *ctx.fifos[inputs->Get(0)->id()];
 
@@ -185,12 +200,10 @@ public:
         RuntimeEdge &o = *ctx.fifos[outputs->Get(0)->id()];
 
         // Extract values from data
-        const int8_t *d = ndesc->node_data()->data();
-        const int32_t *v = reinterpret_cast<const int32_t*>(d);
-
+        int32_t v;
+        memcpy(&v,ndesc->node_data()->data(),sizeof(int32_t));
 
-        
-        ProcessingNode *node=new ProcessingNode(*ndesc,i,o,*v);
+        ProcessingNode *node=new ProcessingNode(*ndesc,i,o,v);
         return(static_cast<NodeBase*>(node));
     }
 
@@ -251,7 +264,11 @@ public:
     static NodeBase* mkNode(const RuntimeContext &ctx, 
                             const Node *ndesc)
     {
-        
+        if (!has_ios(ndesc,2,1))
+        {
+            return(nullptr);
+        }
+
         auto inputs = ndesc->inputs();
         RuntimeEdge &ia = *ctx.fifos[inputs->Get(0)->id()];
         RuntimeEdge &ib = *ctx.fifos[inputs->Get(1)->id()];
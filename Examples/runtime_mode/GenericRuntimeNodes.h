@@ -25,6 +25,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include "stream_generated.h"
 #include "cg_status.h"
 
@@ -36,15 +38,72 @@ namespace arm_cmsis_stream {
 
 using IOVector = flatbuffers::Vector<const IODesc*>;
 
+/**
+ * @brief      Size of the samples of an IO
+ *
+ * char IOs are untyped byte streams (used by the duplicate
+ * node). The size 0 means any sample type.
+ */
+template<typename T>
+constexpr uint32_t runtime_sample_size()
+{
+   return(std::is_same<T,char>::value ? 0 : sizeof(T));
+}
+
 /**
  * @brief      Virtual class for edges (FIFO or buffer)
+ *
+ * The nodes bind their IOs to the edges when they are created
+ * (with the size of the samples and the number of bytes read or
+ * written at each execution). The bindings are used to validate
+ * the graph before it is run.
  */
 class RuntimeEdge
 {
 public:
-   RuntimeEdge(){};
+   RuntimeEdge(const uint32_t length,const uint32_t delay):
+   mLength(length),mDelay(delay){};
    virtual ~RuntimeEdge(){};
 
+   /**
+    * @brief      Bind the writer of this edge
+    *
+    * @param[in]  sample_size  The sample size (0 for untyped IO)
+    * @param[in]  nb_bytes     The number of bytes written at each execution
+    */
+   void bindWriter(const uint32_t sample_size,const uint32_t nb_bytes)
+   {
+      mNbWriters++;
+      mWriteBytes = nb_bytes;
+      bindType(sample_size);
+   };
+
+   /**
+    * @brief      Bind the reader of this edge
+    *
+    * @param[in]  sample_size  The sample size (0 for untyped IO)
+    * @param[in]  nb_bytes     The number of bytes read at each execution
+    */
+   void bindReader(const uint32_t sample_size,const uint32_t nb_bytes)
+   {
+      mNbReaders++;
+      mReadBytes = nb_bytes;
+      bindType(sample_size);
+   };
+
+   //! Length of the edge in bytes
+   uint32_t length() const {return(mLength);};
+   //! Delay of the edge in bytes
+   uint32_t delay() const {return(mDelay);};
+   //! Size of the samples (0 if not known)
+   uint32_t sampleSize() const {return(mSampleSize);};
+   uint32_t writeBytes() const {return(mWriteBytes);};
+   uint32_t readBytes() const {return(mReadBytes);};
+   uint32_t nbWriters() const {return(mNbWriters);};
+   uint32_t nbReaders() const {return(mNbReaders);};
+   //! True if two IOs with different sample types were bound
+   bool hasTypeMismatch() const {return(mTypeMismatch);};
+
    /**
     * @brief      Gets the write buffer.
     *
@@ -94,6 +153,29 @@ public:
    * @return     Number of available bytes in the FIFO
    */
   virtual int nbOfFreeBytesInFIFO() const=0;
+
+protected:
+  void bindType(const uint32_t sample_size)
+  {
+     if (sample_size == 0)
+     {
+        return;
+     }
+     if ((mSampleSize != 0) && (mSampleSize != sample_size))
+     {
+        mTypeMismatch = true;
+     }
+     mSampleSize = sample_size;
+  };
+
+  const uint32_t mLength;
+  const uint32_t mDelay;
+  uint32_t mSampleSize = 0;
+  uint32_t mWriteBytes = 0;
+  uint32_t mReadBytes = 0;
+  uint32_t mNbWriters = 0;
+  uint32_t mNbReaders = 0;
+  bool mTypeMismatch = false;
 };
 
 
@@ -111,17 +193,10 @@ class RuntimeFIFO:public RuntimeEdge
          * @param[in]  delay  The delay in bytes
          */
         explicit RuntimeFIFO(int8_t *buf,const uint32_t nb,int delay=0):
+        RuntimeEdge(nb,delay),
         mBuffer(buf),readPos(0),writePos(delay),length(nb) {
         };
 
-        
-        
-        RuntimeFIFO(RuntimeFIFO&&) = default;
-        RuntimeFIFO& operator=(RuntimeFIFO&&) = default;
-
-        RuntimeFIFO(const RuntimeFIFO&) = default;
-        RuntimeFIFO& operator=(const RuntimeFIFO&) = default;
-
         /* 
 
         Check for overflow must have been done
@@ -200,14 +275,10 @@ class RuntimeBuffer:public RuntimeEdge
          * No delay argument. When there is a delay, it cannot be
          * a buffer and a FIFO is generated instead.
          */
-        explicit RuntimeBuffer(int8_t *buf):mBuffer(buf) {
+        explicit RuntimeBuffer(int8_t *buf,const uint32_t nb):
+        RuntimeEdge(nb,0),mBuffer(buf) {
         };
 
-        RuntimeBuffer(const RuntimeBuffer&) = default;
-        RuntimeBuffer(RuntimeBuffer&&) = default;
-        RuntimeBuffer& operator=(const RuntimeBuffer&) = default;
-        RuntimeBuffer& operator=(RuntimeBuffer&&) = default;
-
         /* 
            Not used in synchronous mode 
            and this version of the FIFO is
@@ -287,6 +358,26 @@ public:
 
 };
 
+/**
+ * @brief      Check the number of IOs of a node description
+ *
+ * Must be used by mkNode before accessing the IOs.
+ *
+ * @param[in]  ndesc       The flatbuffer description of the node
+ * @param[in]  nb_inputs   The number of inputs of the node class
+ * @param[in]  nb_outputs  The number of outputs of the node class
+ *
+ * @return     True if the description has those IOs
+ */
+inline bool has_ios(const Node *ndesc,
+                    const unsigned int nb_inputs,
+                    const unsigned int nb_outputs)
+{
+    const unsigned int in = (ndesc->inputs() == nullptr) ? 0 : ndesc->inputs()->size();
+    const unsigned int out = (ndesc->outputs() == nullptr) ? 0 : ndesc->outputs()->size();
+    return((in == nb_inputs) && (out == nb_outputs));
+}
+
 // Get number of bytes to read on input ID
 // If number of samples is not provided, it is read from the flatbuffer
 // otherwise the provided value is used
@@ -328,7 +419,10 @@ class GenericRuntimeSink:public NodeBase
 {
 public:
      explicit GenericRuntimeSink(const Node &n,
-                                 RuntimeEdge &src):ndesc(n),mSrc(src){};
+                                 RuntimeEdge &src):ndesc(n),mSrc(src)
+     {
+        mSrc.bindReader(runtime_sample_size<IN>(),nb_input_samples()*sizeof(IN));
+     };
 
      /**
       * @brief      Number of input samples read on this input as described by the flatbuffer
@@ -392,7 +486,14 @@ class GenericRuntimeToManyNode:public NodeBase
 public:
      explicit GenericRuntimeToManyNode(const Node &n,
                                        RuntimeEdge &src,
-                                       std::vector<RuntimeEdge*> dst):ndesc(n),mSrc(src),mDstList(dst){};
+                                       std::vector<RuntimeEdge*> dst):ndesc(n),mSrc(src),mDstList(dst)
+     {
+        mSrc.bindReader(runtime_sample_size<IN>(),nb_input_samples()*sizeof(IN));
+        for(unsigned int i=0;i<mDstList.size();i++)
+        {
+           mDstList[i]->bindWriter(runtime_sample_size<OUT>(),nb_output_samples(i)*sizeof(OUT));
+        }
+     };
 
      std::size_t nb_input_samples() const {return(ndesc.inputs()->Get(0)->nb());};
      std::size_t nb_output_samples(const int i) const {return(ndesc.outputs()->Get(i)->nb());};
@@ -444,7 +545,11 @@ class GenericRuntimeNode:public NodeBase
 public:
      explicit GenericRuntimeNode(const Node &n,
                                  RuntimeEdge &src,
-                                 RuntimeEdge &dst):ndesc(n),mSrc(src),mDst(dst){};
+                                 RuntimeEdge &dst):ndesc(n),mSrc(src),mDst(dst)
+     {
+        mSrc.bindReader(runtime_sample_size<IN>(),nb_input_samples()*sizeof(IN));
+        mDst.bindWriter(runtime_sample_size<OUT>(),nb_output_samples()*sizeof(OUT));
+     };
 
      std::size_t nb_input_samples() const {return(ndesc.inputs()->Get(0)->nb());};
      std::size_t nb_output_samples() const {return(ndesc.outputs()->Get(0)->nb());};
@@ -496,7 +601,12 @@ public:
                                  RuntimeEdge &src1,
                                  RuntimeEdge &src2,
                                  RuntimeEdge &dst):
-     ndesc(n),mSrc1(src1),mSrc2(src2),mDst(dst){};
+     ndesc(n),mSrc1(src1),mSrc2(src2),mDst(dst)
+     {
+        mSrc1.bindReader(runtime_sample_size<IN1>(),nb_input_samples1()*sizeof(IN1));
+        mSrc2.bindReader(runtime_sample_size<IN2>(),nb_input_samples2()*sizeof(IN2));
+        mDst.bindWriter(runtime_sample_size<OUT>(),nb_output_samples()*sizeof(OUT));
+     };
 
      std::size_t nb_input_samples1() const {return(ndesc.inputs()->Get(0)->nb());};
      std::size_t nb_input_samples2() const {return(ndesc.inputs()->Get(1)->nb());};
@@ -558,7 +668,10 @@ class GenericRuntimeSource:public NodeBase
 {
 public:
      explicit GenericRuntimeSource(const Node &n,
-                                   RuntimeEdge &dst):ndesc(n),mDst(dst){};
+                                   RuntimeEdge &dst):ndesc(n),mDst(dst)
+     {
+        mDst.bindWriter(runtime_sample_size<OUT>(),nb_output_samples()*sizeof(OUT));
+     };
 
      std::size_t nb_output_samples() const {return(ndesc.outputs()->Get(0)->nb());};
 
@@ -605,6 +718,11 @@ public:
     static NodeBase* mkNode(const RuntimeContext &ctx, 
                             const Node *ndesc)
     {
+        if ((ndesc->inputs() == nullptr) || (ndesc->inputs()->size() != 1) ||
+            (ndesc->outputs() == nullptr) || (ndesc->outputs()->size() == 0))
+        {
+            return(nullptr);
+        }
         auto inputs = ndesc->inputs();
         auto outputs = ndesc->outputs();
 
@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        BenchNodes.hpp
+ * Description:  Nodes of the static scheduler used by the benchmark
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- 
+*
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _BENCHNODES_H_
+#define _BENCHNODES_H_
+
+#include "bench_kernels.h"
+
+using namespace arm_cmsis_stream;
+
+template<typename IN, int inputSize>
+class Sink: public GenericSink<IN, inputSize>
+{
+public:
+    Sink(FIFOBase<IN> &src):GenericSink<IN,inputSize>(src){};
+
+    int run() final
+    {
+        bench_sink(this->getReadBuffer(),inputSize);
+        return(CG_SUCCESS);
+    };
+};
+
+template<typename OUT,int outputSize>
+class Source: public GenericSource<OUT,outputSize>
+{
+public:
+    Source(FIFOBase<OUT> &dst):GenericSource<OUT,outputSize>(dst){};
+
+    int run() final
+    {
+        bench_source(this->getWriteBuffer(),outputSize);
+        return(CG_SUCCESS);
+    };
+};
+
+template<typename IN, int inputSize,
+         typename OUT,int outputSize>
+class ProcessingNode;
+
+/* The increment is a node argument in the runtime mode (node data)
+   and a constant in this version */
+template<typename IN, int inputOutputSize>
+class ProcessingNode<IN,inputOutputSize,
+                     IN,inputOutputSize>: 
+      public GenericNode<IN,inputOutputSize,
+                         IN,inputOutputSize>
+{
+public:
+    ProcessingNode(FIFOBase<IN> &src,
+                   FIFOBase<IN> &dst):GenericNode<IN,inputOutputSize,
+                                                  IN,inputOutputSize>(src,dst){};
+
+    int run() final
+    {
+        bench_processing(this->getReadBuffer(),this->getWriteBuffer(),
+                         inputOutputSize,BENCH_PROCESSING_INC);
+        return(CG_SUCCESS);
+    };
+};
+
+template<typename IN1, int inputSize1,
+         typename IN2, int inputSize2,
+         typename OUT,int outputSize>
+class Adder;
+
+template<typename IN, int ioSize>
+class Adder<IN,ioSize,
+            IN,ioSize,
+            IN,ioSize>: 
+      public GenericNode21<IN,ioSize,
+                           IN,ioSize,
+                           IN,ioSize>
+{
+public:
+    Adder(FIFOBase<IN> &src1,
+          FIFOBase<IN> &src2,
+          FIFOBase<IN> &dst):GenericNode21<IN,ioSize,
+                                           IN,ioSize,
+                                           IN,ioSize>(src1,src2,dst){};
+
+    int run() final
+    {
+        bench_add(this->getReadBuffer1(),this->getReadBuffer2(),
+                  this->getWriteBuffer(),ioSize);
+        return(CG_SUCCESS);
+    };
+};
+
+#endif
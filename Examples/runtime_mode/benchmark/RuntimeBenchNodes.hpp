@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        RuntimeBenchNodes.hpp
+ * Description:  Nodes of the runtime graph used by the benchmark
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- 
+*
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _RUNTIMEBENCHNODES_H_
+#define _RUNTIMEBENCHNODES_H_
+
+#include <cstring>
+#include "GenericRuntimeNodes.h"
+#include "stream_generated.h"
+#include "bench_kernels.h"
+
+using namespace arm_cmsis_stream;
+
+/* Same UUIDs as the nodes of AppNodes.hpp so that sched_flat.dat
+   can be used */
+
+class Sink: public GenericRuntimeSink<float>
+{
+public:
+    Sink(const Node &n,
+         RuntimeEdge &src):GenericRuntimeSink<float>(n,src){};
+
+    constexpr static std::array<uint8_t,16> uuid    = {0xc3,0x0e,0xa9,0xea,0xe9,0xc3,0x46,0x38,0xbb,0xc6,0x02,0x1f,0xa3,0x54,0x9d,0x93};
+
+    static NodeBase* mkNode(const RuntimeContext &ctx, 
+                            const Node *ndesc)
+    {
+        if (!has_ios(ndesc,1,0))
+        {
+            return(nullptr);
+        }
+        RuntimeEdge &i = *ctx.fifos[ndesc->inputs()->Get(0)->id()];
+        return(new Sink(*ndesc,i));
+    }
+
+    int prepareForRunning() final
+    {
+        return(this->willUnderflow() ? CG_SKIP_EXECUTION_ID_CODE : CG_SUCCESS_ID_CODE);
+    };
+
+    int run() final
+    {
+        bench_sink(this->getReadBuffer(),this->nb_input_samples());
+        return(CG_SUCCESS_ID_CODE);
+    };
+};
+
+class Source: public GenericRuntimeSource<float>
+{
+public:
+    Source(const Node &n,
+           RuntimeEdge &dst):GenericRuntimeSource<float>(n,dst){};
+
+    constexpr static std::array<uint8_t,16> uuid    = {0xc0,0x08,0x9f,0x59,0x2f,0x33,0x4e,0xc4,0x90,0x23,0x30,0xf6,0x9f,0x0f,0x48,0x33};
+
+    static NodeBase* mkNode(const RuntimeContext &ctx, 
+                            const Node *ndesc)
+    {
+        if (!has_ios(ndesc,0,1))
+        {
+            return(nullptr);
+        }
+        RuntimeEdge &o = *ctx.fifos[ndesc->outputs()->Get(0)->id()];
+        return(new Source(*ndesc,o));
+    }
+
+    int prepareForRunning() final
+    {
+        return(this->willOverflow() ? CG_SKIP_EXECUTION_ID_CODE : CG_SUCCESS_ID_CODE);
+    };
+
+    int run() final
+    {
+        bench_source(this->getWriteBuffer(),this->nb_output_samples());
+        return(CG_SUCCESS_ID_CODE);
+    };
+};
+
+class ProcessingNode: public GenericRuntimeNode<float,float>
+{
+public:
+    ProcessingNode(const Node &n,
+                   RuntimeEdge &src,
+                   RuntimeEdge &dst,
+                   const int32_t inc):GenericRuntimeNode<float,float>(n,src,dst),mInc(inc){};
+
+    constexpr static std::array<uint8_t,16> uuid   = {0x3f,0xf6,0x2b,0x0c,0x9a,0xd8,0x44,0x5d,0xbb,0xe9,0x20,0x8d,0x87,0x42,0x34,0x46};
+
+    static NodeBase* mkNode(const RuntimeContext &ctx, 
+                            const Node *ndesc)
+    {
+        if (!has_ios(ndesc,1,1) ||
+            (ndesc->node_data() == nullptr) ||
+            (ndesc->node_data()->size() != sizeof(int32_t)))
+        {
+            return(nullptr);
+        }
+        RuntimeEdge &i = *ctx.fifos[ndesc->inputs()->Get(0)->id()];
+        RuntimeEdge &o = *ctx.fifos[ndesc->outputs()->Get(0)->id()];
+        int32_t v;
+        memcpy(&v,ndesc->node_data()->data(),sizeof(int32_t));
+        return(new ProcessingNode(*ndesc,i,o,v));
+    }
+
+    int prepareForRunning() final
+    {
+        return((this->willOverflow() || this->willUnderflow()) ? CG_SKIP_EXECUTION_ID_CODE : CG_SUCCESS_ID_CODE);
+    };
+
+    int run() final
+    {
+        bench_processing(this->getReadBuffer(),this->getWriteBuffer(),
+                         this->nb_input_samples(),mInc);
+        return(CG_SUCCESS_ID_CODE);
+    };
+
+protected:
+    const int32_t mInc;
+};
+
+class AdderNode: public GenericRuntimeNode21<float,float,float>
+{
+public:
+    AdderNode(const Node &n,
+              RuntimeEdge &src1,
+              RuntimeEdge &src2,
+              RuntimeEdge &dst):GenericRuntimeNode21<float,float,float>(n,src1,src2,dst){};
+
+    constexpr static std::array<uint8_t,16> uuid  = {0x6a,0x73,0x38,0x1c,0xcd,0x11,0x4f,0x13,0xba,0x96,0x34,0x75,0x7c,0x2c,0x4a,0x59};
+
+    static NodeBase* mkNode(const RuntimeContext &ctx, 
+                            const Node *ndesc)
+    {
+        if (!has_ios(ndesc,2,1))
+        {
+            return(nullptr);
+        }
+        RuntimeEdge &ia = *ctx.fifos[ndesc->inputs()->Get(0)->id()];
+        RuntimeEdge &ib = *ctx.fifos[ndesc->inputs()->Get(1)->id()];
+        RuntimeEdge &o = *ctx.fifos[ndesc->outputs()->Get(0)->id()];
+        return(new AdderNode(*ndesc,ia,ib,o));
+    }
+
+    int prepareForRunning() final
+    {
+        return((this->willOverflow() || this->willUnderflow1() || this->willUnderflow2()) ? 
+               CG_SKIP_EXECUTION_ID_CODE : CG_SUCCESS_ID_CODE);
+    };
+
+    int run() final
+    {
+        bench_add(this->getReadBuffer1(),this->getReadBuffer2(),
+                  this->getWriteBuffer(),this->nb_input_samples1());
+        return(CG_SUCCESS_ID_CODE);
+    };
+};
+
+#endif
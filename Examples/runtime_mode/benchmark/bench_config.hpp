@@ -0,0 +1,16 @@
+#pragma once
+
+/*
+ * Application configuration of the static scheduler
+ * used by the benchmark.
+ */
+
+#include "bench_kernels.h"
+
+// The number of iterations is chosen by the benchmark
+#define CG_BEFORE_ITERATION                           \
+    if (nbSchedule == bench_nb_iterations)            \
+    {                                                 \
+        cgStaticError = CG_STOP_SCHEDULER;            \
+        goto errorHandling;                           \
+    }
@@ -0,0 +1,59 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        bench_kernels.h
+ * Description:  Processing shared by the static and runtime nodes
+ *               of the benchmark
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- 
+*
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _BENCH_KERNELS_H_
+#define _BENCH_KERNELS_H_
+
+#include <cstdint>
+
+//! Number of iterations of the static scheduler
+extern uint32_t bench_nb_iterations;
+//! Sum of all the samples received by the sinks
+extern double bench_checksum;
+
+//! Increment used by the processing node
+#define BENCH_PROCESSING_INC 10
+
+inline void bench_source(float *b,const int nb)
+{
+    for(int i=0;i<nb;i++)
+    {
+        b[i] = (float)i;
+    }
+}
+
+inline void bench_add(const float *a,const float *b,float *c,const int nb)
+{
+    for(int i=0;i<nb;i++)
+    {
+        c[i] = a[i]+b[i];
+    }
+}
+
+inline void bench_processing(const float *a,float *b,const int nb,const int32_t inc)
+{
+    for(int i=0;i<nb;i++)
+    {
+        b[i] = a[i]+inc;
+    }
+}
+
+inline void bench_sink(const float *b,const int nb)
+{
+    for(int i=0;i<nb;i++)
+    {
+        bench_checksum += b[i];
+    }
+}
+
+#endif
@@ -0,0 +1,26 @@
+# Generate the static scheduler used to compare the runtime
+# mode with the build time mode for the same graph
+import sys
+sys.path.insert(0, "..")
+
+# Include definition of the nodes
+from nodes import * 
+# Include definition of the graph
+from graph import * 
+
+conf=Configuration()
+conf.CMSISDSP = False
+conf.CAPI = True
+conf.asynchronous = False
+conf.memoryOptimization = True
+# Unrolled schedule
+conf.switchCase = False
+conf.appConfigCName = "bench_config.hpp"
+conf.appNodesCName = "BenchNodes.hpp"
+
+scheduling = the_graph.computeSchedule(config=conf)
+
+print("Schedule length = %d" % scheduling.scheduleLength)
+print("Memory usage %d bytes" % scheduling.memory)
+
+scheduling.ccode(".",conf)
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include "runtime_sched.h"
+#include "RuntimeBenchNodes.hpp"
+#include "scheduler.h"
+
+using namespace arm_cmsis_stream;
+
+uint32_t bench_nb_iterations = 0;
+double bench_checksum = 0.0;
+
+#define NB_ITERATIONS 200000
+
+static Registry register_nodes()
+{
+    Registry res;
+
+    Component<Source>::reg(res);
+    Component<Sink>::reg(res);
+    Component<ProcessingNode>::reg(res);
+    Component<AdderNode>::reg(res);
+    Component<RuntimeDuplicate>::reg(res);
+   
+    return(res);
+};
+
+static double elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    auto d = std::chrono::steady_clock::now() - start;
+    return(std::chrono::duration<double,std::nano>(d).count());
+}
+
+int main(int argc, char const *argv[])
+{
+    int error;
+    uint32_t nbIterations = NB_ITERATIONS;
+    const char *path = "../sched_flat.dat";
+    if (argc > 1)
+    {
+        path = argv[1];
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    std::vector<unsigned char> buffer(std::istreambuf_iterator<char>(input), {});
+    auto maybe_ctx = create_graph(buffer.data(),buffer.size(),register_nodes(),&error);
+    if (!maybe_ctx.has_value())
+    {
+        printf("Invalid graph %s (error %d)\n",path,error);
+        return(1);
+    }
+    const RuntimeContext &ctx = maybe_ctx.value();
+    SchedulerHooks hooks = {};
+
+    // Static scheduler
+    bench_checksum = 0.0;
+    bench_nb_iterations = nbIterations;
+    auto start = std::chrono::steady_clock::now();
+    uint32_t nbStatic = scheduler(&error,nullptr);
+    double staticNs = elapsed_ns(start);
+    double staticChecksum = bench_checksum;
+
+    // Runtime scheduler
+    bench_checksum = 0.0;
+    start = std::chrono::steady_clock::now();
+    uint32_t nbRuntime = run_graph(hooks,ctx,&error,nbIterations);
+    double runtimeNs = elapsed_ns(start);
+    double runtimeChecksum = bench_checksum;
+
+    printf("Iterations      : %u (static) %u (runtime)\n",nbStatic,nbRuntime);
+    printf("Static          : %.1f ns / iteration\n",staticNs / nbStatic);
+    printf("Runtime         : %.1f ns / iteration\n",runtimeNs / nbRuntime);
+    printf("Runtime/static  : %.2f\n",runtimeNs / staticNs);
+    printf("Same output     : %s\n",(staticChecksum == runtimeChecksum) ? "yes" : "no");
+    printf("Buffers memory  : %u bytes\n",ctx.memory_size);
+
+    return((staticChecksum == runtimeChecksum) ? 0 : 1);
+}
@@ -0,0 +1,701 @@
+/*
+
+Generated with CMSIS-Stream python scripts.
+The generated code is not covered by CMSIS-Stream license.
+
+The support classes and code are covered by CMSIS-Stream license.
+
+*/
+
+
+#include <cstdint>
+#include "bench_config.hpp"
+#include "stream_platform_config.hpp"
+#include "cg_enums.h"
+#include "StreamNode.hpp"
+#include "EventQueue.hpp"
+#include "GenericNodes.hpp"
+#include "BenchNodes.hpp"
+#include "scheduler.h"
+
+#if !defined(CHECKERROR)
+#define CHECKERROR       if (cgStaticError < 0) \
+       {\
+         goto errorHandling;\
+       }
+
+#endif
+
+
+#if !defined(CG_BEFORE_ITERATION)
+#define CG_BEFORE_ITERATION
+#endif 
+
+#if !defined(CG_AFTER_ITERATION)
+#define CG_AFTER_ITERATION
+#endif 
+
+#if !defined(CG_BEFORE_SCHEDULE)
+#define CG_BEFORE_SCHEDULE
+#endif
+
+#if !defined(CG_AFTER_SCHEDULE)
+#define CG_AFTER_SCHEDULE
+#endif
+
+#if !defined(CG_BEFORE_BUFFER)
+#define CG_BEFORE_BUFFER
+#endif
+
+#if !defined(CG_BEFORE_FIFO_BUFFERS)
+#define CG_BEFORE_FIFO_BUFFERS
+#endif
+
+#if !defined(CG_BEFORE_FIFO_INIT)
+#define CG_BEFORE_FIFO_INIT
+#endif
+
+#if !defined(CG_BEFORE_NODE_INIT)
+#define CG_BEFORE_NODE_INIT
+#endif
+
+#if !defined(CG_AFTER_INCLUDES)
+#define CG_AFTER_INCLUDES
+#endif
+
+#if !defined(CG_BEFORE_SCHEDULER_FUNCTION)
+#define CG_BEFORE_SCHEDULER_FUNCTION
+#endif
+
+#if !defined(CG_BEFORE_NODE_EXECUTION)
+#define CG_BEFORE_NODE_EXECUTION(ID)
+#endif
+
+#if !defined(CG_AFTER_NODE_EXECUTION)
+#define CG_AFTER_NODE_EXECUTION(ID)
+#endif
+
+
+
+
+
+CG_AFTER_INCLUDES
+
+
+using namespace arm_cmsis_stream;
+
+
+/*
+
+Internal ID identification for the nodes
+
+*/
+#define ADDER1_INTERNAL_ID 0
+#define ADDER10_INTERNAL_ID 1
+#define ADDER11_INTERNAL_ID 2
+#define ADDER12_INTERNAL_ID 3
+#define ADDER13_INTERNAL_ID 4
+#define ADDER14_INTERNAL_ID 5
+#define ADDER15_INTERNAL_ID 6
+#define ADDER2_INTERNAL_ID 7
+#define ADDER3_INTERNAL_ID 8
+#define ADDER4_INTERNAL_ID 9
+#define ADDER5_INTERNAL_ID 10
+#define ADDER6_INTERNAL_ID 11
+#define ADDER7_INTERNAL_ID 12
+#define ADDER8_INTERNAL_ID 13
+#define ADDER9_INTERNAL_ID 14
+#define DUP0_INTERNAL_ID 15
+#define PROCESSING_INTERNAL_ID 16
+#define SINKA_INTERNAL_ID 17
+#define SINKB_INTERNAL_ID 18
+#define SOURCE0_INTERNAL_ID 19
+#define SOURCE1_INTERNAL_ID 20
+#define SOURCE10_INTERNAL_ID 21
+#define SOURCE11_INTERNAL_ID 22
+#define SOURCE12_INTERNAL_ID 23
+#define SOURCE13_INTERNAL_ID 24
+#define SOURCE14_INTERNAL_ID 25
+#define SOURCE15_INTERNAL_ID 26
+#define SOURCE2_INTERNAL_ID 27
+#define SOURCE3_INTERNAL_ID 28
+#define SOURCE4_INTERNAL_ID 29
+#define SOURCE5_INTERNAL_ID 30
+#define SOURCE6_INTERNAL_ID 31
+#define SOURCE7_INTERNAL_ID 32
+#define SOURCE8_INTERNAL_ID 33
+#define SOURCE9_INTERNAL_ID 34
+
+
+
+
+CG_BEFORE_FIFO_BUFFERS
+/***********
+
+FIFO buffers
+
+************/
+#define FIFOSIZE0 8
+#define FIFOSIZE1 8
+#define FIFOSIZE2 8
+#define FIFOSIZE3 8
+#define FIFOSIZE4 8
+#define FIFOSIZE5 8
+#define FIFOSIZE6 8
+#define FIFOSIZE7 8
+#define FIFOSIZE8 8
+#define FIFOSIZE9 8
+#define FIFOSIZE10 8
+#define FIFOSIZE11 8
+#define FIFOSIZE12 8
+#define FIFOSIZE13 8
+#define FIFOSIZE14 8
+#define FIFOSIZE15 8
+#define FIFOSIZE16 8
+#define FIFOSIZE17 8
+#define FIFOSIZE18 8
+#define FIFOSIZE19 8
+#define FIFOSIZE20 8
+#define FIFOSIZE21 8
+#define FIFOSIZE22 8
+#define FIFOSIZE23 8
+#define FIFOSIZE24 8
+#define FIFOSIZE25 8
+#define FIFOSIZE26 8
+#define FIFOSIZE27 8
+#define FIFOSIZE28 8
+#define FIFOSIZE29 8
+#define FIFOSIZE30 8
+#define FIFOSIZE31 4
+#define FIFOSIZE32 8
+#define FIFOSIZE33 8
+
+#define BUFFERSIZE0 224
+CG_BEFORE_BUFFER
+uint8_t buf0[BUFFERSIZE0]={0};
+
+#define BUFFERSIZE1 8
+CG_BEFORE_BUFFER
+float buf1[BUFFERSIZE1]={0};
+
+#define BUFFERSIZE2 8
+CG_BEFORE_BUFFER
+float buf2[BUFFERSIZE2]={0};
+
+#define BUFFERSIZE3 8
+CG_BEFORE_BUFFER
+float buf3[BUFFERSIZE3]={0};
+
+
+
+CG_BEFORE_SCHEDULER_FUNCTION
+uint32_t scheduler(int *error,void *evtQueue_)
+{
+    EventQueue *evtQueue = reinterpret_cast<EventQueue *>(evtQueue_);
+    int cgStaticError=0;
+    uint32_t nbSchedule=0;
+
+    (void)evtQueue;
+
+
+    CG_BEFORE_FIFO_INIT;
+    /*
+    Create FIFOs objects
+    */
+    FIFO<float,FIFOSIZE0,1,0> fifo0(buf0);
+    FIFO<float,FIFOSIZE1,1,0> fifo1(buf0+32);
+    FIFO<float,FIFOSIZE2,1,0> fifo2(buf0+32);
+    FIFO<float,FIFOSIZE3,1,0> fifo3(buf0+128);
+    FIFO<float,FIFOSIZE4,1,0> fifo4(buf0+64);
+    FIFO<float,FIFOSIZE5,1,0> fifo5(buf0+160);
+    FIFO<float,FIFOSIZE6,1,0> fifo6(buf0+64);
+    FIFO<float,FIFOSIZE7,1,0> fifo7(buf0+128);
+    FIFO<float,FIFOSIZE8,1,0> fifo8(buf0+64);
+    FIFO<float,FIFOSIZE9,1,0> fifo9(buf0+128);
+    FIFO<float,FIFOSIZE10,1,0> fifo10(buf0+160);
+    FIFO<float,FIFOSIZE11,1,0> fifo11(buf0+192);
+    FIFO<float,FIFOSIZE12,1,0> fifo12(buf0+32);
+    FIFO<float,FIFOSIZE13,1,0> fifo13(buf0+64);
+    FIFO<float,FIFOSIZE14,1,0> fifo14(buf0+32);
+    FIFO<float,FIFOSIZE15,1,0> fifo15(buf0+64);
+    FIFO<float,FIFOSIZE16,1,0> fifo16(buf0);
+    FIFO<float,FIFOSIZE17,1,0> fifo17(buf0+32);
+    FIFO<float,FIFOSIZE18,1,0> fifo18(buf0+160);
+    FIFO<float,FIFOSIZE19,1,0> fifo19(buf0+96);
+    FIFO<float,FIFOSIZE20,1,0> fifo20(buf0);
+    FIFO<float,FIFOSIZE21,1,0> fifo21(buf0+32);
+    FIFO<float,FIFOSIZE22,1,0> fifo22(buf0);
+    FIFO<float,FIFOSIZE23,1,0> fifo23(buf0+32);
+    FIFO<float,FIFOSIZE24,1,0> fifo24(buf0+128);
+    FIFO<float,FIFOSIZE25,1,0> fifo25(buf0+160);
+    FIFO<float,FIFOSIZE26,1,0> fifo26(buf0+32);
+    FIFO<float,FIFOSIZE27,1,0> fifo27(buf0);
+    FIFO<float,FIFOSIZE28,1,0> fifo28(buf0+128);
+    FIFO<float,FIFOSIZE29,1,0> fifo29(buf0+64);
+    FIFO<float,FIFOSIZE30,0,0> fifo30(buf1);
+    FIFO<float,FIFOSIZE31,1,0> fifo31(buf0);
+    FIFO<float,FIFOSIZE32,0,0> fifo32(buf2);
+    FIFO<float,FIFOSIZE33,0,0> fifo33(buf3);
+
+    CG_BEFORE_NODE_INIT;
+    /* 
+    Create node objects
+    */
+
+
+    Adder<float,8,float,8,float,8> adder1(fifo0,fifo1,fifo4); /* Node ID = 0 */
+    Adder<float,8,float,8,float,8> adder10(fifo18,fifo19,fifo26); /* Node ID = 1 */
+    Adder<float,8,float,8,float,8> adder11(fifo20,fifo21,fifo24); /* Node ID = 2 */
+    Adder<float,8,float,8,float,8> adder12(fifo22,fifo23,fifo25); /* Node ID = 3 */
+    Adder<float,8,float,8,float,8> adder13(fifo24,fifo25,fifo27); /* Node ID = 4 */
+    Adder<float,8,float,8,float,8> adder14(fifo26,fifo27,fifo29); /* Node ID = 5 */
+    Adder<float,8,float,8,float,8> adder15(fifo28,fifo29,fifo30); /* Node ID = 6 */
+    Adder<float,8,float,8,float,8> adder2(fifo2,fifo3,fifo5); /* Node ID = 7 */
+    Adder<float,8,float,8,float,8> adder3(fifo4,fifo5,fifo12); /* Node ID = 8 */
+    Adder<float,8,float,8,float,8> adder4(fifo6,fifo7,fifo10); /* Node ID = 9 */
+    Adder<float,8,float,8,float,8> adder5(fifo8,fifo9,fifo11); /* Node ID = 10 */
+    Adder<float,8,float,8,float,8> adder6(fifo10,fifo11,fifo13); /* Node ID = 11 */
+    Adder<float,8,float,8,float,8> adder7(fifo12,fifo13,fifo28); /* Node ID = 12 */
+    Adder<float,8,float,8,float,8> adder8(fifo14,fifo15,fifo18); /* Node ID = 13 */
+    Adder<float,8,float,8,float,8> adder9(fifo16,fifo17,fifo19); /* Node ID = 14 */
+    Duplicate<float,4,float,4> dup0(fifo31,{&fifo32,&fifo33}); /* Node ID = 15 */
+    ProcessingNode<float,4,float,4> processing(fifo30,fifo31); /* Node ID = 16 */
+    Sink<float,8> sinka(fifo32); /* Node ID = 17 */
+    Sink<float,8> sinkb(fifo33); /* Node ID = 18 */
+    Source<float,8> source0(fifo0); /* Node ID = 19 */
+    Source<float,8> source1(fifo1); /* Node ID = 20 */
+    Source<float,8> source10(fifo16); /* Node ID = 21 */
+    Source<float,8> source11(fifo17); /* Node ID = 22 */
+    Source<float,8> source12(fifo20); /* Node ID = 23 */
+    Source<float,8> source13(fifo21); /* Node ID = 24 */
+    Source<float,8> source14(fifo22); /* Node ID = 25 */
+    Source<float,8> source15(fifo23); /* Node ID = 26 */
+    Source<float,8> source2(fifo2); /* Node ID = 27 */
+    Source<float,8> source3(fifo3); /* Node ID = 28 */
+    Source<float,8> source4(fifo6); /* Node ID = 29 */
+    Source<float,8> source5(fifo7); /* Node ID = 30 */
+    Source<float,8> source6(fifo8); /* Node ID = 31 */
+    Source<float,8> source7(fifo9); /* Node ID = 32 */
+    Source<float,8> source8(fifo14); /* Node ID = 33 */
+    Source<float,8> source9(fifo15); /* Node ID = 34 */
+
+
+/* Subscribe nodes for the event system*/
+
+    cgStaticError = CG_SUCCESS;
+    cgStaticError = adder1.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder10.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder11.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder12.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder13.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder14.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder15.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder2.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder3.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder4.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder5.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder6.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder7.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder8.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = adder9.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = dup0.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = processing.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = sinka.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = sinkb.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source0.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source1.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source10.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source11.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source12.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source13.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source14.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source15.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source2.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source3.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source4.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source5.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source6.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source7.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source8.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+    cgStaticError = source9.init();
+    if (cgStaticError != CG_SUCCESS)
+    {
+        *error=cgStaticError;
+        return(0);
+    }
+
+
+
+
+    /* Run several schedule iterations */
+    CG_BEFORE_SCHEDULE;
+    while(cgStaticError==0)
+    {
+       /* Run a schedule iteration */
+       CG_BEFORE_ITERATION;
+       CG_BEFORE_NODE_EXECUTION(19);
+       cgStaticError = source0.run();
+       CG_AFTER_NODE_EXECUTION(19);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(20);
+       cgStaticError = source1.run();
+       CG_AFTER_NODE_EXECUTION(20);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(0);
+       cgStaticError = adder1.run();
+       CG_AFTER_NODE_EXECUTION(0);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(21);
+       cgStaticError = source10.run();
+       CG_AFTER_NODE_EXECUTION(21);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(22);
+       cgStaticError = source11.run();
+       CG_AFTER_NODE_EXECUTION(22);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(14);
+       cgStaticError = adder9.run();
+       CG_AFTER_NODE_EXECUTION(14);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(23);
+       cgStaticError = source12.run();
+       CG_AFTER_NODE_EXECUTION(23);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(24);
+       cgStaticError = source13.run();
+       CG_AFTER_NODE_EXECUTION(24);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(2);
+       cgStaticError = adder11.run();
+       CG_AFTER_NODE_EXECUTION(2);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(25);
+       cgStaticError = source14.run();
+       CG_AFTER_NODE_EXECUTION(25);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(26);
+       cgStaticError = source15.run();
+       CG_AFTER_NODE_EXECUTION(26);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(3);
+       cgStaticError = adder12.run();
+       CG_AFTER_NODE_EXECUTION(3);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(4);
+       cgStaticError = adder13.run();
+       CG_AFTER_NODE_EXECUTION(4);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(27);
+       cgStaticError = source2.run();
+       CG_AFTER_NODE_EXECUTION(27);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(28);
+       cgStaticError = source3.run();
+       CG_AFTER_NODE_EXECUTION(28);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(7);
+       cgStaticError = adder2.run();
+       CG_AFTER_NODE_EXECUTION(7);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(8);
+       cgStaticError = adder3.run();
+       CG_AFTER_NODE_EXECUTION(8);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(29);
+       cgStaticError = source4.run();
+       CG_AFTER_NODE_EXECUTION(29);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(30);
+       cgStaticError = source5.run();
+       CG_AFTER_NODE_EXECUTION(30);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(9);
+       cgStaticError = adder4.run();
+       CG_AFTER_NODE_EXECUTION(9);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(31);
+       cgStaticError = source6.run();
+       CG_AFTER_NODE_EXECUTION(31);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(32);
+       cgStaticError = source7.run();
+       CG_AFTER_NODE_EXECUTION(32);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(10);
+       cgStaticError = adder5.run();
+       CG_AFTER_NODE_EXECUTION(10);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(11);
+       cgStaticError = adder6.run();
+       CG_AFTER_NODE_EXECUTION(11);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(12);
+       cgStaticError = adder7.run();
+       CG_AFTER_NODE_EXECUTION(12);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(33);
+       cgStaticError = source8.run();
+       CG_AFTER_NODE_EXECUTION(33);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(34);
+       cgStaticError = source9.run();
+       CG_AFTER_NODE_EXECUTION(34);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(13);
+       cgStaticError = adder8.run();
+       CG_AFTER_NODE_EXECUTION(13);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(1);
+       cgStaticError = adder10.run();
+       CG_AFTER_NODE_EXECUTION(1);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(5);
+       cgStaticError = adder14.run();
+       CG_AFTER_NODE_EXECUTION(5);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(6);
+       cgStaticError = adder15.run();
+       CG_AFTER_NODE_EXECUTION(6);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(16);
+       cgStaticError = processing.run();
+       CG_AFTER_NODE_EXECUTION(16);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(15);
+       cgStaticError = dup0.run();
+       CG_AFTER_NODE_EXECUTION(15);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(16);
+       cgStaticError = processing.run();
+       CG_AFTER_NODE_EXECUTION(16);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(15);
+       cgStaticError = dup0.run();
+       CG_AFTER_NODE_EXECUTION(15);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(17);
+       cgStaticError = sinka.run();
+       CG_AFTER_NODE_EXECUTION(17);
+       CHECKERROR;
+
+       CG_BEFORE_NODE_EXECUTION(18);
+       cgStaticError = sinkb.run();
+       CG_AFTER_NODE_EXECUTION(18);
+       CHECKERROR;
+
+
+       CG_AFTER_ITERATION;
+       nbSchedule++;
+    }
+    
+errorHandling:
+    CG_AFTER_SCHEDULE;
+    *error=cgStaticError;
+    return(nbSchedule);
+    
+}
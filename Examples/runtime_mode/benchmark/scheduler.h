@@ -0,0 +1,30 @@
+/*
+
+Generated with CMSIS-Stream python scripts.
+The generated code is not covered by CMSIS-Stream license.
+
+The support classes and code are covered by CMSIS-Stream license.
+
+*/
+
+#ifndef SCHEDULER_H_ 
+#define SCHEDULER_H_
+
+
+#include <stdint.h>
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+
+
+
+extern uint32_t scheduler(int *error,void *evtQueue_);
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
+
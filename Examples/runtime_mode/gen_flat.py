@@ -34,6 +34,7 @@ import cmsis_stream_writer.BufferDesc as BufferDesc
 
 import cmsis_stream_writer.Schedule as S
 import uuid
+import numpy as np
 from cmsis_stream.cg.scheduler import Duplicate
 
 # We need a different uuid for different datatype
@@ -52,8 +53,8 @@ def mkUUID(builder,u):
 def gen(sched,conf):
     nbFifos = len(sched._graph._allFIFOs)
     fifos=sched._graph._allFIFOs
-    nbNodes=len(sched.nodes)
-    nodes=sched.nodes
+    nbNodes=len(sched.streamNodes)
+    nodes=sched.streamNodes
     schedule=sched.schedule
     schedLen=len(sched.schedule)
 
@@ -126,8 +127,8 @@ def gen(sched,conf):
 
          if n.node_data is not None:
             Node.StartNodeDataVector(builder,len(n.node_data))
-            for i in reversed(n.node_data):
-                builder.PrependByte(i)
+            for b in reversed(n.node_data):
+                builder.PrependByte(b)
             node_data = builder.EndVector()
 
          node_name = None
@@ -199,8 +200,8 @@ def gen(sched,conf):
 
     S.ScheduleStartScheduleVector(builder,len(sched.schedule))
     for s in reversed(sched.schedule):
-        #print(sched.nodes[s].codeID)
-        builder.PrependUint16(sched.nodes[s].codeID)
+        #print(sched.streamNodes[s].codeID)
+        builder.PrependUint16(sched.streamNodes[s].codeID)
     the_sched=builder.EndVector()
 
 
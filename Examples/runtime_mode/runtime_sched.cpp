@@ -24,81 +24,304 @@
  */
 #include "runtime_sched.h"
 #include <map>
+#include <new>
+#include <cstddef>
 #include "cg_status.h"
 #include "GenericRuntimeNodes.h"
 
 
 namespace arm_cmsis_stream {
 
+/**
+ * @brief      Check the indexes used by the description
+ *
+ * @param[in]  schedobj  The flatbuffer description of the schedule
+ *
+ * @return     True if the description is consistent
+ */
+static bool check_description(const Schedule *schedobj)
+{
+   auto buffers = schedobj->buffers();
+   auto fifos = schedobj->fifos();
+   auto nodes = schedobj->nodes();
+   auto sched = schedobj->schedule();
+
+   if ((buffers == nullptr) || (fifos == nullptr) ||
+       (nodes == nullptr) || (sched == nullptr))
+   {
+      return(false);
+   }
+
+   for (unsigned int i = 0; i < fifos->size(); i++)
+   {
+       auto f = fifos->Get(i);
+       if ((f->id() != i) || (f->bufid() >= buffers->size()))
+       {
+          return(false);
+       }
+       if ((f->length() == 0) ||
+           (f->length() > buffers->Get(f->bufid())->length()) ||
+           (f->delay() > f->length()))
+       {
+          return(false);
+       }
+       // A buffer is used when there is no delay
+       if (f->buffer() && (f->delay() != 0))
+       {
+          return(false);
+       }
+   }
+
+   for (unsigned int i = 0; i < nodes->size(); i++)
+   {
+       auto n = nodes->Get(i);
+       // The schedule is using the node IDs as index
+       if ((n->uuid() == nullptr) || (n->id() != i))
+       {
+          return(false);
+       }
+       const IOVector *ios[2] = {n->inputs(),n->outputs()};
+       for (const IOVector *v : ios)
+       {
+          if (v == nullptr)
+          {
+             continue;
+          }
+          for (auto io : *v)
+          {
+             if ((io->id() >= fifos->size()) || (io->nb() == 0))
+             {
+                return(false);
+             }
+          }
+       }
+   }
+
+   for (uint16_t id : *sched)
+   {
+       if (id >= nodes->size())
+       {
+          return(false);
+       }
+   }
+   return(true);
+}
+
+/**
+ * @brief      Check the FIFOs once the nodes are bound to them
+ *
+ * @param[in]  c     The runtime context
+ *
+ * @return     True if the FIFOs are used correctly by the schedule
+ */
+static bool check_fifos(const RuntimeContext &c)
+{
+   for (const auto &f : c.fifos)
+   {
+       // One writer and one reader (the scheduling is
+       // inserting duplicate nodes for one to many connections)
+       if ((f->nbWriters() != 1) || (f->nbReaders() != 1) || f->hasTypeMismatch())
+       {
+          return(false);
+       }
+       if ((f->writeBytes() > f->length()) || (f->readBytes() > f->length()))
+       {
+          return(false);
+       }
+       const uint32_t sample_size = f->sampleSize();
+       if ((sample_size != 0) &&
+           (((f->length() % sample_size) != 0) || ((f->delay() % sample_size) != 0)))
+       {
+          return(false);
+       }
+   }
+
+   // In asynchronous mode, the nodes are checking the FIFOs
+   // before being executed.
+   if (c.async_mode)
+   {
+      return(true);
+   }
+
+   // Run an iteration of the schedule on the number of bytes in the FIFOs
+   std::vector<uint32_t> level(c.fifos.size());
+   for (unsigned int i = 0; i < c.fifos.size(); i++)
+   {
+       level[i] = c.fifos[i]->delay();
+   }
+
+   auto nodes = c.schedobj->nodes();
+   for (const RuntimeStep &step : c.steps)
+   {
+       auto n = nodes->Get(step.nodeID);
+       if (n->inputs() != nullptr)
+       {
+          for (auto io : *n->inputs())
+          {
+              const RuntimeEdge &f = *c.fifos[io->id()];
+              if (level[io->id()] < f.readBytes())
+              {
+                 return(false);
+              }
+              level[io->id()] -= f.readBytes();
+          }
+       }
+       if (n->outputs() != nullptr)
+       {
+          for (auto io : *n->outputs())
+          {
+              const RuntimeEdge &f = *c.fifos[io->id()];
+              level[io->id()] += f.writeBytes();
+              if (level[io->id()] > f.length())
+              {
+                 return(false);
+              }
+          }
+       }
+   }
+
+   // The next iteration starts from the same state
+   for (unsigned int i = 0; i < c.fifos.size(); i++)
+   {
+       if (level[i] != c.fifos[i]->delay())
+       {
+          return(false);
+       }
+   }
+   return(true);
+}
+
 /**
  * @brief      Creates a graph.
  *
- * @param[in]  data  The flatbuffer data
- * @param[in]  nb    The number of bytes of data
- * @param[in]  map   The registry
+ * @param[in]  data   The flatbuffer data
+ * @param[in]  nb     The number of bytes of data
+ * @param[in]  map    The registry
+ * @param[out] error  The error code. Can be nullptr.
  *
  * @return     An optional runtime context. Nothing in case of error.
  */
 std::optional<RuntimeContext> create_graph(const unsigned char * data,
                                            const uint32_t nb, 
-                                           const Registry &map)
+                                           const Registry &map,
+                                           int *error)
 {
+   int err_storage;
+   if (error == nullptr)
+   {
+      error = &err_storage;
+   }
+   *error = CG_INIT_FAILURE;
+
+   flatbuffers::Verifier verifier(data, nb);
+   if (!VerifyScheduleBuffer(verifier))
+   {
+      return {};
+   }
+
    RuntimeContext c;
-   bool ok = VerifyScheduleBuffer(flatbuffers::Verifier(data, nb));
-   if (ok)
-   {
-      c.schedobj = GetSchedule(data);
-      auto buffers = c.schedobj->buffers();
-
-      for (unsigned int i = 0; i < buffers->size(); i++)
-      {
-           const uint32_t nb_bytes = buffers->Get(i)->length();
-           std::vector<int8_t> *v = new std::vector<int8_t>(nb_bytes);
-           c.buffers.push_back(std::unique_ptr<std::vector<int8_t>>(v));
-      }
-
-      auto fifos = c.schedobj->fifos();
-      for (unsigned int i = 0; i < fifos->size(); i++)
-      {
-          RuntimeEdge *f = nullptr;
-          const uint16_t bufid = fifos->Get(i)->bufid();
-
-          if (fifos->Get(i)->buffer())
-          {
-             f = new RuntimeBuffer(c.buffers[bufid].get()->data());
-          }
-          else
-          {
-             f = new RuntimeFIFO(c.buffers[bufid].get()->data(),
-                                 fifos->Get(i)->length(),
-                                 fifos->Get(i)->delay());
-          }
-          c.fifos.push_back(std::unique_ptr<RuntimeEdge>(f));
-      }
- 
-      auto nodes = c.schedobj->nodes();
-      for (unsigned int i = 0; i < nodes->size(); i++)
-      {
-          auto n = nodes->Get(i);
-          const UUID_KEY uuid = UUID_KEY(n->uuid()->v()->data());
-          const mkNode_f mkNode = map.at(uuid);
-          auto node = mkNode(c,n);
-          c.nodes.push_back(std::unique_ptr<NodeBase>(node));
-      }
-
-      for (unsigned int i = 0; i < nodes->size(); i++)
-      {
-        auto n = nodes->Get(i);
-        if (n->name() != nullptr)
-        {
-             c.identification[n->name()->str()] = c.nodes[i].get();
-        }
-      }
+   c.schedobj = GetSchedule(data);
+   if (!check_description(c.schedobj))
+   {
+      return {};
+   }
+   c.async_mode = c.schedobj->async_mode();
+
+   // All the buffers are allocated in one memory block
+   auto buffers = c.schedobj->buffers();
+   std::vector<uint32_t> offsets;
+   uint64_t memory_size = 0;
+   const uint64_t align = alignof(std::max_align_t);
+   for (unsigned int i = 0; i < buffers->size(); i++)
+   {
+       offsets.push_back(static_cast<uint32_t>(memory_size));
+       memory_size += (buffers->Get(i)->length() + align - 1) / align * align;
+       if (memory_size > RUNTIME_MAX_MEMORY)
+       {
+          return {};
+       }
+   }
+
+   c.memory_size = static_cast<uint32_t>(memory_size);
+   c.memory.reset(new (std::nothrow) int8_t[c.memory_size == 0 ? 1 : c.memory_size]());
+   if (c.memory == nullptr)
+   {
+      *error = CG_MEMORY_ALLOCATION_FAILURE;
+      return {};
+   }
+   for (uint32_t offset : offsets)
+   {
+       c.buffers.push_back(c.memory.get() + offset);
    }
-   else
+
+   auto fifos = c.schedobj->fifos();
+   for (unsigned int i = 0; i < fifos->size(); i++)
+   {
+       RuntimeEdge *f = nullptr;
+       auto desc = fifos->Get(i);
+       const uint16_t bufid = desc->bufid();
+
+       if (desc->buffer())
+       {
+          f = new (std::nothrow) RuntimeBuffer(c.buffers[bufid],desc->length());
+       }
+       else
+       {
+          f = new (std::nothrow) RuntimeFIFO(c.buffers[bufid],
+                                             desc->length(),
+                                             desc->delay());
+       }
+       if (f == nullptr)
+       {
+          *error = CG_MEMORY_ALLOCATION_FAILURE;
+          return {};
+       }
+       c.fifos.push_back(std::unique_ptr<RuntimeEdge>(f));
+   }
+
+   auto nodes = c.schedobj->nodes();
+   std::vector<const RuntimeComponent*> components;
+   for (unsigned int i = 0; i < nodes->size(); i++)
    {
-     return {};
+       auto n = nodes->Get(i);
+       const UUID_KEY uuid = UUID_KEY(n->uuid()->v()->data());
+       auto component = map.find(uuid);
+       if (component == map.end())
+       {
+          return {};
+       }
+       NodeBase *node = component->second.mkNode(c,n);
+       if (node == nullptr)
+       {
+          return {};
+       }
+       c.nodes.push_back(std::unique_ptr<NodeBase>(node));
+       components.push_back(&component->second);
    }
+
+   for (uint16_t id : *c.schedobj->schedule())
+   {
+       c.steps.push_back(RuntimeStep{c.nodes[id].get(),
+                                     components[id]->run,
+                                     components[id]->prepareForRunning,
+                                     id});
+   }
+
+   if (!check_fifos(c))
+   {
+      return {};
+   }
+
+   for (unsigned int i = 0; i < nodes->size(); i++)
+   {
+     auto n = nodes->Get(i);
+     if (n->name() != nullptr)
+     {
+          c.identification[n->name()->str()] = c.nodes[i].get();
+     }
+   }
+
+   *error = CG_SUCCESS;
    return(c);
 }
 
@@ -133,9 +356,9 @@ NodeBase* get_node(const RuntimeContext& ctx,
  *
  */
 #define HOOK(A,...)                       \
-if (hooks.##A !=nullptr)                  \
+if (hooks.A !=nullptr)                    \
     {                                     \
-        hook_res = hooks.##A(__VA_ARGS__);\
+        hook_res = hooks.A(__VA_ARGS__);  \
         if (hook_res)                     \
         {                                 \
             goto end;                     \
@@ -157,8 +380,9 @@ uint32_t run_graph(const SchedulerHooks &hooks,
                    int *error,
                    int nbIterations)
 {
-    const bool is_async = ctx.schedobj->async_mode();
-    auto sched_desc = ctx.schedobj->schedule();
+    const bool is_async = ctx.async_mode;
+    const RuntimeStep *steps = ctx.steps.data();
+    const uint32_t nb_steps = static_cast<uint32_t>(ctx.steps.size());
     uint32_t nb = 0;
     *error = CG_SUCCESS;
     bool hook_res;
@@ -169,14 +393,15 @@ uint32_t run_graph(const SchedulerHooks &hooks,
     while(true)
     {
         HOOK(before_iteration,error,&nb);
-        for (uint32_t i:*sched_desc) 
+        for (uint32_t s = 0; s < nb_steps; s++) 
         {
-            NodeBase *node = ctx.nodes[i].get();
+            const RuntimeStep &step = steps[s];
+            const int i = step.nodeID;
 
             if (is_async)
             {
                 HOOK(async_before_node_check,error,&nb,i);
-                *error = node->prepareForRunning();
+                *error = step.prepareForRunning(step.node);
                 HOOK(async_after_node_check,error,&nb,i);
                 if (*error == CG_SKIP_EXECUTION)
                 {
@@ -191,7 +416,7 @@ uint32_t run_graph(const SchedulerHooks &hooks,
             }
 
             HOOK(before_node_execution,error,&nb,i);
-            *error = node->run();
+            *error = step.run(step.node);
             HOOK(after_node_execution,error,&nb,i);
 
             if (*error != CG_SUCCESS)
@@ -62,6 +62,35 @@ struct RuntimeContext;
 typedef NodeBase* (*mkNode_f)(const RuntimeContext &ctx, 
                               const Node *desc);
 
+/**
+ * Function pointer type to run a node (or check if it can
+ * be run in asynchronous mode)
+ */
+typedef int (*runNode_f)(NodeBase *node);
+
+/**
+ * @brief      Functions of a kind of node
+ */
+struct RuntimeComponent {
+  mkNode_f mkNode;
+  runNode_f run;
+  runNode_f prepareForRunning;
+};
+
+/**
+ * @brief      Step of the schedule
+ *
+ * The schedule is converted into an array of steps when the
+ * graph is created so that the scheduler does not need to go
+ * through the flatbuffer description and the virtual functions
+ * of the nodes.
+ */
+struct RuntimeStep {
+  NodeBase *node;
+  runNode_f run;
+  runNode_f prepareForRunning;
+  uint16_t nodeID;
+};
 
 /**
  * @brief      Runtime context
@@ -72,12 +101,20 @@ typedef NodeBase* (*mkNode_f)(const RuntimeContext &ctx,
 struct RuntimeContext {
   //! Flat buffer description of the schedule
   const Schedule *schedobj;
-  //! Memory buffers
-  std::vector<std::unique_ptr<std::vector<int8_t>>> buffers;
+  //! Asynchronous mode
+  bool async_mode;
+  //! One memory block for all the buffers
+  std::unique_ptr<int8_t[]> memory;
+  //! Size of the memory block in bytes
+  uint32_t memory_size;
+  //! Memory buffers (in the memory block)
+  std::vector<int8_t*> buffers;
   //! FIFOs or Buffers
   std::vector<std::unique_ptr<RuntimeEdge>> fifos;
   //! Nodes
   std::vector<std::unique_ptr<NodeBase>> nodes;
+  //! Schedule
+  std::vector<RuntimeStep> steps;
   //! Node identification (some nodes are named)
   std::map<const std::string,NodeBase*> identification;
 };
@@ -148,21 +185,36 @@ protected:
 };
 
 //! Datatype for the registry of node categories (API for each kind of node)
-using Registry = std::map<UUID_KEY,mkNode_f,std::less<UUID_KEY>>;
+using Registry = std::map<UUID_KEY,RuntimeComponent,std::less<UUID_KEY>>;
 
+/**
+ * @brief      Maximum size of the memory block allocated for the buffers
+ */
+#if !defined(RUNTIME_MAX_MEMORY)
+#define RUNTIME_MAX_MEMORY (16*1024*1024)
+#endif
 
 /**
  * @brief      Creates a graph.
  *
- * @param[in]  data  The flatbuffer data
- * @param[in]  nb    The number of bytes of data
- * @param[in]  map   The registry
+ * The description is validated before being used: flatbuffer
+ * structure, indexes of buffers, FIFOs and nodes, registered
+ * node kinds, sizes of the FIFOs, sample types of the IOs
+ * connected by a FIFO and, in synchronous mode, absence of
+ * overflow and underflow during an iteration of the schedule.
+ *
+ * @param[in]  data   The flatbuffer data
+ * @param[in]  nb     The number of bytes of data
+ * @param[in]  map    The registry
+ * @param[out] error  The error code (CG_INIT_FAILURE for an invalid
+ *                    description). Can be nullptr.
  *
  * @return     An optional runtime context. Nothing in case of error.
  */
 extern std::optional<RuntimeContext> create_graph(const unsigned char * data,
                                                   const uint32_t nb, 
-                                                  const Registry &map);
+                                                  const Registry &map,
+                                                  int *error=nullptr);
 
 /**
  * @brief      Run the graph
@@ -197,6 +249,24 @@ extern NodeBase* get_node(const RuntimeContext& ctx,const std::string &name);
 template<typename T>
 struct Component 
 {
+   /**
+    * @brief      Run a node of this kind
+    * 
+    * The call is not virtual
+    */
+   static int run(NodeBase *node)
+   {
+      return(static_cast<T*>(node)->T::run());
+   };
+
+   /**
+    * @brief      Check if a node of this kind can be run
+    */
+   static int prepareForRunning(NodeBase *node)
+   {
+      return(static_cast<T*>(node)->T::prepareForRunning());
+   };
+
    /**
     * @brief      Register the component in the registry
     *
@@ -204,7 +274,9 @@ struct Component
     */
    static void reg(Registry& res)
    {
-      res[UUID_KEY(T::uuid.data())] = &T::mkNode;
+      res[UUID_KEY(T::uuid.data())] = RuntimeComponent{&T::mkNode,
+                                                       &Component<T>::run,
+                                                       &Component<T>::prepareForRunning};
    };
 };
 
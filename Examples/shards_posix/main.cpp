@@ -0,0 +1,107 @@
+/*
+ * Start and stop shards of the POSIX runtime while other threads are
+ * still pushing events to their queues.
+ *
+ * Each shard runs an event only graph: one node counting the events it
+ * receives. For each round, the shards are started, producer threads
+ * push events to all the queues and the shards are stopped one after
+ * the other while the producers are still running. The pushes to a
+ * stopped shard are rejected.
+ */
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "stream_runtime_init.hpp"
+
+using namespace arm_cmsis_stream;
+
+#define NB_SHARDS 4
+#define NB_PRODUCERS 2
+#define NB_ROUNDS 50
+
+class CounterNode : public StreamNode
+{
+  public:
+    cg_status processEvent(int, Event &&) final
+    {
+        nbEvents.fetch_add(1, std::memory_order_relaxed);
+        return CG_SUCCESS;
+    }
+
+    std::atomic<uint64_t> nbEvents = 0;
+};
+
+static void producer(EventQueue **queues, CounterNode *nodes, std::atomic<bool> *stop,
+                     std::atomic<uint64_t> *nbRejected)
+{
+    uint32_t k = 0;
+    while (!stop->load()) {
+        int i = k % NB_SHARDS;
+        if (!queues[i]->push(LocalDestination{&nodes[i], 0}, Event(kDo, kNormalPriority))) {
+            nbRejected->fetch_add(1, std::memory_order_relaxed);
+        }
+        k++;
+    }
+}
+
+int main()
+{
+    uint64_t nbProcessed = 0;
+    std::atomic<uint64_t> nbRejected = 0;
+
+    if (stream_init_memory() != 0) {
+        return 1;
+    }
+
+    for (int round = 0; round < NB_ROUNDS; round++) {
+        stream_execution_context_t contexts[NB_SHARDS] = {};
+        EventQueue *queues[NB_SHARDS];
+        CounterNode nodes[NB_SHARDS];
+        stream_shard_t *shards[NB_SHARDS];
+
+        for (int i = 0; i < NB_SHARDS; i++) {
+            queues[i] = stream_new_event_queue();
+            if (queues[i] == nullptr) {
+                std::printf("Can't create event queue\n");
+                return 1;
+            }
+            // Event only graph: no dataflow scheduler
+            contexts[i].evtQueue = queues[i];
+            shards[i] = stream_start_shard(&contexts[i]);
+            if (shards[i] == nullptr) {
+                std::printf("Can't start shard %d\n", i);
+                return 1;
+            }
+        }
+
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < NB_PRODUCERS; p++) {
+            producers.emplace_back(producer, queues, nodes, &stop, &nbRejected);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        for (int i = 0; i < NB_SHARDS; i++) {
+            stream_stop_shard(shards[i]);
+        }
+
+        stop.store(true);
+        for (auto &t : producers) {
+            t.join();
+        }
+        for (int i = 0; i < NB_SHARDS; i++) {
+            nbProcessed += nodes[i].nbEvents.load();
+            delete queues[i];
+        }
+    }
+
+    stream_stop_shards();
+    stream_free_memory();
+
+    std::printf("%d rounds: %llu events processed, %llu pushes rejected\n", NB_ROUNDS,
+                static_cast<unsigned long long>(nbProcessed),
+                static_cast<unsigned long long>(nbRejected.load()));
+    return 0;
+}
@@ -3,6 +3,7 @@ import numpy as np
 import os 
 import weakref 
 import mmap 
+import time
 
 class Priority:
     kLowPriority = 0
@@ -561,6 +562,102 @@ class Unpack:
         return(nodeid,evt)
 
 
+# A batch frame starts with this value in place of a node ID.
+# It is followed by the number of events and each event is
+# preceded by its packed length.
+BATCH_FRAME_MARKER = 0xFFFFFFFE
+
+class PackBatch:
+    """Pack several events in one batch frame"""
+    def __init__(self,memserver=None):
+        self.memserver = memserver
+        self.events = []
+
+    def pack(self,nodeid,event,network=False):
+        p = Pack(self.memserver)
+        p.pack(nodeid,event,network)
+        self.events.append(p.bytes)
+
+    @property
+    def nb_events(self):
+        return len(self.events)
+
+    @property
+    def size(self):
+        return 8 + sum([4 + len(e) for e in self.events])
+
+    def reset(self):
+        self.events = []
+
+    @property
+    def bytes(self):
+        res = bytearray(struct.pack('<II', BATCH_FRAME_MARKER, len(self.events)))
+        for e in self.events:
+            res.extend(struct.pack('<I', len(e)))
+            res.extend(e)
+        return res
+
+def is_batch(data):
+    return len(data) >= 8 and struct.unpack('<I', data[:4])[0] == BATCH_FRAME_MARKER
+
+def unpack_events(data,memserver=None):
+    """List of (nodeid,event) contained in a frame.
+       The frame can be a batch frame or a single event.
+    """
+    if not is_batch(data):
+        return [Unpack(data,memserver).unpack_event()]
+    nb_events = struct.unpack('<I', data[4:8])[0]
+    pos = 8
+    res = []
+    for _ in range(nb_events):
+        if len(data) - pos < 4:
+            break
+        length = struct.unpack('<I', data[pos:pos+4])[0]
+        pos = pos + 4
+        if len(data) - pos < length:
+            break
+        res.append(Unpack(data[pos:pos+length],memserver).unpack_event())
+        pos = pos + length
+    return res
+
+class BatchSender:
+    """Coalesce events sent within a time or size window.
+
+       write is called with each frame (including the 4 bytes length
+       used for framing on the link). A frame is sent when its size
+       reaches max_size, when the oldest event is older than max_delay
+       seconds (checked by send and poll) or when flush is called.
+    """
+    def __init__(self,write,max_size=1024,max_delay=0.005,memserver=None):
+        self.write = write
+        self.max_size = max_size
+        self.max_delay = max_delay
+        self.batch = PackBatch(memserver)
+        self.first_time = None
+
+    def send(self,nodeid,event,network=False):
+        if self.batch.nb_events == 0:
+            self.first_time = time.monotonic()
+        self.batch.pack(nodeid,event,network)
+        if self.batch.size >= self.max_size:
+            self.flush()
+        else:
+            self.poll()
+
+    def poll(self):
+        if self.batch.nb_events > 0:
+            if time.monotonic() - self.first_time >= self.max_delay:
+                self.flush()
+
+    def flush(self):
+        if self.batch.nb_events == 0:
+            return
+        frame = self.batch.bytes
+        self.write(struct.pack('<I', len(frame)) + frame)
+        self.batch.reset()
+        self.first_time = None
+
+
 if __name__ == "__main__":
     # data 4.5 2
     combined=b'\x00\x00\x00\x00\x01\x00\x00\x00\x01\x01\x02\x00\x00\x00\x06\x00\x00\x00\x00\x00\x00\x12\x40\x03\x02\x00\x00\x00'
@@ -584,4 +681,10 @@ if __name__ == "__main__":
     print("\nUnpacking packed data")
     new_unpack = Unpack(pack.bytes)
     new_nodeid,new_evt= new_unpack.unpack_event()
-    print(new_nodeid,new_evt)
\ No newline at end of file
+    print(new_nodeid,new_evt)
+
+    print("\nBatch")
+    batch = PackBatch()
+    batch.pack(nodeid, evt)
+    batch.pack(3, Event(6,1,[4.5,2]))
+    print(unpack_events(batch.bytes))
\ No newline at end of file
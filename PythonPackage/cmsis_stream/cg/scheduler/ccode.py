@@ -29,6 +29,8 @@ from jinja2 import Environment, PackageLoader, select_autoescape
 import os.path
 import pathlib
 from .config import *
+from .node import GenericFunction
+from .args import FifoID, FifoPtrID
 
 def selector_define_name(sel):
     return f"SEL_{sel.upper()}_ID"
@@ -83,6 +85,112 @@ def mkPublishers(config,sched):
    return(n,p)
 
 
+def static_fifo_pointer(fifoID,offset):
+   if offset == 0:
+      return f"fifoBuf{fifoID}"
+   return f"fifoBuf{fifoID}+{offset}"
+
+def move_samples(fifo,move):
+   src,nb = move
+   # The samples may overlap their destination
+   func = "memcpy" if src >= nb else "memmove"
+   return f"{func}(fifoBuf{fifo.fifoID},fifoBuf{fifo.fifoID}+{src},{nb}*sizeof({fifo.theType.ctype}));"
+
+def mkStaticFIFOs(sched,config):
+   """Code of each step of the schedule when the FIFO buffers
+   are computed at generation time"""
+   graph = sched._graph
+   offsets = sched.staticFIFOOffsets
+   static = sched.staticFIFOs
+
+   # A FIFO between two pure functions has no object
+   objects = [f.fifoID for f in graph._allFIFOs
+              if not f.fifoID in static or
+                 not isinstance(f.src.owner,GenericFunction) or
+                 not isinstance(f.dst.owner,GenericFunction)]
+
+   steps = [{"prologue":[],"pointers":{}} for _ in sched.schedule]
+   epilogue = []
+   init = {}
+   used = set()
+   for fifoID,fifo in static.items():
+      start,accesses,end = offsets[fifoID]
+      # The StaticFIFO objects are created with the last buffers
+      # of an iteration so that all iterations are identical
+      current = {}
+      for t,io,isWrite,offset,move in accesses:
+         current[isWrite] = offset
+      init[fifoID] = (current[False],current[True])
+      if config.heapAllocation:
+         arg = FifoPtrID(fifoID,owner="fifos")
+      else:
+         arg = FifoID(fifoID)
+      for t,io,isWrite,offset,move in accesses:
+         if move is not None:
+            steps[t]["prologue"].append(move_samples(fifo,move))
+            used.add(fifoID)
+         pointer = static_fifo_pointer(fifoID,offset)
+         if isinstance(io.owner,GenericFunction):
+            steps[t]["pointers"][io.name] = pointer
+            used.add(fifoID)
+         elif offset != current[isWrite]:
+            method = "setWriteBuffer" if isWrite else "setReadBuffer"
+            steps[t]["prologue"].append(f"{arg.access}{method}({pointer});")
+            current[isWrite] = offset
+            used.add(fifoID)
+      if end is not None:
+         epilogue.append(move_samples(fifo,end))
+         used.add(fifoID)
+
+   for t,s in enumerate(sched.schedule):
+      node = sched.streamNodes[s]
+      if isinstance(node,GenericFunction):
+         steps[t]["run"] = node.cRun(config,pointers=steps[t]["pointers"])
+      else:
+         steps[t]["run"] = node.cRun(config)
+      steps[t]["node"] = s
+
+   buffers = [(f,graph._allFIFOs[f].theType.ctype,graph._allFIFOs[f].bufName(config))
+              for f in sorted(used)]
+
+   return({"objects":objects,
+           "init":init,
+           "buffers":buffers,
+           "steps":steps,
+           "epilogue":epilogue})
+
+def mkArenaObjects(sched,fifoObjects):
+   """FIFOs and nodes placed in the arena in the order of
+   their first use in the schedule: ("fifo",ID) or ("node",node)"""
+   graph = sched._graph
+   fifoSet = set(fifoObjects)
+   objects = []
+   placed = set()
+   def add(kind,o):
+      if not (kind,o) in placed:
+         placed.add((kind,o))
+         objects.append((kind,o))
+
+   for s in sched.schedule:
+      inputs,outputs = graph._nodeFIFOs[s]
+      for fifoID,io in inputs:
+         if fifoID in fifoSet:
+            add("fifo",fifoID)
+      node = sched.streamNodes[s]
+      if node.hasState:
+         add("node",node)
+      for fifoID,io in outputs:
+         if fifoID in fifoSet:
+            add("fifo",fifoID)
+
+   # Event nodes and FIFOs not used by the schedule
+   for fifoID in fifoObjects:
+      add("fifo",fifoID)
+   for node in sched.allNodes:
+      if node.hasState:
+         add("node",node)
+   return(objects)
+
 def gencode(sched,directory,config):
 
 
@@ -123,6 +231,31 @@ def gencode(sched,directory,config):
        config.switchCase = True
        config.heapAllocation = True
 
+    # Nested loops are generated from the unrolled schedule
+    # so they are not possible when the switch case is forced
+    loops = None
+    if config.nestedLoops and not (config.asynchronous or config.fullyAsynchronous or config.callback):
+       config.switchCase = False
+       loops = sched.loopedSchedule
+
+    # The static FIFOs are generated from the unrolled schedule
+    staticFIFOs = None
+    if config.staticFIFOs and not (config.asynchronous or config.fullyAsynchronous or config.callback):
+       config.switchCase = False
+       loops = None
+
+    # Latency between sources and sinks written in the header
+    latencies = []
+    if config.scheduleObjective == "latency" and not (config.asynchronous or config.fullyAsynchronous):
+       for (src,sink),(steps,time) in sched.latency.items():
+           name = f"{config.prefix.upper()}LATENCY_{src.nodeName.upper()}_{sink.nodeName.upper()}"
+           latencies.append((name,steps,time))
+
+    # Iteration time estimated with the measured node costs
+    iterationTime = None
+    if config.nodeCosts is not None and not (config.asynchronous or config.fullyAsynchronous):
+       iterationTime = sched.iterationTime
+
     identifiedNodes = []
     if config.nodeIdentification:
        config.heapAllocation = True
@@ -153,6 +286,19 @@ def gencode(sched,directory,config):
 
     node_to_id,publishers = mkPublishers(config,sched)
 
+    if config.staticFIFOs and not config.switchCase:
+       staticFIFOs = mkStaticFIFOs(sched,config)
+       fifoObjects = staticFIFOs["objects"]
+    else:
+       fifoObjects = list(range(nbFifos))
+
+    # heapAllocation may have been enabled by callback or
+    # nodeIdentification
+    objectArena = config.heapAllocation and config.objectArena
+    arenaObjects = []
+    if objectArena:
+       arenaObjects = mkArenaObjects(sched,fifoObjects)
+
     selector_inits = mk_selector_inits(sched)
 
 
@@ -167,6 +313,11 @@ def gencode(sched,directory,config):
             eventNodes=sched.eventNodes,
             schedule=sched.schedule,
             schedLen=len(sched.schedule),
+            loops=loops,
+            staticFIFOs=staticFIFOs,
+            fifoObjects=fifoObjects,
+            objectArena=objectArena,
+            arenaObjects=arenaObjects,
             schedSwitchDataType=schedSwitchDataType,
             config=config,
             sched=sched,
@@ -188,6 +339,9 @@ def gencode(sched,directory,config):
             sched=sched,
             schedLen=len(sched.schedule),
             identifiedNodes=identifiedNodes,
+            objectArena=objectArena,
+            latencies=latencies,
+            iterationTime=iterationTime,
             selector_defines=selector_defines(sched),
             ),file=f)
 
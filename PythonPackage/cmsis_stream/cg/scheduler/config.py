@@ -43,9 +43,65 @@ class Configuration:
         # Experimental so disabled by default
         self.memoryOptimization = False
 
+        # Allocation of the FIFOs used as arrays when
+        # memoryOptimization is enabled:
+        # "arena" : FIFOs are placed at offsets in one buffer
+        # using their live intervals
+        # "coloring" : FIFOs are sharing buffers using a coloring of
+        # the interference graph (memStrategy and optimalColoringMaxVisits)
+        self.memoryAllocator = "arena"
+
+        # Alignment in bytes of the FIFOs in the arena.
+        # When None, a FIFO is aligned on the size of its datatype.
+        # The arena itself is aligned with CG_BEFORE_BUFFER
+        self.arenaAlignment = None
+
+        # Share the buffers of the FIFOs in asynchronous mode.
+        # The FIFOs that can never contain samples at the same
+        # time are placed in an arena.
+        # The analysis assumes that a node reads and writes the
+        # number of samples declared on its IOs and that it runs each
+        # time its FIFOs allow it (unless asyncMaySkip is set on the node)
+        self.asyncMemoryOptimization = False
+
+        # Max number of FIFO states explored by the asynchronous
+        # buffer sharing analysis. When there are more states, 
+        # the FIFOs are not shared.
+        self.asyncMemoryMaxStates = 100000
+
+        # Chains of elementwise functions (Unary and Binary nodes)
+        # are fused into one node computing in place in the output
+        # buffer. The intermediate FIFOs are removed.
+        # The functions must support in place computation
+        self.fuseElementwiseFunctions = False
+
         # Give priority to sink with topological sort 
         self.sinkPriority = True
 
+        # Objective used to select the next node of the schedule:
+        # "occupancy" : the node giving the smallest normalized
+        # FIFO occupancy
+        # "locality" : the node reading the most recently produced data
+        # (fewest bytes written since) so that a consumer runs while
+        # the data of its producer is still in the cache.
+        # The occupancy is used between nodes at the same distance.
+        # "singleAppearance" : each node runs all its executions in a row
+        # in topological order. The schedule is compact (one loop per
+        # node with nestedLoops) but the FIFOs are bigger.
+        # "latency" : the schedule with the smallest worst latency between
+        # a source and a sink. The latencies are written in the
+        # generated header.
+        # sinkPriority is ignored with "locality", "singleAppearance"
+        # and "latency"
+        self.scheduleObjective = "occupancy"
+
+        # Measured costs of the nodes : path of the JSON file written
+        # by the node profiler of the POSIX runtime or the
+        # corresponding dictionary (see Graph.applyNodeCosts).
+        # They replace the cost of the nodes used for the latency
+        # estimates, the predicted iteration time and Schedule.partition
+        self.nodeCosts = None
+
         # Print schedule in a human understandble form
         self.dumpSchedule = False
 
@@ -122,6 +178,29 @@ class Configuration:
         # we can generate a switch/case instead
         self.switchCase = True
 
+        # The schedule is compressed into nested for loops
+        # in the generated code. It implies no switchCase
+        # and is ignored in asynchronous and callback modes
+        self.nestedLoops = False
+
+        # The FIFO read and write buffers are computed when the
+        # code is generated. The pure functions use constant
+        # pointers and the C++ nodes use StaticFIFO objects.
+        # It implies an unrolled schedule (no switchCase and no
+        # nestedLoops) and is ignored in asynchronous and callback modes
+        self.staticFIFOs = False
+
+        # The nodes supporting it (BaseNode.exactFIFOTypes) get the
+        # types of their FIFOs as additional template arguments
+        # so that the FIFO functions are not virtual calls
+        self.exactFIFOTypes = False
+
+        # In heapAllocation mode, the FIFOs and nodes are
+        # constructed in one block (the arena) instead of being
+        # allocated one by one. The block is provided by the
+        # application or allocated with CG_MALLOC
+        self.objectArena = False
+
 
         # Enable support for CMSIS Event Recorder 
         self.eventRecorder = False
@@ -211,6 +290,12 @@ class Configuration:
         # like CMSIS-DSP
         self.asyncDefaultSkip = True
 
+        # When FIFOs are sharing memory in asynchronous mode,
+        # check after each node execution that no FIFO sharing 
+        # memory with an output of the node contains samples.
+        # The scheduler stops with CG_SHARED_FIFO_CONFLICT otherwise.
+        self.asyncMemoryCheck = False
+
         
 
         # Buffer are allocated through memory allocator
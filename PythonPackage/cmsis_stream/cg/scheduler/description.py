@@ -29,6 +29,9 @@ import networkx as nx
 import numpy as np 
 import math 
 import json 
+import bisect
+from collections import deque
+from fractions import Fraction
 import os.path
 
 from sympy import Matrix
@@ -126,6 +129,27 @@ class CannotReuseCustomBufferMoreThanOnce(Exception):
     def __str__(self):
         return(f"custom buffer: {self._name}")
 
+class UnknownMemoryAllocator(Exception):
+    def __init__(self,name):
+        self._name = name
+
+    def __str__(self):
+        return(f"memory allocator: {self._name} (must be arena or coloring)")
+
+class UnknownScheduleObjective(Exception):
+    def __init__(self,name):
+        self._name = name
+
+    def __str__(self):
+        return(f"schedule objective: {self._name} (must be occupancy, locality, singleAppearance or latency)")
+
+class NodeCostError(Exception):
+    def __init__(self,msg):
+        self._msg = msg
+
+    def __str__(self):
+        return(f"node costs: {self._msg}")
+
 class DupDestination:
     def __init__(self,
                  node,
@@ -175,6 +199,9 @@ class FIFODesc:
         self.theType = None 
         # Buffer used by FIFO (allocated by the scheduler)
         self.buffer=None 
+        # Offset in bytes of the FIFO in the buffer
+        # (when the buffer is the arena of the memory optimization)
+        self.bufferOffset=0
         # Custom buffer assigned to FIFO 
         self.customBuffer = customBuffer
         # Used for plot in graphviz
@@ -264,6 +291,11 @@ class FIFODesc:
         if (theTime > stop):
             self._liveInterval=(start,theTime)
 
+    @property
+    def bufferLocation(self):
+        """Identify the memory used by the FIFO"""
+        return((self.buffer,self.bufferOffset))
+
     def bufName(self,config):
         if not self.customBuffer is None:
             if self.customBuffer.assignedByNode:
@@ -271,15 +303,23 @@ class FIFODesc:
             else:
                return(self.customBuffer.name)
         if config.bufferAllocation:
-           return(f"buffers.buf{self.buffer._bufferID}")
+           name = f"buffers.buf{self.buffer._bufferID}"
         else:
-           return(f"{config.prefix}buf{self.buffer._bufferID}")
+           name = f"{config.prefix}buf{self.buffer._bufferID}"
+        if self.bufferOffset > 0:
+           return(f"{name}+{self.bufferOffset}")
+        return(name)
 
     @property
     def fifo_class_str (self):
         self._mk_fifo_desc()
         return f"{self._fifo_desc_for_code.cname}"
 
+    def cType(self,config):
+        """C++ type of the FIFO object in the generated code"""
+        isAsync = 1 if config.asynchronous or config.fullyAsynchronous else 0
+        return f"{self.fifo_class_str}<{self.theType.ctype},FIFOSIZE{self.fifoID},{self.isArrayAsInt},{isAsync}>"
+
     @property
     def fifo_additional_args (self):
         self._mk_fifo_desc()
@@ -312,6 +352,85 @@ def analyzeStep(vec,allFIFOs,theTime):
             allFIFOs[fifoID].recordRead(theTime) 
         fifoID = fifoID + 1
 
+def analyzeSparseStep(changes,allFIFOs,theTime):
+    """Same as analyzeStep for a list of (fifo position, change)"""
+    for fifoID,change in changes:
+        if change > 0:
+            allFIFOs[fifoID].recordWrite(theTime)
+    for fifoID,change in changes:
+        if change < 0:
+            allFIFOs[fifoID].recordRead(theTime)
+
+class FIFOOccupancy:
+    """Incremental FIFO state used during the schedule computation.
+
+    The execution of a node only changes the FIFOs connected to this node.
+    The occupancy numbers (FIFO content normalized by normV) of the other 
+    FIFOs are not recomputed : they are kept sorted to get the maximum 
+    occupancy of the FIFOs not changed by a candidate node.
+    The values are the same as the ones computed with numpy
+    on the full FIFO vector.
+    """
+    def __init__(self,b,normV):
+        self.b = [float(x) for x in b]
+        self._normV = [float(x) for x in normV]
+        self._occupancy = [self.occupancy(e,x) for e,x in enumerate(self.b)]
+        # FIFO with a zero normalization value and no data
+        self._nan = set(e for e,o in enumerate(self._occupancy) if math.isnan(o))
+        self._sorted = sorted((o,e) for e,o in enumerate(self._occupancy) if not math.isnan(o))
+
+    def occupancy(self,e,x):
+        d = self._normV[e]
+        if d != 0:
+            return x / d
+        # Same result as the numpy division
+        if x == 0:
+            return math.nan 
+        return math.copysign(math.inf,x)
+
+    def newValues(self,changes):
+        """FIFO values after the changes"""
+        return [(e,self.b[e] + c) for e,c in changes]
+
+    def localMax(self,newValues):
+        """Maximum occupancy of the changed FIFOs"""
+        m = -math.inf
+        for e,x in newValues:
+            o = self.occupancy(e,x)
+            if math.isnan(o):
+                return math.nan
+            if o > m:
+                m = o
+        return m
+
+    def maxOccupancy(self,touched,localMax):
+        """Maximum occupancy of all FIFOs when the FIFOs in touched
+        have a maximum occupancy of localMax.
+        NaN is propagated like with numpy max."""
+        if math.isnan(localMax):
+            return math.nan
+        if self._nan and not self._nan.issubset(touched):
+            return math.nan
+        for o,e in reversed(self._sorted):
+            if not e in touched:
+                return o if o > localMax else localMax
+        return localMax
+
+    def apply(self,changes):
+        for e,c in changes:
+            old = self._occupancy[e]
+            if math.isnan(old):
+                self._nan.discard(e)
+            else:
+                del self._sorted[bisect.bisect_left(self._sorted,(old,e))]
+            self.b[e] = self.b[e] + c
+            new = self.occupancy(e,self.b[e])
+            self._occupancy[e] = new
+            if math.isnan(new):
+                self._nan.add(e)
+            else:
+                bisect.insort(self._sorted,(new,e))
+
 def optimal_coloring(nodes, adj, max_visits=131072):
     """Exact graph coloring via backtracking with a node-visit budget.
 
@@ -351,6 +470,151 @@ def optimal_coloring(nodes, adj, max_visits=131072):
             return None
     return None
 
+def arena_layout(blocks, conflicts):
+    """Offsets of buffers in an arena (greedy by size with best fit).
+
+    Args:
+        blocks: list of (key, size, alignment) in placement order 
+                (biggest first)
+        conflicts: dict mapping each key to the set of keys of the blocks
+                   live at the same time
+
+    Each block is placed in the smallest gap, between the blocks already
+    placed and conflicting with it, that is big enough. If there is no
+    such gap, it is placed after those blocks.
+
+    Returns (dict[key, offset], size of the arena).
+    """
+    def aligned(offset, alignment):
+        return (offset + alignment - 1) // alignment * alignment
+
+    offsets = {}
+    sizes = {}
+    arenaSize = 0
+    for key, size, alignment in blocks:
+        placed = sorted((offsets[o], offsets[o] + sizes[o])
+                        for o in conflicts[key] if o in offsets)
+        best = None
+        bestGap = None
+        current = 0
+        for start, stop in placed:
+            gap = start - aligned(current, alignment)
+            if gap >= size and (bestGap is None or gap < bestGap):
+                best = aligned(current, alignment)
+                bestGap = gap
+            current = max(current, stop)
+        if best is None:
+            best = aligned(current, alignment)
+        offsets[key] = best
+        sizes[key] = size
+        arenaSize = max(arenaSize, best + size)
+    return offsets, arenaSize
+
+def looped_schedule(schedule, maxPeriod=64):
+    """Schedule as nested loops (lossless compression).
+
+    Args:
+        schedule: list of node IDs
+        maxPeriod: max length of a loop body
+
+    At each position, the repeated sequence removing the most node
+    executions from the schedule is replaced by a loop and its body
+    is compressed the same way. A schedule where each node runs all its
+    executions in a row (single appearance schedule) becomes one loop
+    per node.
+
+    Returns a list where each item is a node ID or a
+    (count, list of items) loop.
+    """
+    result = []
+    i = 0
+    n = len(schedule)
+    while i < n:
+        bestSaved = 0
+        bestPeriod = 1
+        bestCount = 1
+        for p in range(1, min(maxPeriod, (n - i) // 2) + 1):
+            k = 1
+            while (i + (k + 1) * p <= n and
+                   schedule[i + k * p] == schedule[i] and
+                   schedule[i + k * p:i + (k + 1) * p] == schedule[i:i + p]):
+                k = k + 1
+            if p * (k - 1) > bestSaved:
+                bestSaved = p * (k - 1)
+                bestPeriod = p
+                bestCount = k
+        if bestCount > 1:
+            body = looped_schedule(schedule[i:i + bestPeriod], maxPeriod)
+            # (a (b body)) is (a*b body)
+            if len(body) == 1 and isinstance(body[0], tuple):
+                result.append((bestCount * body[0][0], body[0][1]))
+            else:
+                result.append((bestCount, body))
+            i = i + bestCount * bestPeriod
+        else:
+            result.append(schedule[i])
+            i = i + 1
+    return result
+
+def static_fifo_offsets(accesses, length, delay, maxIterations=8):
+    """Offsets of the reads and writes of a FIFO during an iteration
+    of a synchronous schedule.
+
+    Args:
+        accesses: list of (number of samples, isWrite) in the order
+                  of the schedule
+        length: FIFO length
+        delay: number of initial samples
+
+    The samples in the FIFO are contiguous. A write is done at the
+    start of the buffer when the FIFO is empty and the samples are
+    moved to the start of the buffer only when there is not enough
+    space after them.
+
+    The initial samples of a delay are zeros so they can be at any
+    offset. The start offset is chosen so that all the iterations
+    use the same offsets. If it is not found after maxIterations, the
+    samples are moved back to the start of the buffer at the end of
+    the iteration.
+
+    Returns (start, offsets, moves, end) where start is the offset of
+    the delay samples, offsets the offset of each access, moves for each
+    access None or the (offset, number of samples) to move to the start
+    of the buffer before the access and end None or the move to do at
+    the end of the iteration.
+    """
+    def run(start):
+        r = start
+        w = start + delay
+        offsets = []
+        moves = []
+        for nb, isWrite in accesses:
+            move = None
+            if not isWrite:
+                offsets.append(r)
+                r = r + nb
+            else:
+                if r == w:
+                    r = w = 0
+                elif w + nb > length:
+                    move = (r, w - r)
+                    w = w - r
+                    r = 0
+                offsets.append(w)
+                w = w + nb
+            moves.append(move)
+        return offsets, moves, r
+
+    start = 0
+    for _ in range(maxIterations):
+        offsets, moves, end = run(start)
+        # Without delay, the first access is a write to an empty FIFO
+        if delay == 0 or end == start:
+            return start, offsets, moves, None
+        start = end
+    offsets, moves, end = run(0)
+    return 0, offsets, moves, (end, delay)
+
 class Graph():
 
     def __init__(self):
@@ -654,6 +918,105 @@ class Graph():
                         
 
                
+    def _disconnect(self,nodea,nodeb):
+        """Remove the connection before the graph is rewritten and return
+        the FIFO settings to connect again"""
+        settings = {"fifoClass" : self._FIFOClasses.get((nodea,nodeb),self.defaultFIFOClass),
+                    "fifoScale" : self._FIFOScale.get((nodea,nodeb),1.0),
+                    "fifoAsyncLength" : self._FIFOAsyncLength.get((nodea,nodeb),0),
+                    "weak" : self._FIFOWeak.get((nodea,nodeb),False)}
+        delay = self._delays.get((nodea,nodeb),0)
+        buffer = self._FIFOCustomBuffer.get((nodea,nodeb),None)
+        if not buffer is None and not self._InheritedFIFOConstraint[(nodea,nodeb)]:
+           settings["buffer"] = buffer.name
+           settings["customBufferMustBeArray"] = buffer.mustBeArray
+
+        nodea.fifo.remove((nodea,nodeb))
+        nodeb.fifo.remove((nodea,nodeb))
+        del self._edges[(nodea,nodeb)]
+        for d in [self._FIFOClasses,self._FIFOScale,self._FIFOAsyncLength,
+                  self._FIFOWeak,self._FIFOCustomBuffer,
+                  self._InheritedFIFOConstraint,self._delays]:
+            if (nodea,nodeb) in d:
+               del d[(nodea,nodeb)]
+        return(delay,settings)
+
+    def _connectAgain(self,nodea,nodeb,delay,settings):
+        if delay > 0:
+           self.connectWithDelay(nodea,nodeb,delay,**settings)
+        else:
+           self.connect(nodea,nodeb,**settings)
+
+    def _isElementwiseFunction(self,node):
+        if not isinstance(node,(Unary,Binary)) or node.schedArgs:
+           return(False)
+        return(all(isinstance(io.nbSamples,int) for io in list(node._inputs.values()) + list(node._outputs.values())))
+
+    def _fusedSuccessor(self,node):
+        """Next node of a chain of elementwise functions or None"""
+        if not self._isElementwiseFunction(node):
+           return(None)
+        output = node._outputs[node.outputNames[0]]
+        # Output connected to only one input
+        if len(output.fifo) != 1:
+           return(None)
+        nodea,nodeb = output.fifo[0]
+        if not self._isElementwiseFunction(nodeb.owner) or nodeb.owner is node:
+           return(None)
+        # The FIFO must be a plain one that can be removed
+        if (nodea,nodeb) in self._delays or (nodea,nodeb) in self._FIFOCustomBuffer:
+           return(None)
+        if self._FIFOClasses.get((nodea,nodeb),self.defaultFIFOClass) != self.defaultFIFOClass:
+           return(None)
+        if nodea.nbSamples != nodeb.nbSamples or not nodea.compatible(nodeb):
+           return(None)
+        return(nodeb.owner)
+
+    def fuseElementwiseFunctions(self):
+        """Replace the chains of elementwise functions (Unary and Binary
+        nodes) by FusedFunction nodes computing in place in the
+        output buffer. The intermediate FIFOs are removed"""
+        successors = {}
+        # Sorted to have reproducible chains and node names
+        for node in sorted(self._nodes,key=lambda x: x.nodeID):
+            nextNode = self._fusedSuccessor(node)
+            # When a function has several inputs coming from 
+            # other functions, only the first one is part of the chain
+            if not nextNode is None and not nextNode in successors.values():
+               successors[node] = nextNode
+        heads = [n for n in successors if not n in successors.values()]
+        for head in heads:
+            chain = [head]
+            while chain[-1] in successors:
+                chain.append(successors[chain[-1]])
+
+            fused = FusedFunction(chain)
+            for io,name in fused.fusedInputs:
+                if io.constantNode:
+                   del self._constantEdges[(io.constantNode,io)]
+                   self.connect(io.constantNode,fused[name])
+                else:
+                   nodea,nodeb = io.fifo[0]
+                   delay,settings = self._disconnect(nodea,nodeb)
+                   self._connectAgain(nodea,fused[name],delay,settings)
+
+            last = chain[-1]._outputs[chain[-1].outputNames[0]]
+            for nodea,nodeb in list(last.fifo):
+                delay,settings = self._disconnect(nodea,nodeb)
+                self._connectAgain(fused.o,nodeb,delay,settings)
+
+            # Intermediate FIFOs
+            for node in chain[:-1]:
+                output = node._outputs[node.outputNames[0]]
+                nodea,nodeb = output.fifo[0]
+                self._disconnect(nodea,nodeb)
+
+            for node in chain:
+                del self._nodes[node]
+                self._g.remove_node(node)
+            self._sortedNodes = None
+            self._sortedEdges = None
+
     def _isEvent(self,a):
         return isinstance(a,EventInput) or isinstance(a,EventOutput)
     
@@ -855,7 +1218,282 @@ class Graph():
         #print(f"  {f.src.owner.nodeName} -> {f.dst.owner.nodeName}")
         return(True)
 
-    def initializeFIFODescriptions(self,config,allFIFOs, fifoLengths,maxTime):
+    def _arenaAlignment(self,config,f):
+        """Alignment of a FIFO in the arena.
+        Without arenaAlignment, a FIFO is aligned on the size
+        of its datatype (largest power of 2 dividing it)"""
+        if config.arenaAlignment:
+            return(config.arenaAlignment)
+        b = f.theType.bytes
+        return(min(b & -b,16))
+
+    def allocateArena(self,config,allFIFOs,allBuffers):
+        """Place the FIFOs used as arrays at offsets in one arena buffer.
+
+        A FIFO is live during its _liveInterval. FIFOs live at the same 
+        time must use different parts of the arena.
+        The input and outputs of a Duplicate node that can share
+        memory are grouped at the same offset so that the copy can be
+        removed.
+        A custom buffer that can be shared is used by the FIFOs of same
+        size that are not live at the same time. Those FIFOs 
+        are not placed in the arena.
+
+        Return the buffer ID of the arena or -1 if there is no arena"""
+        def nbBytes(f):
+            return(f.theType.bytes * f.length)
+
+        def canShare(f):
+            if f.customBuffer is None:
+                return(True)
+            return(not f.customBuffer.assignedByNode and f.customBuffer.canBeShared)
+
+        def live(a,b):
+            return(a._liveInterval[0] <= b._liveInterval[1] and 
+                   b._liveInterval[0] <= a._liveInterval[1])
+
+        sharedFIFOs = [f for f in allFIFOs if f.isArray and canShare(f)]
+        if not sharedFIFOs:
+            return(-1)
+
+        # Groups of FIFOs using the same memory.
+        # A group is identified by its first FIFO
+        group = {f:f for f in sharedFIFOs}
+        members = {f:[f] for f in sharedFIFOs}
+        custom = {f:f.customBuffer for f in sharedFIFOs}
+        def root(f):
+            while group[f] != f:
+                f = group[f]
+            return(f)
+
+        def canMerge(ga,gb):
+            if not custom[ga] is None and not custom[gb] is None:
+                return(False)
+            # A custom buffer cannot be resized
+            if not custom[ga] is None or not custom[gb] is None:
+                if len(set(nbBytes(f) for f in members[ga] + members[gb])) != 1:
+                    return(False)
+            for a in members[ga]:
+                for b in members[gb]:
+                    if live(a,b) and self.no_exception_for_duplicate(config,a,b):
+                        return(False)
+            return(True)
+
+        def merge(ga,gb):
+            group[gb] = ga
+            members[ga] += members.pop(gb)
+            if custom[ga] is None:
+                custom[ga] = custom[gb]
+            del custom[gb]
+
+        for n in self._sortedNodes:
+            if isinstance(n,Duplicate):
+                dupFIFOs = [self._edgeToFIFO[n._inputs['i']._fifo]]
+                dupFIFOs += [self._edgeToFIFO[n._outputs[o]._fifo] for o in n._outputs]
+                dupFIFOs = [f for f in dupFIFOs if f in group]
+                for a in dupFIFOs:
+                    for b in dupFIFOs:
+                        ga,gb = root(a),root(b)
+                        if ga != gb and canMerge(ga,gb):
+                            merge(ga,gb)
+
+        # Two groups are conflicting when some of their FIFOs 
+        # are live at the same time.
+        # As for the interference graph, a FIFO read and a FIFO written 
+        # by the same node execution are live at the same time.
+        conflicts = {g:set() for g in members}
+        active = []
+        for f in sorted(sharedFIFOs,key=lambda x:(x._liveInterval[0],x.fifoID)):
+            start,_ = f._liveInterval
+            active = [a for a in active if a._liveInterval[1] >= start]
+            for a in active:
+                ga = root(a)
+                gf = root(f)
+                if ga != gf:
+                    conflicts[ga].add(gf)
+                    conflicts[gf].add(ga)
+            active.append(f)
+
+        def firstStart(g):
+            return(min(f._liveInterval[0] for f in members[g]))
+
+        # FIFOs of same size as a custom buffer use it
+        # when they are not conflicting with the FIFOs already using it
+        customGroups = sorted([g for g in members if not custom[g] is None],key=lambda g:g.fifoID)
+        for cg in customGroups:
+            size = nbBytes(cg)
+            others = [g for g in members if custom[g] is None]
+            for g in sorted(others,key=lambda g:(firstStart(g),g.fifoID)):
+                if all(nbBytes(f) == size for f in members[g]) and not g in conflicts[cg]:
+                    for other in conflicts[g]:
+                        conflicts[other].discard(g)
+                        conflicts[other].add(cg)
+                        conflicts[cg].add(other)
+                    del conflicts[g]
+                    merge(cg,g)
+
+        for cg in customGroups:
+            for f in members[cg]:
+                f.customBuffer = custom[cg]
+
+        arenaGroups = [g for g in members if custom[g] is None]
+        if not arenaGroups:
+            return(-1)
+
+        blocks = []
+        for g in arenaGroups:
+            size = max(nbBytes(f) for f in members[g])
+            align = max(self._arenaAlignment(config,f) for f in members[g])
+            blocks.append((g,size,align,firstStart(g)))
+        blocks.sort(key=lambda b:(-b[1],b[3],b[0].fifoID))
+
+        offsets,arenaSize = arena_layout([b[:3] for b in blocks],conflicts)
+
+        arenaID = 0
+        allBuffers[arenaID] = FifoBuffer(arenaID,CType(UINT8),arenaSize)
+        for g in arenaGroups:
+            for f in members[g]:
+                f.sharedNB = arenaID
+                f.bufferOffset = offsets[g]
+        return(arenaID)
+
+    def asyncConflicts(self,config,allFIFOs,schedule):
+        """FIFOs that may contain samples at the same time in
+        asynchronous mode.
+
+        The generated scheduler runs the nodes in the order of the 
+        schedule again and again. The analysis assumes that:
+        * a node reads and writes the number of samples declared on its IOs
+        * a node runs when there are enough samples in its inputs and
+          enough free space in its outputs. A node with asyncMaySkip
+          may also skip this execution.
+        All the FIFO states that can be reached with those rules are
+        explored. The FIFOs that are not empty in a state,
+        and the FIFOs used by the node executed from this state, 
+        are conflicting.
+
+        Return a list of bitmasks (conflicting FIFOs for each FIFO) or None
+        when there are more than config.asyncMemoryMaxStates states."""
+        nbFIFOs = len(allFIFOs)
+        capacity = [0] * nbFIFOs
+        for f in allFIFOs:
+            capacity[f.fifoID] = f.length
+        nbNodes = len(self._sortedNodes)
+
+        # For each node : (inputs, outputs, mask of used FIFOs, cycle period,
+        # may skip).
+        # inputs and outputs are lists of (FIFO ID, samples per 
+        # position in the node cycle)
+        def rates(io,period):
+            if isinstance(io.nbSamples,int):
+                return([io.nbSamples] * period)
+            return([io.nbSamples[p % len(io.nbSamples)] for p in range(period)])
+
+        nodeDesc = []
+        for node in self._sortedNodes:
+            inputs,outputs = self._nodeFIFOs[node.sortedNodeID]
+            period = node.cyclePeriod
+            mask = 0
+            for pos,_ in inputs + outputs:
+                mask |= 1 << pos
+            nodeDesc.append(([(pos,rates(io,period)) for pos,io in inputs],
+                             [(pos,rates(io,period)) for pos,io in outputs],
+                             mask,period,node.asyncMaySkip))
+
+        conflicts = [0] * nbFIFOs
+        seenMasks = set()
+        def record(mask):
+            if mask in seenMasks:
+                return
+            seenMasks.add(mask)
+            m = mask
+            while m:
+                low = m & -m
+                conflicts[low.bit_length() - 1] |= mask
+                m ^= low
+
+        # A state is the position in the schedule, the number of
+        # samples in each FIFO and the position in the cycle of each node
+        start = (0,tuple(self.getDelay(e) for e in self._sortedEdges),(0,) * nbNodes)
+        visited = {start}
+        toVisit = deque([start])
+        while toVisit:
+            k,b,cycles = toVisit.popleft()
+            nodeID = schedule[k]
+            inputs,outputs,used,period,maySkip = nodeDesc[nodeID]
+            p = cycles[nodeID]
+            live = 0
+            for e,x in enumerate(b):
+                if x > 0:
+                    live |= 1 << e
+            nextK = (k + 1) % len(schedule)
+
+            canRun = all(b[e] >= r[p] for e,r in inputs) and \
+                     all(b[e] + r[p] <= capacity[e] for e,r in outputs)
+            successors = []
+            if canRun:
+                record(live | used)
+                newB = list(b)
+                for e,r in inputs:
+                    newB[e] -= r[p]
+                for e,r in outputs:
+                    newB[e] += r[p]
+                newCycles = list(cycles)
+                newCycles[nodeID] = (p + 1) % period
+                successors.append((nextK,tuple(newB),tuple(newCycles)))
+            else:
+                record(live)
+            if not canRun or maySkip:
+                successors.append((nextK,b,cycles))
+
+            for state in successors:
+                if not state in visited:
+                    if len(visited) >= config.asyncMemoryMaxStates:
+                        return(None)
+                    visited.add(state)
+                    toVisit.append(state)
+        return(conflicts)
+
+    def allocateAsyncArena(self,config,allFIFOs,allBuffers,schedule):
+        """Place the FIFOs in one arena buffer in asynchronous mode
+        when they can never contain samples at the same time 
+        (see asyncConflicts).
+        FIFOs with a custom buffer are not placed in the arena.
+
+        Return the buffer ID of the arena or -1 if there is no arena"""
+        sharedFIFOs = [f for f in allFIFOs if f.customBuffer is None]
+        if len(sharedFIFOs) < 2:
+            return(-1)
+
+        masks = self.asyncConflicts(config,allFIFOs,schedule)
+        if masks is None:
+            print("Asynchronous memory optimization has been disabled. Too many FIFO states to explore")
+            return(-1)
+
+        def nbBytes(f):
+            return(int(f.theType.bytes * f.length))
+
+        conflicts = {}
+        for f in sharedFIFOs:
+            conflicts[f] = set(o for o in sharedFIFOs 
+                               if o != f and (masks[f.fifoID] >> o.fifoID) & 1)
+
+        blocks = [(f,nbBytes(f),self._arenaAlignment(config,f)) for f in sharedFIFOs]
+        blocks.sort(key=lambda b:(-b[1],b[0].fifoID))
+        offsets,arenaSize = arena_layout(blocks,conflicts)
+
+        # No FIFO is sharing memory
+        if arenaSize >= sum(b[1] for b in blocks):
+            return(-1)
+
+        arenaID = 0
+        allBuffers[arenaID] = FifoBuffer(arenaID,CType(UINT8),arenaSize)
+        for f in sharedFIFOs:
+            f.sharedNB = arenaID
+            f.bufferOffset = offsets[f]
+        return(arenaID)
+
+    def initializeFIFODescriptions(self,config,allFIFOs, fifoLengths,maxTime,schedule=None):
         """Initialize FIFOs datastructure""" 
 
         # Before we start we check that no custom buffer is used more than once
@@ -939,14 +1577,31 @@ class Graph():
         bufferID=-1
         allBuffers={}
 
-        # Compute a graph describing when FIFOs are used at the same time
-        # Then use graph coloring to allocate buffer to those FIFOs.
-        # Then size the buffer based on the longest FIFO using it
         # Memory optimizations are disabled by the asynchronous mode
         # because the execution is no more periodic.
         # So anything deduced from a synchronous period
         # can't be used.
-        if config.memoryOptimization and not config.asynchronous and not config.fullyAsynchronous:
+        memoryOptimization = config.memoryOptimization and not config.asynchronous and not config.fullyAsynchronous
+        if memoryOptimization and not config.memoryAllocator in ["arena","coloring"]:
+            raise UnknownMemoryAllocator(config.memoryAllocator)
+
+        # Place the FIFOs used as arrays in an arena using their
+        # live intervals
+        if memoryOptimization and config.memoryAllocator == "arena":
+            bufferID = self.allocateArena(config,allFIFOs,allBuffers)
+
+        # In asynchronous mode, the FIFOs that can never contain
+        # samples at the same time are placed in an arena
+        asyncMemoryOptimization = config.asyncMemoryOptimization and \
+             (config.asynchronous or config.fullyAsynchronous) and \
+             not schedule is None
+        if asyncMemoryOptimization:
+            bufferID = self.allocateAsyncArena(config,allFIFOs,allBuffers,schedule)
+
+        # Compute a graph describing when FIFOs are used at the same time
+        # Then use graph coloring to allocate buffer to those FIFOs.
+        # Then size the buffer based on the longest FIFO using it
+        if memoryOptimization and config.memoryAllocator == "coloring":
             G = nx.Graph()
 
             for fifo in allFIFOs: 
@@ -1132,7 +1787,8 @@ class Graph():
         bufferID = bufferID + 1
         for fifo in allFIFOs:
             # Use shared buffer if memory optimization
-            if fifo.isArray and (config.memoryOptimization and not config.asynchronous and not config.fullyAsynchronous):
+            if (fifo.isArray and memoryOptimization) or \
+               (asyncMemoryOptimization and fifo.sharedNB >= 0):
                 # If fifo is not using a custom buffer then it uses
                 # a buffer allocated by CMSIS-Stream
                 if fifo.customBuffer is None:
@@ -1172,13 +1828,13 @@ class Graph():
                 if isinstance(n,Duplicate):
                     inputEdge = n._inputs['i']._fifo
                     inputFIFO = self._edgeToFIFO[inputEdge]
-                    inputBuf = inputFIFO.buffer
+                    inputBuf = inputFIFO.bufferLocation
     
                     list_to_process = list(n._outputs).copy()
                     for o in n._outputs:
                         outputEdge = n._outputs[o]._fifo
                         outputFIFO = self._edgeToFIFO[outputEdge]
-                        outputBuf = outputFIFO.buffer
+                        outputBuf = outputFIFO.bufferLocation
                         if outputBuf == inputBuf:
                             outputFIFO._skip_for_duplicate = True
                             list_to_process.remove(o)
@@ -1189,7 +1845,7 @@ class Graph():
                     for a in list_to_process:
                         outputEdge = n._outputs[a]._fifo
                         outputFIFO = self._edgeToFIFO[outputEdge]
-                        outputBuf = outputFIFO.buffer
+                        outputBuf = outputFIFO.bufferLocation
                         if outputBuf in buf_groups:
                             buf_groups[outputBuf].append(outputFIFO)
                         else:
@@ -1281,6 +1937,23 @@ class Graph():
             node.sortedNodeID = nID
             nID = nID + 1
 
+        # Position of the FIFOs connected to each node
+        # so that the schedule computation only updates those FIFOs
+        edgeIndex = {}
+        for pos,edge in enumerate(self._sortedEdges):
+            edgeIndex.setdefault(edge,pos)
+        self._nodeFIFOs = []
+        # Nodes using each FIFO
+        self._fifoNodes = [[] for _ in self._sortedEdges]
+        for node in self._sortedNodes:
+            inputs = [(edgeIndex[node._inputs[i]._fifo],node._inputs[i]) 
+                      for i in node._inputs if len(node._inputs[i]._fifo)>0]
+            outputs = [(edgeIndex[node._outputs[o]._fifo],node._outputs[o]) 
+                      for o in node._outputs if len(node._outputs[o]._fifo)>0]
+            self._nodeFIFOs.append((inputs,outputs))
+            for pos,_ in inputs + outputs:
+                self._fifoNodes[pos].append(node.sortedNodeID)
+
         for edge in self._sortedEdges: 
             na,nb = edge
             currentRow=[0] * len(self._sortedNodes) 
@@ -1302,9 +1975,60 @@ class Graph():
 
         return(np.array(rows))
 
+    def _propagateRepetitions(self,m):
+        """Repetition vector computed by propagating the balance equations
+        along the edges of the connected graph. 
+        Return None when the topology matrix has an unusual row 
+        (self loop, zero rate) : the null space is then computed with sympy.
+        For a connected graph, the null space has a dimension of 0 or 1 so
+        the result is the same as with sympy."""
+        if (m.ndim != 2) or (m.shape[0] == 0):
+            return(None)
+        nbNodes = m.shape[1]
+        rows = []
+        neighbors = [[] for _ in range(nbNodes)]
+        for row in m:
+            nz = np.nonzero(row)[0]
+            if len(nz) != 2:
+                return(None)
+            a,b = int(nz[0]),int(nz[1])
+            if row[a] < 0:
+                a,b = b,a
+            produced = int(row[a])
+            consumed = -int(row[b])
+            if produced <= 0 or consumed <= 0:
+                return(None)
+            rows.append((a,b,produced,consumed))
+            neighbors[a].append((b,Fraction(produced,consumed)))
+            neighbors[b].append((a,Fraction(consumed,produced)))
+
+        q = [None] * nbNodes
+        q[0] = Fraction(1)
+        toVisit = [0]
+        while toVisit:
+            a = toVisit.pop()
+            for b,ratio in neighbors[a]:
+                if q[b] is None:
+                    q[b] = q[a] * ratio
+                    toVisit.append(b)
+        if any(x is None for x in q):
+            return(None)
+
+        for a,b,produced,consumed in rows:
+            if q[a] * produced != q[b] * consumed:
+               raise NotSchedulableError
+
+        ppcm = math.lcm(*[x.denominator for x in q])
+        intValues = [int(x * ppcm) for x in q]
+        gcd = math.gcd(*intValues)
+        return(np.array([x // gcd for x in intValues],dtype=int))
+
     def nullVector(self,m):
         #print("Null vector")
         # m is topology matrix computed with toplogyMatrix
+        res = self._propagateRepetitions(m)
+        if res is not None:
+            return(res)
         r=Matrix(m).nullspace()
         if len(r) != 1:
            raise NotSchedulableError
@@ -1328,8 +2052,9 @@ class Graph():
         """Initial FIFO state taking into account delays"""
         return(np.array([self.getDelay(x) for x in self.edges]))
 
-    def evolutionVectorForNode(self,nodeID,test=True):
-        """Return the evolution vector corresponding to a selected node"""
+    def fifoChangesForNode(self,nodeID,test=True):
+        """Return the FIFO changes (list of FIFO position, change) 
+        corresponding to the execution of a selected node"""
         # For a simple static scheduling, the topology matrix T
         # is enough. If we know which node is executed, we have
         # a node vector V where there is a 1 at the position of the
@@ -1349,58 +2074,81 @@ class Graph():
         # done.
         # So this function is not just returning the node vector
         # and letting the main function updating the fifos.
-        # This function is returning the new fifo state
-        # Node vector would have been
-        # v = np.zeros(len(self._sortedNodes))
-        # v[nodeID] = 1 
-        # for cyclo static scheduling
-        n = self._sortedNodes[nodeID]
-        #print(n)
-        v = np.zeros(len(self._sortedEdges))
+        # This function is returning the change of the fifo state.
+        # Only the FIFOs connected to the node are changed
+        # so the change is sparse.
+        inputs,outputs = self._nodeFIFOs[nodeID]
+        changes = {}
 
         # In test mode we are testing several nodes
         # to find the best one to schedule.
         # So we should not advance the cycle
         # of the IOs
-        for i in n._inputs:
-            io = n._inputs[i]
-            edge = io._fifo
-            # If 0, it is a connection to a constant node
-            # so there is no FIFO
-            if len(edge)>0:
-               pos = self._sortedEdges.index(edge)
-               v[pos] = -io.cycleValue
-               if not test:
-                  io.advanceCycle()
-            
-
-        for o in n._outputs:
-            io = n._outputs[o]
-            edge = io._fifo
-            # If 0 it is a connection to a constant edge
-            # so there is no FIFO
-            if len(edge)>0:
-               pos = self._sortedEdges.index(edge)
-               v[pos] = io.cycleValue
-               if not test:
-                  io.advanceCycle()
-            
+        # Connections to a constant node have no FIFO and are
+        # not in the lists
+        for pos,io in inputs:
+            changes[pos] = -io.cycleValue
+            if not test:
+               io.advanceCycle()
+
+        for pos,io in outputs:
+            changes[pos] = io.cycleValue
+            if not test:
+               io.advanceCycle()
+
+        return(list(changes.items()))
+
+    def _evaluateCandidate(self,occupancy,nodeID,bMax=None):
+        """FIFO changes of a candidate node : feasibility, changed FIFOs
+        and maximum occupancy of those FIFOs.
+        It only depends on the FIFOs connected to the node and on the cycle
+        position of the node IOs so it is recomputed only when
+        the node or one of its neighbors is executed"""
+        newB = occupancy.newValues(self.fifoChangesForNode(nodeID))
+        # Check that there is no FIFO underflow (or overflow of bMax)
+        # The other FIFOs were checked when they were changed
+        if bMax is None:
+            feasible = all(x >= 0 for _,x in newB)
+        else:
+            feasible = all((x >= 0) and (x <= bMax[e]) for e,x in newB)
+        touched = set(e for e,_ in newB)
+        return(feasible,touched,occupancy.localMax(newB))
+
+    def _reuseDistance(self,nodeID,lastWrite,produced):
+        """Number of bytes written to FIFOs since the inputs of the node 
+        were written. A node without inputs has an infinite distance"""
+        inputs,_ = self._nodeFIFOs[nodeID]
+        if not inputs:
+            return(math.inf)
+        return(produced - min(lastWrite[pos] for pos,_ in inputs))
+
+    def _invalidateCandidates(self,candidates,nodeID,fifoChange):
+        candidates[nodeID] = None
+        for e,_ in fifoChange:
+            for other in self._fifoNodes[e]:
+                candidates[other] = None
 
-        #print(v)
+    def evolutionVectorForNode(self,nodeID,test=True):
+        """Return the evolution vector corresponding to a selected node"""
+        v = np.zeros(len(self._sortedEdges))
+        for pos,change in self.fifoChangesForNode(nodeID,test=test):
+            v[pos] = change
         return(v)
 
-    def computeTopologicalOrderSchedule(self,normV,allFIFOs,initB,bMax,initN,config):
-        b = np.array(initB)
-        n = np.array(initN)
+    def computeTopologicalOrderSchedule(self,normV,allFIFOs,initB,bMax,initN,config,analyze=True):
+        occupancy = FIFOOccupancy(initB,normV)
+        candidates = [None] * len(self._sortedNodes)
+        n = [int(x) for x in initN]
+        remaining = sum(n)
+        bMax = [float(x) for x in bMax]
 
 
         schedule=[]
 
-        zeroVec = np.zeros(len(self._sortedNodes))
         evolutionTime = 0
         #print(self._sortedNodes)
         # While there are remaining node periods to schedule
-        while (n != zeroVec).any():
+        while remaining > 0:
             #print("")
             #print(n)
             # Look for the best node to schedule
@@ -1420,17 +2168,20 @@ class Graph():
                        # Evolution vector for static scheduling
                        # v = self.evolutionVectorForNode(nodeID)
                        # for cyclo static we need the new fifo state
-                       newB = self.evolutionVectorForNode(node.sortedNodeID) + b
-                       # New fifos size after this evolution
+                       # Only the FIFOs connected to the node are changed
                        # For static scheduling, fifo update would have been
                        # newB = np.dot(t,v) + b
-                       #print(newB)
+                       candidate = candidates[node.sortedNodeID]
+                       if candidate is None:
+                          candidate = self._evaluateCandidate(occupancy,node.sortedNodeID,bMax)
+                          candidates[node.sortedNodeID] = candidate
+                       feasible,touched,localMax = candidate
                 
                        # Check that there is no FIFO underflow or overfflow:
-                       if np.all(newB >= 0) and np.all(newB <= bMax):
+                       if feasible:
                           # Total FIFO size for this possible execution
                           # We normalize to get the occupancy number as explained above
-                          theMin = (1.0*np.array(newB) / normV).max()
+                          theMin = occupancy.maxOccupancy(touched,localMax)
                           # If this possible evolution is giving smaller FIFO size
                           # (measured in occupancy number) then it is selected
                           if theMin < minVal:
@@ -1471,29 +2222,432 @@ class Graph():
     
             # Implementation for cyclo static scheduling
             #print("selected")
-            fifoChange = self.evolutionVectorForNode(selected,test=False)
-            b = fifoChange + b
-            # For cyclo static, we create an evolution vector 
-            # which contains a 1
+            fifoChange = self.fifoChangesForNode(selected,test=False)
+            occupancy.apply(fifoChange)
+            self._invalidateCandidates(candidates,selected,fifoChange)
+            # For cyclo static, the null vector is decreased
             # at a node position only if this node has executed
             # its period.
-            # Otherwise the null vector is not decreased
-            v = np.zeros(len(self._sortedNodes))
-            v[selected] = self._sortedNodes[selected].executeNode() 
-            n = n - v
+            executed = self._sortedNodes[selected].executeNode() 
+            n[selected] = n[selected] - executed
+            remaining = remaining - executed
     
     
             if config.displayFIFOSizes:
-               print(b)
+               print(np.array(occupancy.b))
                 
             schedule.append(selected)
     
             # Analyze FIFOs to know if a FIFOs write is
             # followed immediately by a FIFO read of same size
-            analyzeStep(fifoChange,allFIFOs,evolutionTime)
+            if analyze:
+               analyzeSparseStep(fifoChange,allFIFOs,evolutionTime)
             evolutionTime = evolutionTime + 1
         return(schedule)
 
+    def computeLocalitySchedule(self,normV,allFIFOs,initB,bMax,initN,config):
+        """Reorder the schedule so that the data stays in the cache.
+        
+        FIFO sizes are bounded by the ones of the first schedule so the
+        memory is not changed.
+        The working set is estimated with the bytes contained in the FIFOs.
+        The selected node is, in order of priority: 
+        * a node that is not increasing the working set 
+        * the closest to a sink
+        * the one decreasing the working set the most
+        * the one reading the most recently written data (the 
+          reuse distance is the number of bytes written since)
+        * the one giving the smallest FIFO occupancy"""
+        occupancy = FIFOOccupancy(initB,normV)
+        candidates = [None] * len(self._sortedNodes)
+        n = [int(x) for x in initN]
+        remaining = sum(n)
+        bMax = [float(x) for x in bMax]
+
+        fifoBytes = [src.theType.bytes for src,_ in self._sortedEdges]
+        # Bytes written to the FIFOs since the start of the schedule
+        # and value of this counter when each FIFO was last written
+        produced = 0
+        lastWrite = [0] * len(self._sortedEdges)
+
+        # Distance to the sinks. It is 0 for all nodes when the
+        # graph has some loops
+        sinkDistance = [0] * len(self._sortedNodes)
+        for distance,layer in enumerate(self._topologicalSort):
+            for node in layer:
+                sinkDistance[node.sortedNodeID] = distance
+
+        schedule=[]
+
+        evolutionTime = 0
+        while remaining > 0:
+            selected = -1
+            minVal = None
+            for node in self._sortedNodes:
+                nodeID = node.sortedNodeID
+                if n[nodeID] > 0:
+                   candidate = candidates[nodeID]
+                   if candidate is None:
+                      candidate = self._evaluateCandidate(occupancy,nodeID,bMax)
+                      # Change of the working set when the node is executed
+                      workingSet = sum(change * fifoBytes[e] for e,change in self.fifoChangesForNode(nodeID))
+                      candidate = candidate + (workingSet,)
+                      candidates[nodeID] = candidate
+                   feasible,touched,localMax,workingSet = candidate
+
+                   if feasible:
+                      theMin = (workingSet > 0,
+                                sinkDistance[nodeID],
+                                workingSet,
+                                self._reuseDistance(nodeID,lastWrite,produced),
+                                occupancy.maxOccupancy(touched,localMax))
+                      if minVal is None or theMin <= minVal:
+                         minVal = theMin
+                         selected = nodeID 
+
+            if selected < 0:
+               raise DeadlockError
+
+            fifoChange = self.fifoChangesForNode(selected,test=False)
+            occupancy.apply(fifoChange)
+            self._invalidateCandidates(candidates,selected,fifoChange)
+            executed = self._sortedNodes[selected].executeNode() 
+            n[selected] = n[selected] - executed
+            remaining = remaining - executed
+
+            if config.displayFIFOSizes:
+               print(np.array(occupancy.b))
+
+            for e,change in fifoChange:
+                if change > 0:
+                   produced = produced + change * fifoBytes[e]
+            for e,change in fifoChange:
+                if change > 0:
+                   lastWrite[e] = produced
+            schedule.append(selected)
+
+            # Analyze FIFOs to know if a FIFOs write is
+            # followed immediately by a FIFO read of same size
+            analyzeSparseStep(fifoChange,allFIFOs,evolutionTime)
+            evolutionTime = evolutionTime + 1
+        return(schedule)
+
+    def computeLatencySchedule(self,normV,allFIFOs,initB,bMax,initN,config,schedule):
+        """Schedule reducing the worst latency between the sources and 
+        the sinks.
+
+        The candidates are the sink prioritization schedule (when the 
+        graph has no loops), the first schedule and a demand driven
+        schedule. The selected one has the smallest worst latency
+        (estimated time and then number of node executions).
+        The FIFOs are not analyzed: the selected schedule
+        must be replayed"""
+        candidates = []
+        if len(self._topologicalSort)>0:
+           candidates.append(self.computeTopologicalOrderSchedule(normV,allFIFOs,initB,bMax,initN,config,analyze=False))
+        candidates.append(schedule)
+        candidates.append(self.computeDemandDrivenSchedule(initB,initN))
+
+        def worstLatencies(s):
+            return(sorted(((time,steps) for steps,time in self.sourceSinkLatency(s).values()),
+                          reverse=True))
+        # The first candidates are preferred when the latencies are 
+        # the same since their FIFOs are smaller
+        return(min(candidates,key=worstLatencies))
+
+    def computeDemandDrivenSchedule(self,initB,initN):
+        """A node is executed only when its samples are needed by a 
+        consumer that is missing samples. 
+        So the sources run as late as possible and the samples
+        go to the sinks without waiting in the FIFOs.
+        The sinks are pulled in turn: the next one is the sink having
+        done the smallest fraction of its executions.
+        FIFO sizes are not bounded by the ones of the first schedule"""
+        b = [float(x) for x in initB]
+        n = [int(initN[node.sortedNodeID]) * node.cyclePeriod for node in self._sortedNodes]
+        total = list(n)
+        producer = [src.owner.sortedNodeID for src,_ in self._sortedEdges]
+        sinks = [node.sortedNodeID for node in self._sortedNodes 
+                 if len(self._nodeFIFOs[node.sortedNodeID][1]) == 0]
+
+        schedule=[]
+
+        def pull(target):
+            # Stack of the nodes waiting for samples
+            waiting = [target]
+            while waiting:
+                nodeID = waiting[-1]
+                missing = [e for e,change in self.fifoChangesForNode(nodeID) 
+                           if b[e] + change < 0]
+                if missing:
+                   p = producer[missing[0]]
+                   # A loop without enough delay 
+                   if p in waiting or n[p] == 0:
+                      raise DeadlockError
+                   waiting.append(p)
+                   continue
+                for e,change in self.fifoChangesForNode(nodeID,test=False):
+                    b[e] = b[e] + change
+                self._sortedNodes[nodeID].executeNode()
+                n[nodeID] = n[nodeID] - 1
+                schedule.append(nodeID)
+                waiting.pop()
+
+        while any(n[k] > 0 for k in sinks):
+            target = min((k for k in sinks if n[k] > 0),
+                         key=lambda k: (total[k] - n[k]) / total[k])
+            pull(target)
+
+        # Nodes not needed by a sink during this iteration 
+        # (because of the delays) must still run their executions
+        for node in self._sortedNodes:
+            while n[node.sortedNodeID] > 0:
+                pull(node.sortedNodeID)
+
+        return(schedule)
+
+    def replaySchedule(self,schedule,allFIFOs,initB,config):
+        """Run a schedule computed without analyzing the FIFOs.
+        Return the max FIFO sizes"""
+        b = [float(x) for x in initB]
+        bMax = list(b)
+        for evolutionTime,nodeID in enumerate(schedule):
+            fifoChange = self.fifoChangesForNode(nodeID,test=False)
+            for e,change in fifoChange:
+                b[e] = b[e] + change
+                bMax[e] = max(b[e],bMax[e])
+            self._sortedNodes[nodeID].executeNode()
+
+            if config.displayFIFOSizes:
+               print(np.array(b))
+
+            # Analyze FIFOs to know if a FIFOs write is
+            # followed immediately by a FIFO read of same size
+            analyzeSparseStep(fifoChange,allFIFOs,evolutionTime)
+        return(bMax)
+
+    def sourceSinkLatency(self,schedule,nbIterations=4):
+        """Worst latency between each source and each sink connected to it.
+
+        The schedule is run several times and the samples are tracked
+        through the FIFOs. The samples produced by a node come from
+        the oldest execution of each source that produced the samples 
+        it has read during this execution.
+        The latency is measured from the start of the source execution
+        to the end of the sink execution after the first iteration 
+        (so that the initial samples of the delays are consumed).
+
+        Return a dictionary (source, sink) -> (number of node executions,
+        estimated time) where the estimated time is the sum of the
+        node costs"""
+        # Start time of each execution
+        start = [0]
+        for _ in range(nbIterations):
+            for nodeID in schedule:
+                start.append(start[-1] + self._sortedNodes[nodeID].cost)
+
+        # Chunks of samples in each FIFO: 
+        # [number of samples, source nodeID -> oldest execution]
+        chunks = [deque() for _ in self._sortedEdges]
+        for e,edge in enumerate(self._sortedEdges):
+            if self.getDelay(edge) > 0:
+               chunks[e].append([self.getDelay(edge),{}])
+
+        latency = {}
+        t = 0
+        for iteration in range(nbIterations):
+            for nodeID in schedule:
+                inputs,outputs = self._nodeFIFOs[nodeID]
+                consumed = {}
+                changes = self.fifoChangesForNode(nodeID,test=False)
+                for e,change in changes:
+                    nb = -change
+                    while nb > 0:
+                        chunk = chunks[e][0]
+                        for src,origin in chunk[1].items():
+                            consumed[src] = min(origin,consumed.get(src,origin))
+                        used = min(nb,chunk[0])
+                        chunk[0] = chunk[0] - used
+                        nb = nb - used
+                        if chunk[0] == 0:
+                           chunks[e].popleft()
+                if not inputs:
+                   consumed = {nodeID:t}
+                for e,change in changes:
+                    if change > 0:
+                       chunks[e].append([change,consumed])
+                if not outputs and iteration > 0:
+                   for src,origin in consumed.items():
+                       steps = t - origin + 1
+                       time = start[t+1] - start[origin]
+                       old = latency.get((src,nodeID),(0,0))
+                       latency[(src,nodeID)] = (max(steps,old[0]),max(time,old[1]))
+                t = t + 1
+
+        return({(self._sortedNodes[src],self._sortedNodes[sink]):v 
+                for (src,sink),v in latency.items()})
+
+    def applyNodeCosts(self,costs):
+        """Set the cost of the nodes from measured costs.
+
+        costs is the path of a JSON file written by the node profiler
+        of the POSIX runtime (StreamNodeProfiler::writeJSON) or the
+        corresponding dictionary:
+        {"nodes":[{"id":0,"mean_ns":120,...},...]}
+
+        The ids are the node IDs of the scheduler generated for the
+        same graph (the ID of the CG_BEFORE_NODE_EXECUTION hook).
+        An entry can use the "name" of the node instead of its id and
+        "cost" instead of "mean_ns".
+        The nodes without an entry keep their cost"""
+        if isinstance(costs,str):
+           with open(costs, 'r', encoding='utf-8') as f:
+                costs = json.load(f)
+        byName = {node.nodeName:node for node in self._sortedNodes}
+        for entry in costs.get("nodes",[]):
+            if "name" in entry:
+               if not entry["name"] in byName:
+                  raise NodeCostError(f"unknown node {entry['name']}")
+               node = byName[entry["name"]]
+            else:
+               nodeID = entry.get("id",-1)
+               if nodeID < 0 or nodeID >= len(self._sortedNodes):
+                  raise NodeCostError(f"unknown node id {nodeID}")
+               node = self._sortedNodes[nodeID]
+            if "cost" in entry:
+               node.cost = entry["cost"]
+            elif "mean_ns" in entry:
+               node.cost = entry["mean_ns"]
+            else:
+               raise NodeCostError(f"no cost for node {node.nodeName}")
+
+    def iterationTime(self,schedule):
+        """Estimated time of one iteration of the schedule on one
+        thread: the sum of the node costs"""
+        return(sum(self._sortedNodes[nodeID].cost for nodeID in schedule))
+
+    def executionDependencies(self,schedule):
+        """Dependencies between the node executions of one iteration 
+        of the schedule. Return a list giving for each step of the
+        schedule the steps it depends on: the previous execution of 
+        the same node and the executions that produced the samples
+        it reads (the initial samples of the delays have no producer)"""
+        # Chunks of samples in each FIFO: [number of samples, step]
+        chunks = [deque() for _ in self._sortedEdges]
+        for e,edge in enumerate(self._sortedEdges):
+            if self.getDelay(edge) > 0:
+               chunks[e].append([self.getDelay(edge),None])
+
+        last = {}
+        deps = []
+        for t,nodeID in enumerate(schedule):
+            d = set()
+            if nodeID in last:
+               d.add(last[nodeID])
+            changes = self.fifoChangesForNode(nodeID,test=False)
+            for e,change in changes:
+                nb = -change
+                while nb > 0:
+                    chunk = chunks[e][0]
+                    if chunk[1] is not None:
+                       d.add(chunk[1])
+                    used = min(nb,chunk[0])
+                    chunk[0] = chunk[0] - used
+                    nb = nb - used
+                    if chunk[0] == 0:
+                       chunks[e].popleft()
+            for e,change in changes:
+                if change > 0:
+                   chunks[e].append([change,t])
+            self._sortedNodes[nodeID].executeNode()
+            last[nodeID] = t
+            deps.append(sorted(d))
+        return(deps)
+
+    def partitionSchedule(self,schedule,nbThreads):
+        """Distribute the nodes of the schedule on nbThreads threads
+        using the node costs.
+
+        The nodes are assigned to the threads by decreasing cost per 
+        iteration, each one to the least loaded thread. A node stays 
+        on one thread since it has a state.
+        The executions are then ordered by critical path: the longest
+        chain of dependent executions to the end of the iteration.
+        An execution starts when its thread is free and the executions
+        it depends on are finished.
+
+        Return (threads, time) where threads is the list of the node IDs
+        executed by each thread in order and time is the estimated
+        time of one iteration"""
+        deps = self.executionDependencies(schedule)
+        cost = [self._sortedNodes[nodeID].cost for nodeID in schedule]
+        successors = [[] for _ in schedule]
+        for t,d in enumerate(deps):
+            for p in d:
+                successors[p].append(t)
+
+        # The dependencies are earlier steps of the schedule
+        # so the reversed schedule is a topological order
+        criticalPath = [0] * len(schedule)
+        for t in reversed(range(len(schedule))):
+            criticalPath[t] = cost[t] + max((criticalPath[x] for x in successors[t]),default=0)
+
+        load = {}
+        for t,nodeID in enumerate(schedule):
+            load[nodeID] = load.get(nodeID,0) + cost[t]
+        threadLoad = [0] * nbThreads
+        thread = {}
+        for nodeID in sorted(load,key=lambda x:(-load[x],x)):
+            k = min(range(nbThreads),key=lambda x:threadLoad[x])
+            thread[nodeID] = k
+            threadLoad[k] = threadLoad[k] + load[nodeID]
+
+        # Decreasing critical path is a topological order
+        # (steps with the same critical path are kept in the
+        # schedule order)
+        order = sorted(range(len(schedule)),key=lambda t:(-criticalPath[t],t))
+        free = [0] * nbThreads
+        finish = [0] * len(schedule)
+        threads = [[] for _ in range(nbThreads)]
+        for t in order:
+            k = thread[schedule[t]]
+            start = max([free[k]] + [finish[p] for p in deps[t]])
+            finish[t] = start + cost[t]
+            free[k] = finish[t]
+            threads[k].append(schedule[t])
+
+        return(threads,max(free))
+
+    def computeSingleAppearanceSchedule(self,allFIFOs,initB,initN,config):
+        """Each node runs all its executions in a row, in the topological
+        order from the sources. The FIFOs must be big enough for
+        a full period of their producer so the max FIFO sizes
+        are recomputed and returned with the schedule"""
+        b = [float(x) for x in initB]
+        bMax = list(b)
+        schedule=[]
+        evolutionTime = 0
+        for layer in self._topologicalSort:
+            for node in layer:
+                nodeID = node.sortedNodeID
+                for _ in range(int(initN[nodeID]) * node.cyclePeriod):
+                    fifoChange = self.fifoChangesForNode(nodeID,test=False)
+                    for e,change in fifoChange:
+                        b[e] = b[e] + change
+                        bMax[e] = max(b[e],bMax[e])
+                    node.executeNode()
+
+                    if config.displayFIFOSizes:
+                       print(np.array(b))
+
+                    schedule.append(nodeID)
+
+                    # Analyze FIFOs to know if a FIFOs write is
+                    # followed immediately by a FIFO read of same size
+                    analyzeSparseStep(fifoChange,allFIFOs,evolutionTime)
+                    evolutionTime = evolutionTime + 1
+        return(schedule,bMax)
+
     def _computeFullyAsynchronousSchedule(self,config,oldSelectorsInit):
         # First we must rewrite the graph and insert duplication
         # nodes when an ouput is connected to several inputs.
@@ -1527,7 +2681,7 @@ class Graph():
 
         # In fully asynchronous the fifoLength array and maxTime are
         # not used
-        allBuffers=self.initializeFIFODescriptions(config,allFIFOs,[],0)
+        allBuffers=self.initializeFIFODescriptions(config,allFIFOs,[],0,schedule)
         self._allFIFOs = allFIFOs 
         self._allBuffers = allBuffers
 
@@ -1549,6 +2703,9 @@ class Graph():
             self._allBuffers=[]
 
             return(Schedule(self,schedule,config,oldSelectorsInit))
+
+        if config.fuseElementwiseFunctions:
+            self.fuseElementwiseFunctions()
             
         if config.fullyAsynchronous:
             return(self._computeFullyAsynchronousSchedule(config,oldSelectorsInit))
@@ -1561,12 +2718,34 @@ class Graph():
         networkMatrix = self.topologyMatrix()
         #print(networkMatrix)
 
-        if config.sinkPriority:
+        if config.nodeCosts is not None:
+           self.applyNodeCosts(config.nodeCosts)
+
+        if not config.scheduleObjective in ["occupancy","locality","singleAppearance","latency"]:
+            raise UnknownScheduleObjective(config.scheduleObjective)
+        # The locality, single appearance and latency objectives replace 
+        # the sink prioritization with their own second pass
+        isOccupancy = config.scheduleObjective == "occupancy"
+        mustDoLocality = config.scheduleObjective == "locality"
+        mustDoLatency = config.scheduleObjective == "latency"
+        mustDoSingleAppearance = False
+
+        if config.scheduleObjective == "singleAppearance":
+           self.computeSourceTopologicalSortOfNodes()
+           # Weak edges are ignored by the topological sort
+           # so they are closing a loop
+           hasWeakEdges = any(self._FIFOWeak[e] for e in self._sortedEdges)
+           mustDoSingleAppearance = len(self._topologicalSort)>0 and not hasWeakEdges
+           if not mustDoSingleAppearance:
+              print("Single appearance schedule has been disabled. The graph has some loops")
+        elif config.sinkPriority or mustDoLocality or mustDoLatency:
            self.computeSinkTopologicalSortOfNodes()
 
-        mustDoSinkPrioritization = config.sinkPriority and len(self._topologicalSort)>0
-        if config.sinkPriority and not mustDoSinkPrioritization:
+        mustDoSinkPrioritization = config.sinkPriority and len(self._topologicalSort)>0 and isOccupancy
+        if config.sinkPriority and isOccupancy and not mustDoSinkPrioritization:
             print("Sink prioritization has been disabled. The graph has some loops")
+        # Second pass reordering the schedule
+        mustReorder = mustDoSinkPrioritization or mustDoLocality or mustDoSingleAppearance or mustDoLatency
 
         # Init values
         initB = self.initEvolutionVector
@@ -1585,7 +2764,6 @@ class Graph():
 
         # Current values (copys)
         b = np.array(initB)
-        n = np.array(initN)
 
         if config.displayFIFOSizes:
            for edge in self._sortedEdges:
@@ -1638,16 +2816,20 @@ class Graph():
         # to minimize the occupancy number of all FIFOs by
         # selecting the scheduling which is giving the
         # minimum maximum occupancy number after the run.
-        bMax = 1.0*np.array(initB)
+        bMax = [float(x) for x in initB]
 
+        # FIFO state updated incrementally
+        occupancy = FIFOOccupancy(initB,normV)
+        candidates = [None] * len(self._sortedNodes)
+        n = [int(x) for x in initN]
+        remaining = sum(n)
 
         schedule=[]
 
-        zeroVec = np.zeros(len(self._sortedNodes),dtype=int)
         evolutionTime = 0        
         #print(self._sortedNodes)
         # While there are remaining node periods to schedule
-        while (n != zeroVec).any():
+        while remaining > 0:
             #print("")
             #print(n)
             # Look for the best node to schedule
@@ -1666,17 +2848,20 @@ class Graph():
                    # Evolution vector for static scheduling
                    # v = self.evolutionVectorForNode(nodeID)
                    # for cyclo static we need the new fifo state
-                   newB = self.evolutionVectorForNode(node.sortedNodeID) + b
-                   # New fifos size after this evolution
+                   # Only the FIFOs connected to the node are changed
                    # For static scheduling, fifo update would have been
                    # newB = np.dot(t,v) + b
-                   #print(newB)
+                   candidate = candidates[node.sortedNodeID]
+                   if candidate is None:
+                      candidate = self._evaluateCandidate(occupancy,node.sortedNodeID)
+                      candidates[node.sortedNodeID] = candidate
+                   feasible,touched,localMax = candidate
             
                    # Check that there is no FIFO underflow:
-                   if np.all(newB >= 0):
+                   if feasible:
                       # Total FIFO size for this possible execution
                       # We normalize to get the occupancy number as explained above
-                      theMin = (1.0*np.array(newB) / normV).max()
+                      theMin = occupancy.maxOccupancy(touched,localMax)
                       # If this possible evolution is giving smaller FIFO size
                       # (measured in occupancy number) then it is selected
                       
@@ -1705,36 +2890,49 @@ class Graph():
 
             # Implementation for cyclo static scheduling
             #print("selected")
-            fifoChange = self.evolutionVectorForNode(selected,test=False)
-            b = fifoChange + b
-            # For cyclo static, we create an evolution vector 
-            # which contains a 1
+            fifoChange = self.fifoChangesForNode(selected,test=False)
+            occupancy.apply(fifoChange)
+            self._invalidateCandidates(candidates,selected,fifoChange)
+            # For cyclo static, the null vector is decreased
             # at a node position only if this node has executed
             # its period.
-            # Otherwise the null vector is not decreased
-            v = np.zeros(len(self._sortedNodes))
-            v[selected] = self._sortedNodes[selected].executeNode() 
-            n = n - v
+            executed = self._sortedNodes[selected].executeNode() 
+            n[selected] = n[selected] - executed
+            remaining = remaining - executed
 
 
-            if config.displayFIFOSizes and not mustDoSinkPrioritization:
-               print(b)
+            if config.displayFIFOSizes and not mustReorder:
+               print(np.array(occupancy.b))
             
-            bMax = np.maximum(b,bMax)
+            for e,_ in fifoChange:
+                bMax[e] = max(occupancy.b[e],bMax[e])
             schedule.append(selected)
 
             # Analyze FIFOs to know if a FIFOs write is
             # followed immediately by a FIFO read of same size
-            if not mustDoSinkPrioritization:
-               analyzeStep(fifoChange,allFIFOs,evolutionTime)
+            if not mustReorder:
+               analyzeSparseStep(fifoChange,allFIFOs,evolutionTime)
             evolutionTime = evolutionTime + 1
 
+        bMax = np.array(bMax)
         fifoMax=np.floor(bMax).astype(np.int32)
 
         if mustDoSinkPrioritization:
            schedule = self.computeTopologicalOrderSchedule(normV,allFIFOs,initB,bMax,initN,config)
+
+        if mustDoLocality:
+           schedule = self.computeLocalitySchedule(normV,allFIFOs,initB,bMax,initN,config)
+
+        if mustDoLatency:
+           schedule = self.computeLatencySchedule(normV,allFIFOs,initB,bMax,initN,config,schedule)
+           bMax = self.replaySchedule(schedule,allFIFOs,initB,config)
+           fifoMax=np.floor(np.array(bMax)).astype(np.int32)
+
+        if mustDoSingleAppearance:
+           schedule,bMax = self.computeSingleAppearanceSchedule(allFIFOs,initB,initN,config)
+           fifoMax=np.floor(np.array(bMax)).astype(np.int32)
         
-        allBuffers=self.initializeFIFODescriptions(config,allFIFOs,fifoMax,evolutionTime)
+        allBuffers=self.initializeFIFODescriptions(config,allFIFOs,fifoMax,evolutionTime,schedule)
         self._allFIFOs = allFIFOs 
         self._allBuffers = allBuffers
 
@@ -1743,6 +2941,13 @@ class Graph():
             for nodeID in schedule:
                 print(self._sortedNodes[nodeID].nodeName)
             print("")
+
+        if mustDoLatency:
+            for (src,sink),(steps,time) in self.sourceSinkLatency(schedule).items():
+                print(f"Latency {src.nodeName} -> {sink.nodeName} : {steps} node executions (estimated time {time})")
+
+        if config.nodeCosts is not None:
+            print(f"Predicted iteration time : {self.iterationTime(schedule)}")
         return(Schedule(self,schedule,config,oldSelectorsInit))
 
 def _selector_define_name(sel):
@@ -1796,6 +3001,9 @@ class Schedule:
         self._edgeToFIFO = g._edgeToFIFO
         self._eventConnections = g._eventConnections
         self._nodeIdentification = []
+        # The FIFO types are part of the node classes
+        # so they are needed for the selector initializations
+        self._setExactFIFOTypes()
         self._selector_inits = _compute_selector_inits(self.allNodes,json_files=oldSelectorsInit)
         # Nodes containing pure functions (no state) like some
         # CMSIS-DSP functions.
@@ -1835,6 +3043,107 @@ class Schedule:
 
             
 
+    @property
+    def latency(self):
+        """Worst latency between the sources and the sinks: 
+        dictionary (source, sink) -> (number of node executions, 
+        estimated time)"""
+        return(self._graph.sourceSinkLatency(self._schedule))
+
+    @property
+    def iterationTime(self):
+        """Estimated time of one iteration of the schedule: 
+        sum of the costs of the executed nodes"""
+        return(self._graph.iterationTime(self._schedule))
+
+    def partition(self,nbThreads):
+        """Distribution of the nodes on nbThreads threads balancing
+        their costs. Return (threads, time) : the node IDs
+        executed by each thread in order and the estimated time of
+        one iteration. See Graph.partitionSchedule"""
+        return(self._graph.partitionSchedule(self._schedule,nbThreads))
+
+    @property
+    def loopedSchedule(self):
+        """Schedule as nested loops : list of node IDs
+        and of (count, body) loops"""
+        return(looped_schedule(self._schedule))
+
+    @property
+    def staticFIFOOffsets(self):
+        """Offsets of the FIFO reads and writes during a schedule
+        iteration : list indexed by FIFO ID of (start, accesses, end)
+        where accesses is a list of (step, io, isWrite, offset, move)
+        or None when the FIFO is connected to a cyclo-static IO.
+        See static_fifo_offsets"""
+        g = self._graph
+        accesses = [[] for _ in g._allFIFOs]
+        for t,nodeID in enumerate(self._schedule):
+            inputs,outputs = g._nodeFIFOs[nodeID]
+            for e,io in inputs:
+                accesses[e].append((t,io,False))
+            for e,io in outputs:
+                accesses[e].append((t,io,True))
+        result = []
+        for fifo in g._allFIFOs:
+            a = accesses[fifo.fifoID]
+            if not all(isinstance(io.nbSamples,int) for _,io,_ in a):
+               result.append(None)
+               continue
+            start,offsets,moves,end = static_fifo_offsets(
+                [(io.nbSamples,isWrite) for _,io,isWrite in a],
+                fifo.length,fifo.delay)
+            result.append((start,
+                           [(t,io,isWrite,offset,move) for (t,io,isWrite),offset,move in zip(a,offsets,moves)],
+                           end))
+        return(result)
+
+    @property
+    def staticFIFOs(self):
+        """FIFOs that can be replaced by StaticFIFO objects or
+        constant pointers when Configuration.staticFIFOs is enabled:
+        dictionary FIFO ID -> FIFO.
+        Custom FIFOs, buffers set by a node, FIFOs connecting a node
+        to itself and cyclo-static FIFOs are kept"""
+        g = self._graph
+        offsets = self.staticFIFOOffsets
+        static = {}
+        for fifo in g._allFIFOs:
+            if offsets[fifo.fifoID] is None:
+               continue
+            if fifo.fifoClass != g.defaultFIFOClass:
+               continue
+            if fifo.customBuffer is not None and fifo.customBuffer.assignedByNode:
+               continue
+            if fifo.src.owner is fifo.dst.owner:
+               continue
+            static[fifo.fifoID] = fifo
+        return(static)
+
+    def _setExactFIFOTypes(self):
+        """Types of the FIFOs used as template arguments of the
+        nodes supporting them"""
+        config = self._config
+        static = {}
+        if config.exactFIFOTypes and config.staticFIFOs and \
+           not (config.asynchronous or config.fullyAsynchronous or config.callback):
+           static = self.staticFIFOs
+        for n in self.allNodes:
+            n._fifoTypes = []
+            if not (config.exactFIFOTypes and n.exactFIFOTypes):
+               continue
+            ios = [n._inputs[x] for x in n.inputNames] + \
+                  [n._outputs[x] for x in n.outputNames]
+            for io in ios:
+                # An io connected to a constant node has no FIFO
+                if len(io.fifo) == 0:
+                   continue
+                fifo = self._edgeToFIFO[io.fifo]
+                if fifo.fifoID in static:
+                   n._fifoTypes.append(f"StaticFIFO<{fifo.theType.ctype},FIFOSIZE{fifo.fifoID}>")
+                else:
+                   n._fifoTypes.append(fifo.cType(config))
+
     @property 
     def nodeIdentification(self):
         if not self._config.nodeIdentification:
@@ -1921,6 +3230,29 @@ class Schedule:
             
         return(outs)
 
+    def sharedFIFOChecks(self,node):
+        """Pairs of FIFO IDs (output of the node, other FIFO) 
+        sharing some memory.
+        Used to check in asynchronous mode that the FIFOs sharing memory
+        never contain samples at the same time"""
+        def extent(f):
+            return(f.bufferOffset,f.bufferOffset + f.theType.bytes * f.length)
+
+        allFIFOs = self._graph._allFIFOs
+        checks = []
+        for io in node.outputNames:
+            o = self._edgeToFIFO[node._outputs[io].fifo]
+            if o.customBuffer is not None:
+                continue
+            start,stop = extent(o)
+            for f in allFIFOs:
+                if f is o or f.buffer is not o.buffer:
+                    continue
+                fStart,fStop = extent(f)
+                if fStart < stop and start < fStop:
+                    checks.append((o.fifoID,f.fifoID))
+        return(checks)
+
     def genJsonIdentification(self,directory,config=Configuration()):
         """Write graphviz into file f""" 
         s = self._jsonIdentificationStr
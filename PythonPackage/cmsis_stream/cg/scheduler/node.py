@@ -44,7 +44,10 @@ def camelCase(st):
 
 def joinit(iterable, delimiter):
     it = iter(iterable)
-    yield next(it)
+    try:
+       yield next(it)
+    except StopIteration:
+       return
     for x in it:
         yield delimiter
         yield x
@@ -328,6 +331,23 @@ class BaseNode:
 
         self._identified = identified
 
+        # Used by the buffer sharing in asynchronous mode.
+        # None means only a source may skip an execution
+        # that its FIFOs would allow
+        self._asyncMaySkip = None
+
+        # Estimated execution time of the node (arbitrary unit)
+        # used to report the latency of the schedule
+        self._cost = 1
+
+        # The C++ class of the node accepts the exact types of
+        # its FIFOs as additional template arguments
+        self._exactFIFOTypes = False
+        # Types of the FIFOs used as template arguments
+        # when Configuration.exactFIFOTypes is enabled.
+        # Set by the schedule
+        self._fifoTypes = []
+
         self._selectors = selectors
         # Argument for receiving the event queue has been added
         self._evtQueueAdded = False
@@ -366,6 +386,46 @@ class BaseNode:
     def identified(self, value):
         self._identified = value
 
+    @property
+    def asyncMaySkip(self):
+        """True if the node may skip its execution in asynchronous
+        mode although there are enough samples in its inputs 
+        and enough free space in its outputs.
+        By default, only the sources may skip"""
+        if self._asyncMaySkip is None:
+            return(len(self._inputs)==0)
+        return self._asyncMaySkip
+
+    @asyncMaySkip.setter
+    def asyncMaySkip(self, value):
+        self._asyncMaySkip = value
+
+    @property
+    def cost(self):
+        """Estimated execution time of the node in an arbitrary
+        unit (1 by default). It is used to estimate the
+        latency between the sources and the sinks"""
+        return self._cost
+
+    @cost.setter
+    def cost(self, value):
+        self._cost = value
+
+    @property
+    def exactFIFOTypes(self):
+        """True if the C++ class of the node accepts the types of
+        its FIFOs as additional template arguments after the
+        input and output types and sizes (in the order of the
+        constructor arguments). When Configuration.exactFIFOTypes
+        is enabled, the node is bound to the concrete FIFO classes
+        and the FIFO functions are no more virtual calls.
+        Only nodes with a fixed number of FIFOs can support it"""
+        return self._exactFIFOTypes
+
+    @exactFIFOTypes.setter
+    def exactFIFOTypes(self, value):
+        self._exactFIFOTypes = value
+
     def addEventInput(self,nb = 1):
         id = len(self._eventInputs)
         for k in range(nb):
@@ -604,6 +664,7 @@ class BaseNode:
         ios=[]
         ios += self.getCTemplateArgumentsFor(self.inputNames,self._inputs)
         ios += self.getCTemplateArgumentsFor(self.outputNames,self._outputs)
+        ios += self._fifoTypes
         
         if ios:
            return(self._bracket("".join(joinit(ios,","))))
@@ -1134,12 +1195,14 @@ class SlidingBuffer(GenericNode):
         self._overlap = overlap 
         self.addInput("i",theType,length-overlap)
         self.addOutput("o",theType,length)
+        self._exactFIFOTypes = True
     
     def ioTemplate(self):
         """ioTemplate is different for window
         """
         theType=self._inputs[self.inputNames[0]].ctype  
         ios="%s,%d,%d" % (theType,self._length,self._overlap)
+        ios = "".join(joinit([ios] + self._fifoTypes,","))
         return(self._bracket(ios))
 
     def pythonIoTemplate(self):
@@ -1162,12 +1225,14 @@ class OverlapAdd(GenericNode):
         self._overlap = overlap 
         self.addInput("i",theType,length)
         self.addOutput("o",theType,length-overlap)
+        self._exactFIFOTypes = True
     
     def ioTemplate(self):
         """ioTemplate is different for window
         """
         theType=self._inputs[self.inputNames[0]].ctype  
         ios="%s,%d,%d" % (theType,self._length,self._overlap)
+        ios = "".join(joinit([ios] + self._fifoTypes,","))
         return(self._bracket(ios))
 
     def pythonIoTemplate(self):
@@ -1331,7 +1396,7 @@ class GenericFunction(GenericNode):
                
                # Buffer and fifo
                nb = ioObj.nbSamples
-               inputs.append((buf,self.listOfargs[theId],nb))
+               inputs.append((buf,self.listOfargs[theId],nb,io))
                inputId = inputId + 1
             theId = theId + 1
        for io in self.outputNames:
@@ -1345,7 +1410,7 @@ class GenericFunction(GenericNode):
             outargs.append(buf)
             fifoToBuf[io] = buf
             nb = ioObj.nbSamples
-            outputs.append((buf,self.listOfargs[theId],nb))
+            outputs.append((buf,self.listOfargs[theId],nb,io))
             outputId = outputId + 1
             theId = theId + 1
 
@@ -1354,12 +1419,33 @@ class GenericFunction(GenericNode):
             for lit in self.schedArgs:
                 sched.append(lit.arg)
 
+       args,inargs,outargs = self._cArgs(self._argsDesc,fifoToBuf,sched,ctemplate)
+
+       argsStr="".join(joinit(args,","))
+       inArgsStr="".join(joinit(inargs,","))
+       outArgsStr="".join(joinit(outargs,","))
+
+       return ({"ptrs" : ptrs,
+               "args" : argsStr,
+               "calls" : self._cCalls(fifoToBuf,sched,ctemplate),
+               "inArgsStr" : inArgsStr,
+               "outArgsStr" :outArgsStr,
+               "inputs":inputs, 
+               "outputs":outputs})
+
+    def _cCalls(self,fifoToBuf,sched,ctemplate=True):
+       """List of (function, arguments) to call"""
+       args,_,_ = self._cArgs(self._argsDesc,fifoToBuf,sched,ctemplate)
+       return([(self._nodeName,"".join(joinit(args,",")))])
+
+    def _cArgs(self,argsDesc,fifoToBuf,sched,ctemplate=True):
+       """Arguments of a function call described by argsDesc"""
        args=[]
        # inargs and outargs are used for Python version
        # of a pure function
        inargs=[] 
        outargs=[]
-       for a in self._argsDesc:
+       for a in argsDesc:
            # Name of an IO
            if isinstance(a,str):
               args.append(fifoToBuf[a])
@@ -1403,17 +1489,7 @@ class GenericFunction(GenericNode):
               else:
                  args.append(f"sizeof({the_type})*{nb}")
                  
-
-       argsStr="".join(joinit(args,","))
-       inArgsStr="".join(joinit(inargs,","))
-       outArgsStr="".join(joinit(outargs,","))
-
-       return ({"ptrs" : ptrs,
-               "args" : argsStr,
-               "inArgsStr" : inArgsStr,
-               "outArgsStr" :outArgsStr,
-               "inputs":inputs, 
-               "outputs":outputs})
+       return(args,inargs,outargs)
 
     def cCheck(self,asyncDefaultSkip=True):
         params = self._prepareForCodeGen(True)
@@ -1429,15 +1505,19 @@ class GenericFunction(GenericNode):
         
 
     # To clean
-    def cRun(self,config,ctemplate=True):
+    # pointers : IO name -> buffer computed at generation time
+    # (static FIFOs)
+    def cRun(self,config,ctemplate=True,pointers={}):
         params = self._prepareForCodeGen(ctemplate)
 
         if ctemplate:
               result=GenericFunction.CTEMPLATE.render(func=self._nodeName,
                ptrs = params["ptrs"],
                args = params["args"],
+               calls = params["calls"],
                inputs=params["inputs"], 
                outputs=params["outputs"],
+               pointers=pointers,
                node=self
                )
         else:
@@ -1470,4 +1550,58 @@ class Binary(GenericFunction):
         self.addInput(input_names[0],theType,length)
         self.addInput(input_names[1],theType,length)
         
-        self.addOutput(output_name,theType,length)
\ No newline at end of file
+        self.addOutput(output_name,theType,length)
+
+
+class FusedFunction(GenericFunction):
+    """Chain of elementwise functions (Unary or Binary) fused
+    into one node.
+
+    The first function writes to the output buffer and the next ones
+    compute in place in this buffer so there is no intermediate FIFO.
+    The functions must support in place computation (like
+    the CMSIS-DSP basic math functions)"""
+    def __init__(self,nodes):
+        GenericFunction.__init__(self,"_".join([n._nodeName for n in nodes]),[])
+        # (function, arguments description using the fused IO names)
+        self._calls = []
+        # Inputs of the chain nodes mapped to the fused node
+        # (original input, fused input name)
+        self._fusedInputs = []
+        previous = None
+        for node in nodes:
+            ioMap = {}
+            for name in node.inputNames:
+                io = node._inputs[name]
+                if previous is not None and io.fifo and io.fifo[0][0].owner is previous:
+                   ioMap[name] = "o"
+                else:
+                   fusedName = "i%d" % len(self._fusedInputs)
+                   self.addInput(fusedName,io.theType,io.nbSamples)
+                   self._fusedInputs.append((io,fusedName))
+                   ioMap[name] = fusedName
+            for name in node.outputNames:
+                ioMap[name] = "o"
+            desc = []
+            for a in node._argsDesc:
+                if isinstance(a,str):
+                   desc.append(ioMap[a])
+                elif isinstance(a,ArgLength):
+                   desc.append(ArgLength(ioMap[a.name],sample_unit=a.sample_unit))
+                else:
+                   desc.append(a)
+            self._calls.append((node._nodeName,desc))
+            previous = node
+        last = nodes[-1]._outputs[nodes[-1].outputNames[0]]
+        self.addOutput("o",last.theType,last.nbSamples)
+
+    @property
+    def fusedInputs(self):
+        return self._fusedInputs
+
+    def _cCalls(self,fifoToBuf,sched,ctemplate=True):
+       calls = []
+       for func,desc in self._calls:
+           args,_,_ = self._cArgs(desc,fifoToBuf,sched,ctemplate)
+           calls.append((func,"".join(joinit(args,","))))
+       return(calls)
@@ -5,11 +5,21 @@
                    {{ptr[0]}}* {{ptr[1]}};
 {% endfor %}
 {% for ptr in inputs %}
+{% if ptr[3] in pointers %}
+                   {{ptr[0]}}={{pointers[ptr[3]]}};
+{% else %}
                    {{ptr[0]}}={{ptr[1].access}}getReadBuffer({{ptr[2]}});
+{% endif %}
 {% endfor %}
 {% for ptr in outputs %}
+{% if ptr[3] in pointers %}
+                   {{ptr[0]}}={{pointers[ptr[3]]}};
+{% else %}
                    {{ptr[0]}}={{ptr[1].access}}getWriteBuffer({{ptr[2]}});
+{% endif %}
+{% endfor %}
+{% for call in calls %}
+                   {{call[0]}}({{call[1]}});
 {% endfor %}
-                   {{func}}({{args}});
                    cgStaticError = 0;
                   }
\ No newline at end of file
@@ -17,27 +17,62 @@
        EventRecord2 (Evt_Scheduler, nbSchedule, 0);
        {% endif -%}
        CG_BEFORE_ITERATION;
-{% for s in schedule %}
-       {% if config.eventRecorder -%}
-       EventRecord2 (Evt_Node, {{streamNodes[s].codeID}}, 0);
-       {% endif -%}
-       CG_BEFORE_NODE_EXECUTION({{streamNodes[s].codeID}});
-       {{streamNodes[s].cRun(config)}}
-       CG_AFTER_NODE_EXECUTION({{streamNodes[s].codeID}});
-       {% if config.eventRecorder -%}
-       if (cgStaticError<0)
-       {
-           EventRecord2 (Evt_Error, cgStaticError, 0);
-       }
-       {% endif -%}
-       CHECKERROR;
+{% macro runNode(s,step=none) %}
+{% if step is not none %}
+{% for line in step.prologue %}
+{{line}}
+{% endfor %}
+{% endif %}
+{% if config.eventRecorder -%}
+EventRecord2 (Evt_Node, {{streamNodes[s].codeID}}, 0);
+{% endif -%}
+CG_BEFORE_NODE_EXECUTION({{streamNodes[s].codeID}});
+{% if step is not none %}
+{{step.run}}
+{% else %}
+{{streamNodes[s].cRun(config)}}
+{% endif %}
+CG_AFTER_NODE_EXECUTION({{streamNodes[s].codeID}});
+{% if config.eventRecorder -%}
+if (cgStaticError<0)
+{
+    EventRecord2 (Evt_Error, cgStaticError, 0);
+}
+{% endif -%}
+CHECKERROR;
 {% if config.dumpFIFO %}
-{% for fifoID in sched.outputFIFOs(streamNodes[s]) %}
-       std::cout << "{{streamNodes[s].nodeName}}:{{fifoID[1]}}" << std::endl;
-       fifo{{fifoID[0]}}.dump();
+{% for fifoID in sched.outputFIFOs(streamNodes[s]) if fifoID[0] in fifoObjects %}
+std::cout << "{{streamNodes[s].nodeName}}:{{fifoID[1]}}" << std::endl;
+fifo{{fifoID[0]}}.dump();
 {% endfor %}
 {% endif %}
+{% endmacro %}
+{% macro runLoops(items,depth) %}
+{% for item in items %}
+{% if item is number %}
+{{runNode(item)}}
+{%- else %}
+for(int i{{depth}}=0;i{{depth}}<{{item[0]}};i{{depth}}++)
+{
+    {{runLoops(item[1],depth+1) | trim | indent(4)}}
+}
+{% endif %}
+{% endfor %}
+{% endmacro %}
+{% if staticFIFOs is not none %}
+{% for step in staticFIFOs.steps %}
+       {{runNode(step.node,step) | indent(7)}}
+{% endfor %}
+{% for line in staticFIFOs.epilogue %}
+       {{line}}
 {% endfor %}
+{% elif loops is not none %}
+       {{runLoops(loops,0) | trim | indent(7)}}
+{% else %}
+{% for s in schedule %}
+       {{runNode(s) | indent(7)}}
+{% endfor %}
+{% endif %}
 
 {% if config.debug %}
        debugCounter--;
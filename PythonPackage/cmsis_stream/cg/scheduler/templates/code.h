@@ -26,6 +26,9 @@ The support classes and code are covered by CMSIS-Stream license.
 {% if config.CAPI -%}
 
 #include <stdint.h>
+{% if objectArena %}
+#include <stddef.h>
+{% endif %}
 
 #ifdef   __cplusplus
 extern "C"
@@ -37,6 +40,9 @@ extern "C"
 {% endif %}
 {% else %}
 #include <cstdint>
+{% if objectArena %}
+#include <cstddef>
+{% endif %}
 #include "EventQueue.hpp"
 {% if config.nodeIdentification -%}
 #include "{{config.cnodeAPI}}"
@@ -54,6 +60,18 @@ extern "C"
 
 {% endif %}
 
+{% if latencies -%}
+/* Worst latency from sources to sinks in node executions */
+{% for latency in latencies %}
+#define {{latency[0]}} {{latency[1]}} /* Estimated time {{latency[2]}} */
+{% endfor %}
+
+{% endif %}
+{% if iterationTime is not none -%}
+/* Estimated time of one iteration with the measured node costs */
+#define {{config.prefix | upper}}PREDICTED_ITERATION_TIME {{iterationTime}}
+
+{% endif %}
 {% if config.nodeIdentification -%}
 /* Node identifiers */
 #define {{config.prefix | upper}}NB_IDENTIFIED_NODES {{identifiedNodes|length}}
@@ -91,6 +109,11 @@ extern int init_{{config.schedName}}(arm_cmsis_stream::EventQueue *evtQueue{{ini
 extern void free_{{config.schedName}}({{freeOptionalargs(True)}});
 extern uint32_t {{config.schedName}}(int *error{{executionOptionalargs(False)}});
 extern void reset_fifos_{{config.schedName}}(int all);
+{% if objectArena %}
+extern size_t arena_size_{{config.schedName}}(void);
+extern size_t arena_alignment_{{config.schedName}}(void);
+extern int set_arena_{{config.schedName}}(void *block,size_t size);
+{% endif %}
 
 {% else -%}
 {% if config.CAPI -%}
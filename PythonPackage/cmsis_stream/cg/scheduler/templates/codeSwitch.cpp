@@ -129,6 +129,22 @@ static {{schedSwitchDataType}} schedule[{{schedLen}}]=
                    fifo{{fifoID[0]}}.dump();
                    {%- endfor %}
                    {%- endif %}
+                   {%- if config.asyncMemoryCheck and (config.asynchronous or config.fullyAsynchronous) %}
+                   {%- for check in sched.sharedFIFOChecks(streamNodes[nodeID]) %}
+                   {%- if config.heapAllocation %}
+                   {%- set fifoA = "fifos.fifo" ~ check[0] ~ "->" %}
+                   {%- set fifoB = "fifos.fifo" ~ check[1] ~ "->" %}
+                   {%- else %}
+                   {%- set fifoA = "fifo" ~ check[0] ~ "." %}
+                   {%- set fifoB = "fifo" ~ check[1] ~ "." %}
+                   {%- endif %}
+
+                   if ((cgStaticError == 0) && ({{fifoA}}nbSamplesInFIFO() > 0) && ({{fifoB}}nbSamplesInFIFO() > 0))
+                   {
+                       cgStaticError = CG_SHARED_FIFO_CONFLICT;
+                   }
+                   {%- endfor %}
+                   {%- endif %}
 
                 }
                 break;
@@ -52,6 +52,19 @@ CG_AFTER_INCLUDES
 {% macro async() -%}
 {% if config.asynchronous or config.fullyAsynchronous%}1{% else %}0{% endif %}
 {% endmacro %}
+{% macro staticFIFO(id) -%}
+StaticFIFO<{{fifos[id].theType.ctype}},FIFOSIZE{{id}}>
+{%- endmacro %}
+{% macro staticFIFOArgs(id) -%}
+{% set init = staticFIFOs.init[id] %}
+({{fifos[id].bufName(config)}}{% if init[0] > 0 or init[1] > 0 %},{{init[0]}},{{init[1]}}{% endif %})
+{%- endmacro %}
+{% macro fifoClass(id) -%}
+{% if staticFIFOs and id in staticFIFOs.init %}{{staticFIFO(id)}}{% else %}{{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}>{% endif %}
+{%- endmacro %}
+{% macro newObject(member) -%}
+{% if objectArena %}new (arena->{{member}}){% else %}new (std::nothrow){% endif %}
+{%- endmacro %}
 
 using namespace arm_cmsis_stream;
 
@@ -175,10 +188,14 @@ CG_BEFORE_BUFFER
 {% endif %}
 
 {% if config.heapAllocation %}
-{% if nbFifos > 0 %}
+{% if fifoObjects|length > 0 %}
 typedef struct {
-{% for id in range(nbFifos) %}
+{% for id in fifoObjects %}
+{% if staticFIFOs and id in staticFIFOs.init %}
+{{staticFIFO(id)}} *fifo{{id}};
+{% else %}
 {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}> *fifo{{id}};
+{% endif %}
 {% endfor %}
 } fifos_t;
 {% endif %}
@@ -192,12 +209,66 @@ typedef struct {
 } nodes_t;
 
 
-{% if nbFifos > 0 %}
+{% if fifoObjects|length > 0 %}
 static fifos_t fifos={0};
 {% endif %}
 
 static nodes_t nodes={0};
 
+{% if objectArena %}
+/*
+
+Storage of the FIFOs and nodes in one block.
+They are placed in the order of their first use in the schedule.
+
+*/
+typedef struct {
+{% for kind,obj in arenaObjects %}
+{% if kind == "fifo" %}
+    alignas({{fifoClass(obj)}}) unsigned char fifo{{obj}}[sizeof({{fifoClass(obj)}})];
+{% else %}
+    alignas({{obj.typeName}}{{obj.ioTemplate()}}) unsigned char node_{{obj.nodeName}}[sizeof({{obj.typeName}}{{obj.ioTemplate()}})];
+{% endif %}
+{% endfor %}
+} arena_t;
+
+static arena_t *arena=NULL;
+/* Block allocated with CG_MALLOC when the arena
+   is not provided by the application */
+static void *arenaBlock=NULL;
+
+template<typename T>
+static void destroy_object(T *&object)
+{
+    if (object!=NULL)
+    {
+        object->~T();
+        object=NULL;
+    }
+}
+
+size_t arena_size_{{config.schedName}}(void)
+{
+    return(sizeof(arena_t));
+}
+
+size_t arena_alignment_{{config.schedName}}(void)
+{
+    return(alignof(arena_t));
+}
+
+int set_arena_{{config.schedName}}(void *block,size_t size)
+{
+    if ((block==NULL) || (size < sizeof(arena_t)) ||
+        (((uintptr_t)block % alignof(arena_t)) != 0))
+    {
+        return(CG_MEMORY_ALLOCATION_FAILURE);
+    }
+    arena = reinterpret_cast<arena_t *>(block);
+    return(CG_SUCCESS);
+}
+
+{% endif %}
 {% if config.nodeIdentification %}
 {{config.cNodeStruct}}* get_{{config.schedName}}_node(int32_t nodeID)
 {
@@ -228,15 +299,28 @@ int init_{{config.schedName}}(EventQueue *evtQueue{{initOptionalargs(False)}})
 {% endif %}
 
     CG_BEFORE_FIFO_INIT;
-{% for id in range(nbFifos) %}
-{% if fifos[id].hasDelay or fifos[id].hasAdditionalArgs %}
-    fifos.fifo{{id}} = new (std::nothrow) {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}>({{fifos[id].bufName(config)}},{{fifos[id].delay}}{{fifos[id].fifo_additional_args}});
-    if (fifos.fifo{{id}}==NULL)
+{% if objectArena %}
+    if (arena==NULL)
     {
-        return(CG_MEMORY_ALLOCATION_FAILURE);
+        arenaBlock = CG_MALLOC(sizeof(arena_t)+alignof(arena_t)-1);
+        if (arenaBlock==NULL)
+        {
+            return(CG_MEMORY_ALLOCATION_FAILURE);
+        }
+        uintptr_t start = ((uintptr_t)arenaBlock + alignof(arena_t) - 1) & ~((uintptr_t)alignof(arena_t) - 1);
+        arena = reinterpret_cast<arena_t *>(start);
     }
+
+{% endif %}
+{% for id in fifoObjects %}
+{% if staticFIFOs and id in staticFIFOs.init %}
+    fifos.fifo{{id}} = {{newObject("fifo" ~ id)}} {{staticFIFO(id)}}{{staticFIFOArgs(id)}};
+{% elif fifos[id].hasDelay or fifos[id].hasAdditionalArgs %}
+    fifos.fifo{{id}} = {{newObject("fifo" ~ id)}} {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}>({{fifos[id].bufName(config)}},{{fifos[id].delay}}{{fifos[id].fifo_additional_args}});
 {% else %}
-    fifos.fifo{{id}} = new (std::nothrow) {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}>({{fifos[id].bufName(config)}}{{fifos[id].fifo_additional_args}});
+    fifos.fifo{{id}} = {{newObject("fifo" ~ id)}} {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}>({{fifos[id].bufName(config)}}{{fifos[id].fifo_additional_args}});
+{% endif %}
+{% if not objectArena %}
     if (fifos.fifo{{id}}==NULL)
     {
         return(CG_MEMORY_ALLOCATION_FAILURE);
@@ -249,11 +333,13 @@ int init_{{config.schedName}}(EventQueue *evtQueue{{initOptionalargs(False)}})
 
 {% for node in allNodes %}
 {% if node.hasState %}
-    nodes.{{node.nodeName}} = new (std::nothrow) {{node.typeName}}{{node.ioTemplate()}}{{init_args(sched,node)}};
+    nodes.{{node.nodeName}} = {{newObject("node_" ~ node.nodeName)}} {{node.typeName}}{{node.ioTemplate()}}{{init_args(sched,node)}};
+{% if not objectArena %}
     if (nodes.{{node.nodeName}}==NULL)
     {
         return(CG_MEMORY_ALLOCATION_FAILURE);
     }
+{% endif %}
 {% if config.nodeIdentification -%}
 {% if node.identified %}
     identifiedNodes[{{node.identificationName}}]={{config.cNodeStructCreation}}(*nodes.{{node.nodeName}});
@@ -287,7 +373,25 @@ int init_{{config.schedName}}(EventQueue *evtQueue{{initOptionalargs(False)}})
 
 void free_{{config.schedName}}({{freeOptionalargs(True)}})
 {
-{% for id in range(nbFifos) %}
+{% if objectArena %}
+{% for node in allNodes %}
+{% if node.hasState %}
+    destroy_object(nodes.{{node.nodeName}});
+{% endif %}
+{% endfor %}
+
+{% for id in fifoObjects %}
+    destroy_object(fifos.fifo{{id}});
+{% endfor %}
+
+    if (arenaBlock!=NULL)
+    {
+        CG_FREE(arenaBlock);
+        arenaBlock=NULL;
+    }
+    arena=NULL;
+{% else %}
+{% for id in fifoObjects %}
     if (fifos.fifo{{id}}!=NULL)
     {
        delete fifos.fifo{{id}};
@@ -302,11 +406,12 @@ void free_{{config.schedName}}({{freeOptionalargs(True)}})
     }
 {% endif %}
 {% endfor %}
+{% endif %}
 }
 
 void reset_fifos_{{config.schedName}}(int all)
 {
-{% for id in range(nbFifos) %}
+{% for id in fifoObjects %}
     if (fifos.fifo{{id}}!=NULL)
     {
        fifos.fifo{{id}}->reset();
@@ -372,8 +477,10 @@ uint32_t {{config.schedName}}(int *error{{executionOptionalargs(False)}})
     /*
     Create FIFOs objects
     */
-{% for id in range(nbFifos) %}
-{% if fifos[id].hasDelay or fifos[id].hasAdditionalArgs %}
+{% for id in fifoObjects %}
+{% if staticFIFOs and id in staticFIFOs.init %}
+    {{staticFIFO(id)}} fifo{{id}}{{staticFIFOArgs(id)}};
+{% elif fifos[id].hasDelay or fifos[id].hasAdditionalArgs %}
     {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}> fifo{{id}}({{fifos[id].bufName(config)}},{{fifos[id].delay}}{{fifos[id].fifo_additional_args}});
 {% else %}
     {{fifos[id].fifo_class_str}}<{{fifos[id].theType.ctype}},FIFOSIZE{{id}},{{fifos[id].isArrayAsInt}},{{async()}}> fifo{{id}}({{fifos[id].bufName(config)}}{{fifos[id].fifo_additional_args}});
@@ -414,6 +521,13 @@ uint32_t {{config.schedName}}(int *error{{executionOptionalargs(False)}})
 
 
 
+{% if staticFIFOs and staticFIFOs.buffers %}
+    /* Buffers of the static FIFOs */
+{% for buf in staticFIFOs.buffers %}
+    {{buf[1]}} *const fifoBuf{{buf[0]}} = ({{buf[1]}} *)({{buf[2]}});
+{% endfor %}
+
+{% endif %}
     /* Run several schedule iterations */
 {% block scheduleLoop %}
 {% endblock %}
@@ -6,7 +6,7 @@
 
 #endif
 
-{% if config.bufferAllocation %}
+{% if config.bufferAllocation or objectArena %}
 #if !defined(CG_MALLOC)
 #define CG_MALLOC(A) malloc((A))
 #endif 
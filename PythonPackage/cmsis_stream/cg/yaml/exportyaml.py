@@ -427,6 +427,12 @@ def export_config(config,filename):
     if config.sinkPriority  != default.sinkPriority :
         schedule_options["sink-priority"] = config.sinkPriority
 
+    if config.scheduleObjective != default.scheduleObjective:
+        schedule_options["schedule-objective"] = config.scheduleObjective
+
+    if config.nodeCosts != default.nodeCosts:
+        schedule_options["node-costs"] = config.nodeCosts
+
     if config.displayFIFOSizes   != default.displayFIFOSizes  :
         schedule_options["display-fifo-sizes"] = config.displayFIFOSizes
 
@@ -436,6 +442,21 @@ def export_config(config,filename):
     if config.memStrategy != default.memStrategy:
         schedule_options["mem-strategy"] = config.memStrategy
 
+    if config.memoryAllocator != default.memoryAllocator:
+        schedule_options["memory-allocator"] = config.memoryAllocator
+
+    if config.arenaAlignment != default.arenaAlignment:
+        schedule_options["arena-alignment"] = config.arenaAlignment
+
+    if config.asyncMemoryOptimization != default.asyncMemoryOptimization:
+        schedule_options["async-memory-optimization"] = config.asyncMemoryOptimization
+
+    if config.asyncMemoryMaxStates != default.asyncMemoryMaxStates:
+        schedule_options["async-memory-max-states"] = config.asyncMemoryMaxStates
+
+    if config.fuseElementwiseFunctions != default.fuseElementwiseFunctions:
+        schedule_options["fuse-elementwise-functions"] = config.fuseElementwiseFunctions
+
     if config.bufferAllocation != default.bufferAllocation:
         schedule_options["buffer-allocation"] = config.bufferAllocation
 
@@ -485,6 +506,18 @@ def export_config(config,filename):
     if config.switchCase  != default.switchCase:
         c_code_gen["switch-case"] = config.switchCase 
 
+    if config.nestedLoops != default.nestedLoops:
+        c_code_gen["nested-loops"] = config.nestedLoops
+
+    if config.staticFIFOs != default.staticFIFOs:
+        c_code_gen["static-fifos"] = config.staticFIFOs
+
+    if config.exactFIFOTypes != default.exactFIFOTypes:
+        c_code_gen["exact-fifo-types"] = config.exactFIFOTypes
+
+    if config.objectArena != default.objectArena:
+        c_code_gen["object-arena"] = config.objectArena
+
     if config.eventRecorder   != default.eventRecorder :
         c_code_gen["event-recorder"] = config.eventRecorder 
 
@@ -518,6 +551,9 @@ def export_config(config,filename):
     if config.asyncDefaultSkip   != default.asyncDefaultSkip        :
         c_code_gen["async-default-skip"] = config.asyncDefaultSkip  
 
+    if config.asyncMemoryCheck != default.asyncMemoryCheck:
+        c_code_gen["async-memory-check"] = config.asyncMemoryCheck
+
     if config.nodeIdentification   != default.nodeIdentification        :
         c_code_gen["node-identification"] = config.nodeIdentification  
 
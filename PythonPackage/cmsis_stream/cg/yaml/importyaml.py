@@ -438,6 +438,12 @@ def import_config(filename):
     
             if 'sink-priority' in so:
                 conf.sinkPriority = so['sink-priority']
+
+            if 'schedule-objective' in so:
+                conf.scheduleObjective = so['schedule-objective']
+
+            if 'node-costs' in so:
+                conf.nodeCosts = so['node-costs']
     
             if 'display-fifo-sizes' in so:
                 conf.displayFIFOSizes = so['display-fifo-sizes']
@@ -448,6 +454,21 @@ def import_config(filename):
             if 'mem-strategy' in so:
                 conf.memStrategy = so['mem-strategy']
 
+            if 'memory-allocator' in so:
+                conf.memoryAllocator = so['memory-allocator']
+
+            if 'arena-alignment' in so:
+                conf.arenaAlignment = so['arena-alignment']
+
+            if 'async-memory-optimization' in so:
+                conf.asyncMemoryOptimization = so['async-memory-optimization']
+
+            if 'async-memory-max-states' in so:
+                conf.asyncMemoryMaxStates = so['async-memory-max-states']
+
+            if 'fuse-elementwise-functions' in so:
+                conf.fuseElementwiseFunctions = so['fuse-elementwise-functions']
+
             if 'buffer-allocation' in so:
                 conf.bufferAllocation = so['buffer-allocation']
 
@@ -491,6 +512,18 @@ def import_config(filename):
             if 'switch-case' in cco:
                 conf.switchCase = cco['switch-case']
 
+            if 'nested-loops' in cco:
+                conf.nestedLoops = cco['nested-loops']
+
+            if 'static-fifos' in cco:
+                conf.staticFIFOs = cco['static-fifos']
+
+            if 'exact-fifo-types' in cco:
+                conf.exactFIFOTypes = cco['exact-fifo-types']
+
+            if 'object-arena' in cco:
+                conf.objectArena = cco['object-arena']
+
             if 'callback' in cco:
                 conf.callback = cco['callback']
     
@@ -527,6 +560,9 @@ def import_config(filename):
             if 'async-default-skip' in cco:
                 conf.asyncDefaultSkip = cco['async-default-skip']
 
+            if 'async-memory-check' in cco:
+                conf.asyncMemoryCheck = cco['async-memory-check']
+
             if 'node-identification' in cco:
                 conf.nodeIdentification = cco['node-identification']
 
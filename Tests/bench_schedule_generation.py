@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Benchmark of the synchronous schedule computation on synthetic graphs.
+
+The graphs are random multirate DAGs: each node has a repetition count
+chosen in a small set and the rates of an edge are derived from the
+repetition counts of its two nodes, so the graphs are always consistent.
+Each node is connected to some of the previous nodes to get long
+chains, forks and joins.
+
+The reuse column is the mean number of bytes written to FIFOs between
+the production and the consumption of a byte. It estimates the working
+set of the schedule : data with a reuse distance smaller than the cache
+is still in the cache when it is consumed. The l1 column is the
+fraction of the bytes consumed with a reuse distance smaller than 32 KiB.
+
+Run:  python3 Tests/bench_schedule_generation.py [--sizes 10,100,1000]
+                                                 [--sink-priority]
+                                                 [--objective locality]
+"""
+
+import argparse
+import collections
+import math
+import os
+import random
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+
+
+# ---------- synthetic nodes ----------
+
+class BenchSource(GenericSource):
+    def __init__(self, name, rates):
+        GenericSource.__init__(self, name)
+        for k, r in enumerate(rates):
+            self.addOutput(f"o{k}", CType(F32), r)
+
+    @property
+    def typeName(self):
+        return "BenchSource"
+
+
+class BenchSink(GenericSink):
+    def __init__(self, name, rates):
+        GenericSink.__init__(self, name)
+        for k, r in enumerate(rates):
+            self.addInput(f"i{k}", CType(F32), r)
+
+    @property
+    def typeName(self):
+        return "BenchSink"
+
+
+class BenchNode(GenericNode):
+    def __init__(self, name, inputRates, outputRates):
+        GenericNode.__init__(self, name)
+        for k, r in enumerate(inputRates):
+            self.addInput(f"i{k}", CType(F32), r)
+        for k, r in enumerate(outputRates):
+            self.addOutput(f"o{k}", CType(F32), r)
+
+    @property
+    def typeName(self):
+        return "BenchNode"
+
+
+# ---------- graph generation ----------
+
+def make_graph(nbNodes, seed, window=8, join=0.2):
+    """Random consistent multirate DAG. Return the graph and its number of edges."""
+    rnd = random.Random(seed)
+    repetitions = [rnd.choice([1, 2, 3, 4, 6, 8, 12, 16]) for _ in range(nbNodes)]
+    edges = []
+    for i in range(1, nbNodes):
+        parents = {rnd.randint(max(0, i - window), i - 1)}
+        if i > 2 and rnd.random() < join:
+            parents.add(rnd.randint(max(0, i - window), i - 1))
+        for p in parents:
+            total = math.lcm(repetitions[p], repetitions[i]) * rnd.choice([1, 2, 4])
+            edges.append((p, i, total // repetitions[p], total // repetitions[i]))
+
+    inputRates = [[] for _ in range(nbNodes)]
+    outputRates = [[] for _ in range(nbNodes)]
+    for (src, dst, produced, consumed) in edges:
+        outputRates[src].append(produced)
+        inputRates[dst].append(consumed)
+
+    nodes = []
+    for i in range(nbNodes):
+        if not inputRates[i]:
+            nodes.append(BenchSource(f"n{i}", outputRates[i]))
+        elif not outputRates[i]:
+            nodes.append(BenchSink(f"n{i}", inputRates[i]))
+        else:
+            nodes.append(BenchNode(f"n{i}", inputRates[i], outputRates[i]))
+
+    g = Graph()
+    nextOutput = [0] * nbNodes
+    nextInput = [0] * nbNodes
+    for (src, dst, _, _) in edges:
+        g.connect(getattr(nodes[src], f"o{nextOutput[src]}"),
+                  getattr(nodes[dst], f"i{nextInput[dst]}"))
+        nextOutput[src] += 1
+        nextInput[dst] += 1
+    return g, len(edges)
+
+
+# ---------- working set ----------
+
+def reuse_distances(g, schedule, cache=32768):
+    """Mean reuse distance in bytes and fraction of the bytes
+    consumed with a reuse distance smaller than cache"""
+    produced = 0
+    # Chunks of samples in each FIFO : (produced counter at write, samples)
+    chunks = [collections.deque() for _ in g._sortedEdges]
+    for e, edge in enumerate(g._sortedEdges):
+        if g.getDelay(edge) > 0:
+            chunks[e].append((0, g.getDelay(edge)))
+    total = 0
+    hits = 0
+    consumed = 0
+    for nodeID in schedule:
+        inputs, outputs = g._nodeFIFOs[nodeID]
+        for e, io in inputs:
+            nb = io.nbSamples
+            while nb > 0:
+                stamp, samples = chunks[e][0]
+                used = min(nb, samples)
+                nbBytes = used * io.theType.bytes
+                total += (produced - stamp) * nbBytes
+                if produced - stamp < cache:
+                    hits += nbBytes
+                consumed += nbBytes
+                nb -= used
+                if used == samples:
+                    chunks[e].popleft()
+                else:
+                    chunks[e][0] = (stamp, samples - used)
+        for e, io in outputs:
+            produced += io.nbSamples * io.theType.bytes
+        for e, io in outputs:
+            chunks[e].append((produced, io.nbSamples))
+    return total / consumed, hits / consumed
+
+
+# ---------- runner ----------
+
+def main():
+    parser = argparse.ArgumentParser(description="Schedule generation benchmark")
+    parser.add_argument("--sizes", default="10,50,100,200,500,1000,2000",
+                        help="Comma separated number of nodes")
+    parser.add_argument("--sink-priority", action="store_true",
+                        help="Enable Configuration.sinkPriority")
+    parser.add_argument("--objective", default="occupancy",
+                        help="Configuration.scheduleObjective")
+    args = parser.parse_args()
+
+    print(f"{'nodes':>6} {'edges':>6} {'schedule':>9} {'memory':>9} "
+          f"{'reuse':>9} {'l1':>5} {'time (s)':>9}")
+    for nbNodes in [int(x) for x in args.sizes.split(",")]:
+        g, nbEdges = make_graph(nbNodes, seed=nbNodes)
+        conf = Configuration()
+        conf.sinkPriority = args.sink_priority
+        conf.scheduleObjective = args.objective
+        start = time.perf_counter()
+        sched = g.computeSchedule(config=conf)
+        elapsed = time.perf_counter() - start
+        reuse, l1 = reuse_distances(g, sched.schedule)
+        print(f"{nbNodes:6d} {nbEdges:6d} {sched.scheduleLength:9d} "
+              f"{sched.memory:9d} {reuse:9.0f} {l1:5.2f} {elapsed:9.2f}", flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the arena_layout offset allocator used by CMSIS-Stream
+buffer sharing.
+
+Run:  python3 Tests/test_arena_layout.py
+"""
+
+import ast
+import os
+import random
+import sys
+
+# Extract arena_layout directly from description.py source via AST,
+# bypassing heavy module-level imports (networkx, numpy, sympy, jinja2)
+_desc_path = os.path.join(
+    os.path.dirname(__file__), '..', 'PythonPackage',
+    'cmsis_stream', 'cg', 'scheduler', 'description.py',
+)
+with open(_desc_path) as _f:
+    _tree = ast.parse(_f.read(), filename=_desc_path)
+for _node in _tree.body:
+    if isinstance(_node, ast.FunctionDef) and _node.name == 'arena_layout':
+        _code = compile(ast.Module(body=[_node], type_ignores=[]), _desc_path, 'exec')
+        _ns: dict = {}
+        exec(_code, _ns)  # noqa: P204
+        arena_layout = _ns['arena_layout']
+        break
+else:
+    raise ImportError("arena_layout not found in description.py")
+
+
+# ---------- helpers ----------
+
+def layout_intervals(intervals, alignment=1):
+    """Layout of (name, start, stop, size) intervals, biggest first."""
+    conflicts = {n: set() for n, _, _, _ in intervals}
+    for i in range(len(intervals)):
+        for j in range(i + 1, len(intervals)):
+            n1, s1, e1, _ = intervals[i]
+            n2, s2, e2, _ = intervals[j]
+            if s1 <= e2 and s2 <= e1:
+                conflicts[n1].add(n2)
+                conflicts[n2].add(n1)
+    blocks = sorted(((n, size, alignment) for n, _, _, size in intervals),
+                    key=lambda b: -b[1])
+    offsets, size = arena_layout(blocks, conflicts)
+    return offsets, size, conflicts
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+def check_no_overlap(intervals, offsets, conflicts, arena_size):
+    sizes = {n: size for n, _, _, size in intervals}
+    for n in offsets:
+        check(offsets[n] + sizes[n] <= arena_size, f"{n} outside of arena")
+        for o in conflicts[n]:
+            disjoint = (offsets[n] + sizes[n] <= offsets[o] or
+                        offsets[o] + sizes[o] <= offsets[n])
+            check(disjoint, f"{n} and {o} overlap")
+
+
+def peak(intervals):
+    last = max(stop for _, _, stop, _ in intervals)
+    return max(sum(size for _, start, stop, size in intervals if start <= t <= stop)
+               for t in range(last + 1))
+
+
+# ---------- tests ----------
+
+def test_chain():
+    """src -> a -> b -> c -> sink: only two buffers live at a time."""
+    intervals = [("f0", 0, 1, 20), ("f1", 1, 2, 20), ("f2", 2, 3, 20), ("f3", 3, 4, 20)]
+    offsets, size, conflicts = layout_intervals(intervals)
+    check_no_overlap(intervals, offsets, conflicts, size)
+    check(size == 40, f"expected 40 bytes, got {size}")
+
+
+def test_small_in_big_hole():
+    """Small buffers reuse the space of a big buffer no more live.
+    With coloring, the buffer of a color has the size of its biggest FIFO
+    and the small FIFOs need their own colors."""
+    intervals = [("big", 0, 1, 100), ("a", 2, 3, 40), ("b", 2, 3, 40),
+                 ("c", 0, 3, 10)]
+    offsets, size, conflicts = layout_intervals(intervals)
+    check_no_overlap(intervals, offsets, conflicts, size)
+    check(size == 110, f"expected 110 bytes, got {size}")
+
+
+def test_alignment():
+    intervals = [("f0", 0, 1, 6), ("f1", 0, 1, 6), ("f2", 0, 1, 6)]
+    offsets, size, conflicts = layout_intervals(intervals, alignment=8)
+    check_no_overlap(intervals, offsets, conflicts, size)
+    check(all(o % 8 == 0 for o in offsets.values()), f"unaligned offsets {offsets}")
+
+
+def test_random():
+    """Random live intervals: no overlap and close to the peak."""
+    rnd = random.Random(1)
+    worst = 0.0
+    for _ in range(200):
+        intervals = []
+        for i in range(rnd.randint(1, 40)):
+            start = rnd.randint(0, 50)
+            intervals.append((f"f{i}", start, start + rnd.randint(0, 10),
+                              rnd.choice([4, 16, 64, 256, 1024])))
+        offsets, size, conflicts = layout_intervals(intervals)
+        check_no_overlap(intervals, offsets, conflicts, size)
+        check(size >= peak(intervals), "arena smaller than the peak")
+        worst = max(worst, size / peak(intervals))
+    print(f"  worst arena / peak = {worst:.2f}")
+
+
+# ---------- runner ----------
+
+TESTS = [test_chain, test_small_in_big_hole, test_alignment, test_random]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the buffer sharing of CMSIS-Stream in asynchronous mode
+(Configuration.asyncMemoryOptimization).
+
+The FIFOs sharing memory are checked with random executions of the
+generated scheduler following the assumptions of the analysis.
+
+Run:  python3 Tests/test_async_memory.py
+"""
+
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- helpers ----------
+
+def chain(rates, lengths, fork=False):
+    """src -> n0 -> n1 ... -> sink with rates [(in, out)] for each
+    processing node. With fork, the last output goes to two sinks."""
+    src = Source("src", CType(F32), rates[0][0])
+    nodes = [ProcessingNode(f"n{k}", CType(F32), i, o) for k, (i, o) in enumerate(rates)]
+    sinks = [Sink("sink", CType(F32), rates[-1][1])]
+    if fork:
+        sinks.append(Sink("sink2", CType(F32), rates[-1][1]))
+    g = Graph()
+    outs = [src.o] + [n.o for n in nodes]
+    for k, n in enumerate(nodes):
+        g.connect(outs[k], n.i, fifoAsyncLength=lengths[k])
+    for s in sinks:
+        g.connect(nodes[-1].o, s.i, fifoAsyncLength=lengths[-1])
+    return g, nodes
+
+
+def schedule(g, optimization, maxStates=None):
+    conf = Configuration()
+    conf.fullyAsynchronous = True
+    conf.asyncMemoryOptimization = optimization
+    if maxStates is not None:
+        conf.asyncMemoryMaxStates = maxStates
+    return g.computeSchedule(config=conf)
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+def check_random_runs(g, sched, mayNotSkip=True, nbRuns=50, nbIterations=40):
+    """Run the schedule with random decisions for the nodes that may skip
+    and check that FIFOs sharing memory never contain samples at the
+    same time"""
+    fifos = g._allFIFOs
+    rnd = random.Random(1)
+
+    def extent(f):
+        return (f.bufferOffset, f.bufferOffset + f.theType.bytes * f.length)
+
+    overlapping = []
+    for a in fifos:
+        for b in fifos:
+            if a.fifoID < b.fifoID and a.buffer is b.buffer:
+                sa, ea = extent(a)
+                sb, eb = extent(b)
+                if sa < eb and sb < ea:
+                    overlapping.append((a.fifoID, b.fifoID))
+
+    for _ in range(nbRuns):
+        samples = [f.delay for f in fifos]
+        for _ in range(nbIterations):
+            for nodeID in sched.schedule:
+                inputs, outputs = g._nodeFIFOs[nodeID]
+                node = g._sortedNodes[nodeID]
+                canRun = all(samples[e] >= io.nbSamples for e, io in inputs) and \
+                         all(samples[e] + io.nbSamples <= fifos[e].length for e, io in outputs)
+                if canRun and node.asyncMaySkip and rnd.random() < 0.5:
+                    canRun = False
+                if not canRun:
+                    continue
+                for e, io in inputs:
+                    samples[e] -= io.nbSamples
+                for e, io in outputs:
+                    samples[e] += io.nbSamples
+                for a, b in overlapping:
+                    check(not (samples[a] > 0 and samples[b] > 0),
+                          f"fifo{a} and fifo{b} share memory and contain samples")
+    return overlapping
+
+
+# ---------- tests ----------
+
+def test_chain():
+    """Samples go through the chain before the source runs again"""
+    g, _ = chain([(4, 4), (4, 2), (2, 8), (8, 8)], [4, 4, 2, 8, 8], fork=True)
+    shared = schedule(g, True)
+    overlapping = check_random_runs(g, shared)
+    check(len(overlapping) > 0, "no FIFO is sharing memory")
+
+    g, _ = chain([(4, 4), (4, 2), (2, 8), (8, 8)], [4, 4, 2, 8, 8], fork=True)
+    notShared = schedule(g, False)
+    check(shared.memory < notShared.memory,
+          f"expected less than {notShared.memory} bytes, got {shared.memory}")
+
+
+def test_node_may_skip():
+    """A processing node that may skip keeps its input FIFO alive"""
+    g, nodes = chain([(4, 4), (4, 4), (4, 4)], [8, 8, 8, 8])
+    nodes[1].asyncMaySkip = True
+    sched = schedule(g, True)
+    check_random_runs(g, sched)
+
+
+def test_too_many_states():
+    g, _ = chain([(4, 4), (4, 2), (2, 8), (8, 8)], [4, 4, 2, 8, 8])
+    sched = schedule(g, True, maxStates=2)
+    check(all(f.bufferOffset == 0 for f in g._allFIFOs), "FIFOs are shared")
+    check(len(set(f.bufferID for f in g._allFIFOs)) == len(g._allFIFOs),
+          "FIFOs are sharing a buffer")
+
+
+# ---------- runner ----------
+
+TESTS = [test_chain, test_node_may_skip, test_too_many_states]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the FIFO types generated as template arguments of the
+nodes (Configuration.exactFIFOTypes).
+
+Run:  python3 Tests/test_exact_fifo_types.py
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- helpers ----------
+
+def graph(exact=True):
+    """src -> proc -> window -> sink"""
+    src = Source("src", CType(F32), 2)
+    proc = ProcessingNode("proc", CType(F32), 5, 5)
+    proc.exactFIFOTypes = exact
+    window = SlidingBuffer("window", CType(F32), 10, 5)
+    sink = Sink("sink", CType(F32), 10)
+    g = Graph()
+    g.connect(src.o, proc.i)
+    g.connect(proc.o, window.i)
+    g.connect(window.o, sink.i)
+    return g, proc, window, sink
+
+
+def schedule(g, exact, **options):
+    conf = Configuration()
+    conf.exactFIFOTypes = exact
+    for k, v in options.items():
+        setattr(conf, k, v)
+    return g.computeSchedule(config=conf)
+
+
+def fifos(g, node):
+    ios = [node._inputs[x] for x in node.inputNames] + \
+          [node._outputs[x] for x in node.outputNames]
+    return [g._edgeToFIFO[io.fifo] for io in ios]
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_types():
+    """The FIFO types follow the IO template arguments"""
+    g, proc, window, sink = graph()
+    schedule(g, True)
+    i, o = fifos(g, proc)
+    check(not i.isArray and o.isArray, "unexpected FIFOs")
+    expected = (f"<float,5,float,5,FIFO<float,FIFOSIZE{i.fifoID},0,0>,"
+                f"FIFO<float,FIFOSIZE{o.fifoID},1,0>>")
+    check(proc.ioTemplate() == expected,
+          f"unexpected template {proc.ioTemplate()}")
+    i, o = fifos(g, window)
+    expected = (f"<float,10,5,FIFO<float,FIFOSIZE{i.fifoID},1,0>,"
+                f"FIFO<float,FIFOSIZE{o.fifoID},1,0>>")
+    check(window.ioTemplate() == expected,
+          f"unexpected template {window.ioTemplate()}")
+
+
+def test_not_supported():
+    """A node not supporting the option keeps its template"""
+    g, proc, window, sink = graph(exact=False)
+    schedule(g, True)
+    check(proc.ioTemplate() == "<float,5,float,5>",
+          f"unexpected template {proc.ioTemplate()}")
+    check(sink.ioTemplate() == "<float,10>",
+          f"unexpected template {sink.ioTemplate()}")
+
+
+def test_async():
+    g, proc, window, sink = graph()
+    schedule(g, True, asynchronous=True, FIFOIncrease=50)
+    i, o = fifos(g, proc)
+    expected = (f"<float,5,float,5,FIFO<float,FIFOSIZE{i.fifoID},0,1>,"
+                f"FIFO<float,FIFOSIZE{o.fifoID},0,1>>")
+    check(proc.ioTemplate() == expected,
+          f"unexpected template {proc.ioTemplate()}")
+
+
+def test_disabled():
+    g, proc, window, sink = graph()
+    schedule(g, False)
+    check(proc.ioTemplate() == "<float,5,float,5>",
+          f"unexpected template {proc.ioTemplate()}")
+    check(window.ioTemplate() == "<float,10,5>",
+          f"unexpected template {window.ioTemplate()}")
+
+
+# ---------- runner ----------
+
+TESTS = [test_types, test_not_supported, test_async, test_disabled]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the fusion of the chains of elementwise functions
+(Configuration.fuseElementwiseFunctions).
+
+Run:  python3 Tests/test_fusion.py
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- helpers ----------
+
+def scale_add(rate=64, addRate=64):
+    """srcA -> scale -> add <- srcB ; add -> abs -> sink"""
+    srcA = Source("srcA", CType(F32), rate)
+    srcB = Source("srcB", CType(F32), addRate)
+    scale = Unary("arm_scale_f32", CType(F32), rate)
+    add = Binary("arm_add_f32", CType(F32), addRate)
+    absv = Unary("arm_abs_f32", CType(F32), addRate)
+    sink = Sink("sink", CType(F32), addRate)
+    g = Graph()
+    g.connect(srcA.o, scale.i)
+    g.connect(scale.o, add.ia)
+    g.connect(srcB.o, add.ib)
+    g.connect(add.o, absv.i)
+    g.connect(absv.o, sink.i)
+    return g
+
+
+def schedule(g, fuse):
+    conf = Configuration()
+    conf.fuseElementwiseFunctions = fuse
+    return g.computeSchedule(config=conf)
+
+
+def fused_nodes(g):
+    return [n for n in g._sortedNodes if isinstance(n, FusedFunction)]
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_chain():
+    """scale, add and abs are one node computing in place"""
+    notFused = schedule(scale_add(), False)
+    g = scale_add()
+    fused = schedule(g, True)
+    nodes = fused_nodes(g)
+    check(len(nodes) == 1, f"expected one fused node, got {len(nodes)}")
+    node = nodes[0]
+    check(node.nodeName == "arm_scale_f32_arm_add_f32_arm_abs_f32",
+          f"unexpected name {node.nodeName}")
+    calls = [(f, [a for a in desc if isinstance(a, str)]) for f, desc in node._calls]
+    check(calls == [("arm_scale_f32", ["i0", "o"]),
+                    ("arm_add_f32", ["o", "i1", "o"]),
+                    ("arm_abs_f32", ["o", "o"])],
+          f"unexpected calls {calls}")
+    check(len(g._allFIFOs) == 3, f"expected 3 FIFOs, got {len(g._allFIFOs)}")
+    check(fused.memory < notFused.memory,
+          f"expected less than {notFused.memory} bytes, got {fused.memory}")
+    check(fused.scheduleLength < notFused.scheduleLength,
+          "the schedule is not shorter")
+
+
+def test_rate_mismatch():
+    """Functions with different number of samples are not fused"""
+    g = scale_add(rate=64, addRate=32)
+    schedule(g, True)
+    nodes = fused_nodes(g)
+    check([n.nodeName for n in nodes] == ["arm_add_f32_arm_abs_f32"],
+          f"unexpected fused nodes {[n.nodeName for n in nodes]}")
+
+
+def test_delay():
+    """A connection with a delay is kept"""
+    srcA = Source("srcA", CType(F32), 64)
+    scale = Unary("arm_scale_f32", CType(F32), 64)
+    absv = Unary("arm_abs_f32", CType(F32), 64)
+    sink = Sink("sink", CType(F32), 64)
+    g = Graph()
+    g.connect(srcA.o, scale.i)
+    g.connectWithDelay(scale.o, absv.i, 16)
+    g.connect(absv.o, sink.i)
+    schedule(g, True)
+    check(not fused_nodes(g), "a FIFO with a delay has been removed")
+
+
+def test_disabled():
+    g = scale_add()
+    schedule(g, False)
+    check(not fused_nodes(g), "functions fused without the option")
+
+
+# ---------- runner ----------
+
+TESTS = [test_chain, test_rate_mismatch, test_delay, test_disabled]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the latency between sources and sinks of a synchronous
+schedule (Schedule.latency) and for the "latency" schedule objective.
+
+Run:  python3 Tests/test_latency.py
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- nodes ----------
+
+class TestMix(GenericNode):
+    def __init__(self, name, rateA, rateB, outputRate):
+        GenericNode.__init__(self, name)
+        self.addInput("ia", CType(F32), rateA)
+        self.addInput("ib", CType(F32), rateB)
+        self.addOutput("o", CType(F32), outputRate)
+
+    @property
+    def typeName(self):
+        return "TestMix"
+
+
+# ---------- helpers ----------
+
+def two_sources():
+    """A long multirate path and a short path mixed before the sink"""
+    mic = Source("mic", CType(F32), 16)
+    ref = Source("ref", CType(F32), 5)
+    a = ProcessingNode("a", CType(F32), 32, 32)
+    b = ProcessingNode("b", CType(F32), 8, 8)
+    c = ProcessingNode("c", CType(F32), 64, 16)
+    mix = TestMix("mix", 16, 10, 16)
+    dac = Sink("dac", CType(F32), 24)
+    g = Graph()
+    g.connect(mic.o, a.i)
+    g.connect(a.o, b.i)
+    g.connect(b.o, c.i)
+    g.connect(c.o, mix.ia)
+    g.connect(ref.o, mix.ib)
+    g.connect(mix.o, dac.i)
+    return g
+
+
+def latencies(sched):
+    return {(src.nodeName, sink.nodeName): v for (src, sink), v in sched.latency.items()}
+
+
+def schedule(g, objective="occupancy", sinkPriority=True):
+    conf = Configuration()
+    conf.scheduleObjective = objective
+    conf.sinkPriority = sinkPriority
+    return g.computeSchedule(config=conf)
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_chain():
+    """src -> proc -> sink : 3 node executions"""
+    src = Source("src", CType(F32), 4)
+    proc = ProcessingNode("proc", CType(F32), 4, 4)
+    sink = Sink("sink", CType(F32), 4)
+    g = Graph()
+    g.connect(src.o, proc.i)
+    g.connect(proc.o, sink.i)
+    proc.cost = 10
+    sched = schedule(g)
+    lat = latencies(sched)
+    check(lat == {("src", "sink"): (3, 12)}, f"unexpected latency {lat}")
+
+
+def test_delay():
+    """The samples of the delay are consumed first"""
+    src = Source("src", CType(F32), 4)
+    sink = Sink("sink", CType(F32), 4)
+    g = Graph()
+    g.connectWithDelay(src.o, sink.i, 8)
+    sched = schedule(g)
+    lat = latencies(sched)
+    # The samples are read two iterations after they are written
+    pos = {sched.streamNodes[k].nodeName: t for t, k in enumerate(sched.schedule)}
+    expected = 2 * sched.scheduleLength + pos["sink"] - pos["src"] + 1
+    check(lat[("src", "sink")][0] == expected,
+          f"unexpected latency {lat}, expected {expected}")
+
+
+def test_objective():
+    """The latency objective is never worse than sink prioritization"""
+    sinkPriority = latencies(schedule(two_sources()))
+    latency = latencies(schedule(two_sources(), "latency"))
+    check(max(latency.values()) <= max(sinkPriority.values()),
+          f"{latency} is worse than {sinkPriority}")
+    check(latency[("ref", "dac")] < sinkPriority[("ref", "dac")],
+          f"ref -> dac not improved: {latency}")
+
+
+# ---------- runner ----------
+
+TESTS = [test_chain, test_delay, test_objective]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
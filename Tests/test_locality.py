@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the "locality" schedule objective
+(Configuration.scheduleObjective).
+
+The schedules are executed on the FIFOs of the graph with deterministic
+node functions and the data received by the sinks is compared with the
+default "occupancy" objective.
+
+Run:  python3 Tests/test_locality.py
+"""
+
+import os
+import sys
+from collections import deque
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- helpers ----------
+
+def multirate():
+    """src -> a -> b -> sinkb
+                 \\-> c -> sinkc (with a delay)"""
+    src = Source("src", CType(F32), 5)
+    a = ProcessingNode("a", CType(F32), 2, 3)
+    b = ProcessingNode("b", CType(F32), 4, 4)
+    c = ProcessingNode("c", CType(F32), 6, 2)
+    sinkb = Sink("sinkb", CType(F32), 8)
+    sinkc = Sink("sinkc", CType(F32), 3)
+    g = Graph()
+    g.connect(src.o, a.i)
+    g.connect(a.o, b.i)
+    g.connect(a.o, c.i)
+    g.connect(b.o, sinkb.i)
+    g.connectWithDelay(c.o, sinkc.i, 4)
+    return g
+
+
+def schedule(g, objective):
+    conf = Configuration()
+    conf.scheduleObjective = objective
+    return g.computeSchedule(config=conf)
+
+
+def run(g, sched, nbIterations=4):
+    """Execute the schedule and return the samples received by each sink.
+
+    A source produces a counter. The other nodes produce values
+    depending on all the samples they consume so that any change in the
+    order of the data is visible in the sinks."""
+    fifos = g._allFIFOs
+    content = [deque([0] * f.delay) for f in fifos]
+    counter = 0
+    received = {}
+    for _ in range(nbIterations):
+        for nodeID in sched.schedule:
+            inputs, outputs = g._nodeFIFOs[nodeID]
+            node = g._sortedNodes[nodeID]
+            for e, io in inputs:
+                check(len(content[e]) >= io.nbSamples,
+                      f"{node.nodeName} reads from fifo{e} with too few samples")
+            for e, io in outputs:
+                check(len(content[e]) + io.nbSamples <= fifos[e].length,
+                      f"{node.nodeName} overflows fifo{e}")
+            consumed = []
+            for e, io in inputs:
+                consumed += [content[e].popleft() for _ in range(io.nbSamples)]
+            if not outputs:
+                received.setdefault(node.nodeName, []).extend(consumed)
+            for port, (e, io) in enumerate(outputs):
+                for k in range(io.nbSamples):
+                    if inputs:
+                        value = hash((tuple(consumed), port, k))
+                    else:
+                        value = counter
+                        counter += 1
+                    content[e].append(value)
+        # An iteration brings the FIFOs back to their initial state
+        check([len(c) for c in content] == [f.delay for f in fifos],
+              "FIFOs not back to their initial state after an iteration")
+    return received
+
+
+def executions(sched):
+    return sorted(sched.streamNodes[k].nodeName for k in sched.schedule)
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_valid():
+    """Same node executions and same memory as the default objective"""
+    occupancy = schedule(multirate(), "occupancy")
+    locality = schedule(multirate(), "locality")
+    check(executions(locality) == executions(occupancy),
+          "the node executions are not the same")
+    check(locality.memory == occupancy.memory,
+          f"memory {locality.memory} instead of {occupancy.memory}")
+
+
+def test_same_output():
+    """The sinks receive the same data as with the default objective"""
+    g = multirate()
+    occupancy = run(g, schedule(g, "occupancy"))
+    g = multirate()
+    locality = run(g, schedule(g, "locality"))
+    check(set(locality) == {"sinkb", "sinkc"}, f"unexpected sinks {list(locality)}")
+    for name, samples in occupancy.items():
+        check(len(samples) > 0, f"{name} received nothing")
+        check(locality[name] == samples, f"{name} received different data")
+
+
+# ---------- runner ----------
+
+TESTS = [test_valid, test_same_output]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
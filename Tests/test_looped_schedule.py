@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the looped_schedule compression used by CMSIS-Stream
+to generate the schedule as nested loops (Configuration.nestedLoops).
+
+Run:  python3 Tests/test_looped_schedule.py
+"""
+
+import ast
+import os
+import random
+import sys
+
+# Extract looped_schedule directly from description.py source via AST,
+# bypassing heavy module-level imports (networkx, numpy, sympy, jinja2)
+_desc_path = os.path.join(
+    os.path.dirname(__file__), '..', 'PythonPackage',
+    'cmsis_stream', 'cg', 'scheduler', 'description.py',
+)
+with open(_desc_path) as _f:
+    _tree = ast.parse(_f.read(), filename=_desc_path)
+for _node in _tree.body:
+    if isinstance(_node, ast.FunctionDef) and _node.name == 'looped_schedule':
+        _code = compile(ast.Module(body=[_node], type_ignores=[]), _desc_path, 'exec')
+        _ns: dict = {}
+        exec(_code, _ns)  # noqa: P204
+        looped_schedule = _ns['looped_schedule']
+        break
+else:
+    raise ImportError("looped_schedule not found in description.py")
+
+
+# ---------- helpers ----------
+
+def expand(items):
+    """Flat schedule of nested loops."""
+    result = []
+    for item in items:
+        if isinstance(item, tuple):
+            count, body = item
+            result.extend(expand(body) * count)
+        else:
+            result.append(item)
+    return result
+
+
+def nb_calls(items):
+    """Number of node calls in the generated code."""
+    return sum(nb_calls(item[1]) if isinstance(item, tuple) else 1
+               for item in items)
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_single_appearance():
+    """(3 src)(2 proc)(sink)"""
+    loops = looped_schedule([0, 0, 0, 1, 1, 2])
+    check(loops == [(3, [0]), (2, [1]), 2], f"unexpected loops {loops}")
+
+
+def test_nested():
+    """(2 (3 a) b) is better than (3 a) b (3 a) b"""
+    schedule = [0, 0, 0, 1, 0, 0, 0, 1]
+    loops = looped_schedule(schedule)
+    check(loops == [(2, [(3, [0]), 1])], f"unexpected loops {loops}")
+
+
+def test_merged_counts():
+    """(2 (3 a)) is (6 a)"""
+    loops = looped_schedule([0] * 6)
+    check(loops == [(6, [0])], f"unexpected loops {loops}")
+
+
+def test_max_period():
+    schedule = list(range(10)) * 4
+    check(looped_schedule(schedule, maxPeriod=10) == [(4, list(range(10)))],
+          "period not found")
+    check(looped_schedule(schedule, maxPeriod=9) == schedule,
+          "period longer than maxPeriod")
+
+
+def test_random():
+    """Compression is lossless and never adds node calls."""
+    rnd = random.Random(1)
+    for _ in range(200):
+        schedule = []
+        for _ in range(rnd.randint(0, 20)):
+            schedule.extend([rnd.randint(0, 4)] * rnd.randint(1, 6))
+        if schedule and rnd.random() < 0.5:
+            schedule = schedule * rnd.randint(2, 4)
+        loops = looped_schedule(schedule)
+        check(expand(loops) == schedule, f"{loops} is not {schedule}")
+        check(nb_calls(loops) <= len(schedule), "more calls than the schedule")
+
+
+# ---------- runner ----------
+
+TESTS = [test_single_appearance, test_nested, test_merged_counts,
+         test_max_period, test_random]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the measured node costs (Configuration.nodeCosts), the
+predicted iteration time and the partition of a schedule on several
+threads (Schedule.partition).
+
+Run:  python3 Tests/test_node_costs.py
+"""
+
+import json
+import os
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+
+
+# ---------- helpers ----------
+
+def two_chains():
+    """One source duplicated to two processing -> sink chains"""
+    g = Graph()
+    src = Source("src", CType(F32), 4)
+    for k in ["a", "b"]:
+        proc = ProcessingNode(f"proc{k}", CType(F32), 4, 4)
+        sink = Sink(f"sink{k}", CType(F32), 4)
+        g.connect(src.o, proc.i)
+        g.connect(proc.o, sink.i)
+    return g
+
+
+def schedule(g, costs, **options):
+    conf = Configuration()
+    conf.nodeCosts = costs
+    for k, v in options.items():
+        setattr(conf, k, v)
+    return g.computeSchedule(config=conf), conf
+
+
+COSTS = {"nodes": [{"name": "proca", "cost": 100},
+                   {"name": "procb", "cost": 100},
+                   {"name": "src", "cost": 1},
+                   {"name": "sinka", "cost": 1},
+                   {"name": "sinkb", "cost": 1}]}
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_names():
+    s, _ = schedule(two_chains(), COSTS)
+    # The duplicate node keeps its default cost of 1
+    check(s.iterationTime == 204, f"unexpected time {s.iterationTime}")
+
+
+def test_profiler_json():
+    """JSON written by StreamNodeProfiler::writeJSON"""
+    s, _ = schedule(two_chains(), None)
+    ids = {node.nodeName: node.codeID for node in s.streamNodes}
+    profile = {"nodes": [{"id": ids["proca"], "count": 10, "skips": 0,
+                          "total_ns": 5000, "min_ns": 400, "max_ns": 600,
+                          "mean_ns": 500, "p99_ns": 600}]}
+    with tempfile.TemporaryDirectory() as d:
+        path = os.path.join(d, "profile.json")
+        with open(path, "w") as f:
+            json.dump(profile, f)
+        # Same graph scheduled again
+        s, _ = schedule(two_chains(), path)
+    proc = [node for node in s.streamNodes if node.nodeName == "proca"][0]
+    check(proc.cost == 500, f"unexpected cost {proc.cost}")
+    # Nodes without measurement keep their cost
+    check(s.iterationTime == 505, f"unexpected time {s.iterationTime}")
+
+
+def test_errors():
+    for costs in [{"nodes": [{"name": "unknown", "cost": 1}]},
+                  {"nodes": [{"id": 100, "mean_ns": 1}]},
+                  {"nodes": [{"name": "proca"}]}]:
+        try:
+            schedule(two_chains(), costs)
+        except NodeCostError:
+            continue
+        check(False, f"costs not rejected {costs}")
+
+
+def test_partition():
+    s, _ = schedule(two_chains(), COSTS)
+    threads, time = s.partition(1)
+    check(time == 204, f"unexpected time {time}")
+    check(sorted(threads[0]) == sorted(s.schedule),
+          "one thread must run all the executions")
+    threads, time = s.partition(2)
+    check(time == 103, f"unexpected time {time}")
+    names = [[s.streamNodes[n].nodeName for n in t] for t in threads]
+    check(("proca" in names[0]) != ("procb" in names[0]),
+          f"unexpected partition {names}")
+
+
+def test_dependencies():
+    """A consumer waits for all the executions producing its samples"""
+    src = Source("src", CType(F32), 1)
+    proc = ProcessingNode("proc", CType(F32), 3, 3)
+    sink = Sink("sink", CType(F32), 3)
+    g = Graph()
+    g.connect(src.o, proc.i)
+    g.connect(proc.o, sink.i)
+    src.cost = 10
+    proc.cost = 5
+    sink.cost = 1
+    s, _ = schedule(g, {"nodes": []})
+    threads, time = s.partition(3)
+    check(time == 36, f"unexpected time {time}")
+
+
+def test_header():
+    s, conf = schedule(two_chains(), COSTS)
+    with tempfile.TemporaryDirectory() as d:
+        s.ccode(d, conf)
+        with open(os.path.join(d, "scheduler.h")) as f:
+            header = f.read()
+    check("#define PREDICTED_ITERATION_TIME 204" in header,
+          "predicted time not in the header")
+
+
+def test_disabled():
+    s, conf = schedule(two_chains(), None)
+    check(s.iterationTime == 6, f"unexpected time {s.iterationTime}")
+    with tempfile.TemporaryDirectory() as d:
+        s.ccode(d, conf)
+        with open(os.path.join(d, "scheduler.h")) as f:
+            header = f.read()
+    check("PREDICTED_ITERATION_TIME" not in header,
+          "predicted time in the header")
+
+
+# ---------- runner ----------
+
+TESTS = [test_names, test_profiler_json, test_errors, test_partition,
+         test_dependencies, test_header, test_disabled]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
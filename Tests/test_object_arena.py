@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the order of the FIFOs and nodes in the arena
+(Configuration.objectArena).
+
+Run:  python3 Tests/test_object_arena.py
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'PythonPackage'))
+
+from cmsis_stream.cg.scheduler import *
+# Source, Sink and ProcessingNode
+from test_nodes import *
+from cmsis_stream.cg.scheduler.ccode import mkArenaObjects
+
+
+# ---------- helpers ----------
+
+def chain():
+    """src -> proc -> neg -> sink"""
+    src = Source("src", CType(F32), 2)
+    proc = ProcessingNode("proc", CType(F32), 4, 3)
+    neg = Unary("arm_negate_f32", CType(F32), 3)
+    sink = Sink("sink", CType(F32), 3)
+    g = Graph()
+    g.connect(src.o, proc.i)
+    g.connect(proc.o, neg.i)
+    g.connect(neg.o, sink.i)
+    conf = Configuration()
+    conf.heapAllocation = True
+    conf.objectArena = True
+    return g.computeSchedule(config=conf)
+
+
+def names(objects):
+    return [("fifo%d" % o) if kind == "fifo" else o.nodeName
+            for kind, o in objects]
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_first_use():
+    """Objects are placed in the order of their first use"""
+    sched = chain()
+    objects = names(mkArenaObjects(sched, list(range(len(sched._graph._allFIFOs)))))
+    check(objects == ["src", "fifo0", "proc", "fifo1", "fifo2", "sink"],
+          f"unexpected order {objects}")
+
+
+def test_fifo_objects():
+    """Only the FIFOs having an object are placed"""
+    sched = chain()
+    objects = names(mkArenaObjects(sched, [0, 2]))
+    check(objects == ["src", "fifo0", "proc", "fifo2", "sink"],
+          f"unexpected order {objects}")
+
+
+# ---------- runner ----------
+
+TESTS = [test_first_use, test_fifo_objects]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the static_fifo_offsets computation used by CMSIS-Stream
+to generate FIFO buffers at generation time (Configuration.staticFIFOs).
+
+Run:  python3 Tests/test_static_fifos.py
+"""
+
+import ast
+import os
+import random
+import sys
+
+# Extract static_fifo_offsets directly from description.py source via AST,
+# bypassing heavy module-level imports (networkx, numpy, sympy, jinja2)
+_desc_path = os.path.join(
+    os.path.dirname(__file__), '..', 'PythonPackage',
+    'cmsis_stream', 'cg', 'scheduler', 'description.py',
+)
+with open(_desc_path) as _f:
+    _tree = ast.parse(_f.read(), filename=_desc_path)
+for _node in _tree.body:
+    if isinstance(_node, ast.FunctionDef) and _node.name == 'static_fifo_offsets':
+        _code = compile(ast.Module(body=[_node], type_ignores=[]), _desc_path, 'exec')
+        _ns: dict = {}
+        exec(_code, _ns)  # noqa: P204
+        static_fifo_offsets = _ns['static_fifo_offsets']
+        break
+else:
+    raise ImportError("static_fifo_offsets not found in description.py")
+
+
+# ---------- helpers ----------
+
+def replay(accesses, length, delay, nbIterations=4):
+    """Run the generated code several iterations with the samples
+    numbered in write order and check that the reads get the samples
+    in order."""
+    start, offsets, moves, end = static_fifo_offsets(accesses, length, delay)
+    check(0 <= start and start + delay <= length, f"bad start {start}")
+    buffer = [None] * length
+    # The delay samples are zeros
+    for k in range(delay):
+        buffer[start + k] = ("delay", k)
+    expected = [("delay", k) for k in range(delay)]
+    written = 0
+    for _ in range(nbIterations):
+        for (nb, isWrite), offset, move in zip(accesses, offsets, moves):
+            if move is not None:
+                src, n = move
+                buffer[0:n] = buffer[src:src + n]
+            check(0 <= offset and offset + nb <= length,
+                  f"access {offset}:{offset + nb} outside of the FIFO")
+            if isWrite:
+                for k in range(nb):
+                    buffer[offset + k] = written
+                    expected.append(written)
+                    written += 1
+            else:
+                got = buffer[offset:offset + nb]
+                check(got == expected[:nb], f"read {got}, expected {expected[:nb]}")
+                expected = expected[nb:]
+        if end is not None:
+            src, n = end
+            buffer[0:n] = buffer[src:src + n]
+    return start, offsets, moves, end
+
+
+def random_accesses(rnd):
+    """Consistent accesses of a FIFO written by a node and read by
+    another one. Return (accesses, length, delay)"""
+    w = rnd.randint(1, 7)
+    r = rnd.randint(1, 7)
+    k = rnd.randint(1, 3)
+    nbWrites = r * k
+    nbReads = w * k
+    delay = rnd.choice([0, 0, rnd.randint(1, 8)])
+    samples = delay
+    maxSamples = delay
+    accesses = []
+    while nbWrites > 0 or nbReads > 0:
+        canRead = nbReads > 0 and samples >= r
+        if nbWrites > 0 and (not canRead or rnd.random() < 0.5):
+            accesses.append((w, True))
+            samples += w
+            nbWrites -= 1
+        else:
+            accesses.append((r, False))
+            samples -= r
+            nbReads -= 1
+        maxSamples = max(maxSamples, samples)
+    return accesses, maxSamples + rnd.randint(0, 3), delay
+
+
+def check(condition, msg):
+    if not condition:
+        print(f"  FAIL: {msg}")
+        raise AssertionError(msg)
+
+
+# ---------- tests ----------
+
+def test_array():
+    """A FIFO written and read once is always used from the start"""
+    start, offsets, moves, end = replay([(4, True), (4, False)], 4, 0)
+    check(offsets == [0, 0], f"unexpected offsets {offsets}")
+    check(moves == [None, None] and end is None, "unexpected moves")
+
+
+def test_no_move():
+    """The samples are not moved when there is space after them"""
+    accesses = [(3, True), (2, False), (3, True), (2, False), (2, False)]
+    start, offsets, moves, end = replay(accesses, 6, 0)
+    check(offsets == [0, 0, 3, 2, 4], f"unexpected offsets {offsets}")
+    check(all(m is None for m in moves), f"unexpected moves {moves}")
+
+
+def test_move():
+    """The remaining samples are moved when the FIFO end is reached"""
+    accesses = [(3, True), (2, False), (3, True), (3, False),
+                (3, True), (2, False), (2, False)]
+    start, offsets, moves, end = replay(accesses, 5, 0)
+    check(moves == [None, None, (2, 1), None, (3, 1), None, None],
+          f"unexpected moves {moves}")
+
+
+def test_delay():
+    """The delay samples are placed so that all iterations are identical"""
+    start, offsets, moves, end = replay([(4, True), (4, False)], 8, 4)
+    check(end is None, f"unexpected end move {end}")
+
+
+def test_random():
+    rnd = random.Random(1)
+    for _ in range(500):
+        accesses, length, delay = random_accesses(rnd)
+        replay(accesses, length, delay)
+
+
+# ---------- runner ----------
+
+TESTS = [test_array, test_no_move, test_move, test_delay, test_random]
+
+
+def main():
+    passed = 0
+    failed = 0
+    for t in TESTS:
+        name = t.__name__
+        try:
+            t()
+            print(f"PASS  {name}")
+            passed += 1
+        except AssertionError as e:
+            print(f"FAIL  {name}: {e}")
+            failed += 1
+    print(f"\n{passed} passed, {failed} failed")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -120,6 +120,8 @@ namespace arm_cmsis_stream
 
         void setBuffer(T *buffer) final override{ mBuffer = buffer; };
 
+        bool isArray() const final override { return false; };
+
         void reset() final override
         {
             readPos = 0;
@@ -296,6 +298,8 @@ namespace arm_cmsis_stream
 
         void setBuffer(T *buffer)  final override { mBuffer = buffer; };
 
+        bool isArray() const final override { return false; };
+
         void reset() final override
         {
             readPos = 0;
@@ -386,6 +390,106 @@ namespace arm_cmsis_stream
         const int delay_;
     };
 
+    /* FIFO of a static synchronous schedule.
+
+       The read and write offsets for each step of the schedule
+       are computed when the code is generated. The scheduler sets
+       the read and write buffers before the execution of a node
+       when they change.
+       So there is no position update and no memcpy in the FIFO.
+    */
+    template <typename T, int length>
+    class StaticFIFO : public FIFOBase<T>
+    {
+    public:
+        explicit StaticFIFO(T *buffer, int readOffset = 0, int writeOffset = 0) : mBuffer(buffer),
+                                                                                  mRead(buffer + readOffset),
+                                                                                  mWrite(buffer + writeOffset),
+                                                                                  readOffset_(readOffset),
+                                                                                  writeOffset_(writeOffset) {};
+        explicit StaticFIFO(void *buffer, int readOffset = 0, int writeOffset = 0) : StaticFIFO((T *)buffer, readOffset, writeOffset) {};
+
+        void setBuffer(T *buffer) final override
+        {
+            mBuffer = buffer;
+            reset();
+        };
+
+        bool isArray() const final override { return false; };
+
+        void reset() final override
+        {
+            mRead = mBuffer + readOffset_;
+            mWrite = mBuffer + writeOffset_;
+        };
+
+        /*
+        FIFO are fixed and not made to be copied or moved.
+        */
+        StaticFIFO(const StaticFIFO &) = delete;
+        StaticFIFO(StaticFIFO &&) = delete;
+        StaticFIFO &operator=(const StaticFIFO &) = delete;
+        StaticFIFO &operator=(StaticFIFO &&) = delete;
+
+        /* Used by the scheduler */
+        void setReadBuffer(T *buffer) { mRead = buffer; };
+        void setWriteBuffer(T *buffer) { mWrite = buffer; };
+
+        /*
+           Only used in synchronous mode
+           so empty functions are provided.
+        */
+        bool willUnderflowWith(int nb) const final
+        {
+            (void)nb;
+            return false;
+        };
+        bool willOverflowWith(int nb) const final
+        {
+            (void)nb;
+            return false;
+        };
+        int nbSamplesInFIFO() const final { return (0); };
+        int nbOfFreeSamplesInFIFO() const final { return (0); };
+
+        T *getWriteBuffer(int nb) final
+        {
+            (void)nb;
+            return (mWrite);
+        };
+
+        T *getReadBuffer(int nb) final
+        {
+            (void)nb;
+            return (mRead);
+        }
+
+#ifdef DEBUGSCHED
+        void dump()
+        {
+            int nb = 0;
+            std::cout << std::endl;
+            for (int i = 0; i < length; i++)
+            {
+                std::cout << (typename Debug<T>::type)mBuffer[i] << " ";
+                nb++;
+                if (nb == 10)
+                {
+                    nb = 0;
+                    std::cout << std::endl;
+                }
+            }
+            std::cout << std::endl;
+            std::cout << std::endl;
+        }
+#endif
+
+    protected:
+        T *mBuffer;
+        T *mRead, *mWrite;
+        const int readOffset_, writeOffset_;
+    };
+
     /***************
      *
      * GENERIC NODES
@@ -417,11 +521,19 @@ namespace arm_cmsis_stream
         kCBStatus mExecutionStatus = kNewExecution;
     };
 
-    template <typename IN, int inputSize, typename OUT, int outputSize>
+    /*
+       The FIFO types SRC and DST are FIFOBase by default and the
+       FIFO functions are virtual calls.
+       When the code generator knows the exact FIFO classes (option
+       exactFIFOTypes), a node forwarding those template arguments
+       calls the final FIFO functions directly and they can be inlined.
+    */
+    template <typename IN, int inputSize, typename OUT, int outputSize,
+              typename SRC = FIFOBase<IN>, typename DST = FIFOBase<OUT>>
     class GenericNode : public NodeBase
     {
     public:
-        explicit GenericNode(FIFOBase<IN> &src, FIFOBase<OUT> &dst) : mSrc(src), mDst(dst) {};
+        explicit GenericNode(SRC &src, DST &dst) : mSrc(src), mDst(dst) {};
 
     protected:
         OUT *getWriteBuffer(int nb = outputSize) { return mDst.getWriteBuffer(nb); };
@@ -434,8 +546,8 @@ namespace arm_cmsis_stream
         bool isWriteArray() const { return mDst.isArray(); };
 
     private:
-        FIFOBase<IN> &mSrc;
-        FIFOBase<OUT> &mDst;
+        SRC &mSrc;
+        DST &mDst;
     };
 
     template <typename IN, int inputSize,
@@ -515,12 +627,13 @@ namespace arm_cmsis_stream
         const std::vector<FIFOBase<OUT> *> mDstList;
     };
 
-    template <typename IN, int inputSize, typename OUT1, int output1Size, typename OUT2, int output2Size>
+    template <typename IN, int inputSize, typename OUT1, int output1Size, typename OUT2, int output2Size,
+              typename SRC = FIFOBase<IN>, typename DST1 = FIFOBase<OUT1>, typename DST2 = FIFOBase<OUT2>>
     class GenericNode12 : public NodeBase
     {
     public:
-        explicit GenericNode12(FIFOBase<IN> &src, FIFOBase<OUT1> &dst1, FIFOBase<OUT2> &dst2) : mSrc(src),
-                                                                                                mDst1(dst1), mDst2(dst2) {};
+        explicit GenericNode12(SRC &src, DST1 &dst1, DST2 &dst2) : mSrc(src),
+                                                                   mDst1(dst1), mDst2(dst2) {};
 
     protected:
         OUT1 *getWriteBuffer1(int nb = output1Size) { return mDst1.getWriteBuffer(nb); };
@@ -537,23 +650,27 @@ namespace arm_cmsis_stream
         bool isWriteArray2() const { return mDst2.isArray(); };
 
     private:
-        FIFOBase<IN> &mSrc;
-        FIFOBase<OUT1> &mDst1;
-        FIFOBase<OUT2> &mDst2;
+        SRC &mSrc;
+        DST1 &mDst1;
+        DST2 &mDst2;
     };
 
     template <typename IN, int inputSize,
               typename OUT1, int output1Size,
               typename OUT2, int output2Size,
-              typename OUT3, int output3Size>
+              typename OUT3, int output3Size,
+              typename SRC = FIFOBase<IN>,
+              typename DST1 = FIFOBase<OUT1>,
+              typename DST2 = FIFOBase<OUT2>,
+              typename DST3 = FIFOBase<OUT3>>
     class GenericNode13 : public NodeBase
     {
     public:
-        explicit GenericNode13(FIFOBase<IN> &src,
-                               FIFOBase<OUT1> &dst1,
-                               FIFOBase<OUT2> &dst2,
-                               FIFOBase<OUT3> &dst3) : mSrc(src),
-                                                       mDst1(dst1), mDst2(dst2), mDst3(dst3) {};
+        explicit GenericNode13(SRC &src,
+                               DST1 &dst1,
+                               DST2 &dst2,
+                               DST3 &dst3) : mSrc(src),
+                                             mDst1(dst1), mDst2(dst2), mDst3(dst3) {};
 
     protected:
         OUT1 *getWriteBuffer1(int nb = output1Size) { return mDst1.getWriteBuffer(nb); };
@@ -574,19 +691,20 @@ namespace arm_cmsis_stream
         bool isWriteArray3() const { return mDst3.isArray(); };
 
     private:
-        FIFOBase<IN> &mSrc;
-        FIFOBase<OUT1> &mDst1;
-        FIFOBase<OUT2> &mDst2;
-        FIFOBase<OUT3> &mDst3;
+        SRC &mSrc;
+        DST1 &mDst1;
+        DST2 &mDst2;
+        DST3 &mDst3;
     };
 
-    template <typename IN1, int input1Size, typename IN2, int input2Size, typename OUT, int outputSize>
+    template <typename IN1, int input1Size, typename IN2, int input2Size, typename OUT, int outputSize,
+              typename SRC1 = FIFOBase<IN1>, typename SRC2 = FIFOBase<IN2>, typename DST = FIFOBase<OUT>>
     class GenericNode21 : public NodeBase
     {
     public:
-        explicit GenericNode21(FIFOBase<IN1> &src1, FIFOBase<IN2> &src2, FIFOBase<OUT> &dst) : mSrc1(src1),
-                                                                                               mSrc2(src2),
-                                                                                               mDst(dst) {};
+        explicit GenericNode21(SRC1 &src1, SRC2 &src2, DST &dst) : mSrc1(src1),
+                                                                   mSrc2(src2),
+                                                                   mDst(dst) {};
 
     protected:
         OUT *getWriteBuffer(int nb = outputSize) { return mDst.getWriteBuffer(nb); };
@@ -602,22 +720,26 @@ namespace arm_cmsis_stream
         bool isWriteArray() const { return mDst.isArray(); };
 
     private:
-        FIFOBase<IN1> &mSrc1;
-        FIFOBase<IN2> &mSrc2;
-        FIFOBase<OUT> &mDst;
+        SRC1 &mSrc1;
+        SRC2 &mSrc2;
+        DST &mDst;
     };
 
     template <typename IN1, int input1Size,
               typename IN2, int input2Size,
               typename IN3, int input3Size,
-              typename OUT, int outputSize>
+              typename OUT, int outputSize,
+              typename SRC1 = FIFOBase<IN1>,
+              typename SRC2 = FIFOBase<IN2>,
+              typename SRC3 = FIFOBase<IN3>,
+              typename DST = FIFOBase<OUT>>
     class GenericNode31 : public NodeBase
     {
     public:
-        explicit GenericNode31(FIFOBase<IN1> &src1,
-                               FIFOBase<IN2> &src2,
-                               FIFOBase<IN3> &src3,
-                               FIFOBase<OUT> &dst) : mSrc1(src1),
+        explicit GenericNode31(SRC1 &src1,
+                               SRC2 &src2,
+                               SRC3 &src3,
+                               DST &dst) : mSrc1(src1),
                                                      mSrc2(src2),
                                                      mSrc3(src3),
                                                      mDst(dst) {};
@@ -639,18 +761,18 @@ namespace arm_cmsis_stream
         bool isWriteArray() const { return mDst.isArray(); };
 
     private:
-        FIFOBase<IN1> &mSrc1;
-        FIFOBase<IN2> &mSrc2;
-        FIFOBase<IN3> &mSrc3;
+        SRC1 &mSrc1;
+        SRC2 &mSrc2;
+        SRC3 &mSrc3;
 
-        FIFOBase<OUT> &mDst;
+        DST &mDst;
     };
 
-    template <typename OUT, int outputSize>
+    template <typename OUT, int outputSize, typename DST = FIFOBase<OUT>>
     class GenericSource : public NodeBase
     {
     public:
-        explicit GenericSource(FIFOBase<OUT> &dst) : mDst(dst) {};
+        explicit GenericSource(DST &dst) : mDst(dst) {};
 
     protected:
         OUT *getWriteBuffer(int nb = outputSize) { return mDst.getWriteBuffer(nb); };
@@ -659,14 +781,14 @@ namespace arm_cmsis_stream
 
         bool isWriteArray() const { return mDst.isArray(); };
     private:
-        FIFOBase<OUT> &mDst;
+        DST &mDst;
     };
 
-    template <typename IN, int inputSize>
+    template <typename IN, int inputSize, typename SRC = FIFOBase<IN>>
     class GenericSink : public NodeBase
     {
     public:
-        explicit GenericSink(FIFOBase<IN> &src) : mSrc(src) {};
+        explicit GenericSink(SRC &src) : mSrc(src) {};
 
     protected:
         IN *getReadBuffer(int nb = inputSize) { return mSrc.getReadBuffer(nb); };
@@ -675,7 +797,7 @@ namespace arm_cmsis_stream
 
         bool isReadArray() const  { return mSrc.isArray(); };
     private:
-        FIFOBase<IN> &mSrc;
+        SRC &mSrc;
     };
 
 #define REPEAT(N) for (int i = 0; i < N; i++)
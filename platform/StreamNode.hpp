@@ -205,7 +205,7 @@ namespace arm_cmsis_stream
         // using the mem server
         int lock() const
         {
-            if (MemServer::mem_server != nullptr)
+            if (MemServer::mem_server == nullptr)
             {
                 return -1; // Error: IPCLock not used
             }
@@ -219,7 +219,7 @@ namespace arm_cmsis_stream
 
         int read_lock() const
         {
-            if (MemServer::mem_server != nullptr)
+            if (MemServer::mem_server == nullptr)
             {
                 return -1; // Error: IPCLock not used
             }
@@ -233,7 +233,7 @@ namespace arm_cmsis_stream
 
         int unlock() const
         {
-            if (MemServer::mem_server != nullptr)
+            if (MemServer::mem_server == nullptr)
             {
                 return -1; // Error: IPCLock not initialized or not used
             }
@@ -247,7 +247,7 @@ namespace arm_cmsis_stream
 
         int read_unlock() const
         {
-            if (MemServer::mem_server != nullptr)
+            if (MemServer::mem_server == nullptr)
             {
                 return -1; // Error: IPCLock not initialized or not used
             }
@@ -261,7 +261,7 @@ namespace arm_cmsis_stream
 
         int32_t refcount() const
         {
-            if (MemServer::mem_server != nullptr)
+            if (MemServer::mem_server == nullptr)
             {
                 return -1; // Error: IPCLock not initialized or not used
             }
@@ -308,6 +308,7 @@ namespace arm_cmsis_stream
         {
             if (this != &other)
             {
+                delete fd_;
                 fd_ = std::move(other.fd_);
                 other.fd_ = nullptr;
             }
@@ -392,9 +393,14 @@ namespace arm_cmsis_stream
             return (err);
         }
 
+        // Only the first access is mapping the buffer. After, it
+        // is just a pointer test.
         void mapBuffer() const
         {
-            fd_->mapDescriptor();
+            if (fd_->data() == nullptr)
+            {
+                fd_->mapDescriptor();
+            }
         }
 
         int32_t process_refcount() const
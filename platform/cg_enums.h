@@ -53,7 +53,8 @@ extern "C"
         CG_STOP_SCHEDULER = -8,            /**< Stop scheduling */
         CG_PAUSED_SCHEDULER = -9,           /**< Pause scheduler in callback mode */
         CG_EVENT_QUEUE_FULL = -10,          /**< Event queue is full, event can't be pushed */
-        CG_RESUME_FAILURE = -11             /**< Runtime thread could not resume */
+        CG_RESUME_FAILURE = -11,            /**< Runtime thread could not resume */
+        CG_SHARED_FIFO_CONFLICT = -12       /**< FIFOs sharing memory contain samples at the same time (asynchronous mode) */
     } cg_status;
 
     // genJsonSelectors must be updated in description.py for any new default selector
@@ -7,7 +7,7 @@
  * Target Processor: Cortex-M and Cortex-A cores
  * --------------------------------------------------------------------
  *
- * Copyright (C) 2023-2025 ARM Limited or its affiliates. All rights reserved.
+ * Copyright (C) 2023-2026 ARM Limited or its affiliates. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -31,6 +31,22 @@
 #include <variant>
 #include <string>
 #include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+// File descriptors are only received with a frame (SCM_RIGHTS) on
+// POSIX systems
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define CG_PACK_RECEIVED_DESCRIPTORS
+#endif
+
+#ifndef CG_RECV_FRAME_MAX
+#define CG_RECV_FRAME_MAX 8
+#endif
 
 namespace arm_cmsis_stream
 {
@@ -63,38 +79,27 @@ namespace arm_cmsis_stream
     };
 
     /*
-    
-    Below implementations could be made more efficient if they were
-    integrating directly with the mechanism used to transmit / receive
-    on networks. Some copies could be avoided.
-    
-    */
 
-    class Pack
-    {
-    public:
-        Pack() = default;
+    Events are packed in two ways:
 
-        Pack(const std::vector<uint8_t> &data) : serialized_object(data) {}
+    - Pack builds the serialized event in a std::vector
+    - packedSize computes the exact size of the serialized event
+      and pack writes it into a caller provided buffer without
+      any heap allocation.
 
-        Pack(std::vector<uint8_t> &&data) : serialized_object(std::move(data)) {}
-
-        const std::vector<uint8_t> &vector() const { return serialized_object; }
+    PackEncoder contains the encoding and is parameterized by
+    the sink receiving the bytes.
 
-        void reset()
-        {
-            serialized_object.clear();
-        }
-
-        size_t size() const
-        {
-            return serialized_object.size();
-        }
+    */
 
+    template <typename Sink>
+    class PackEncoder
+    {
+    public:
         // If we send an event outside on the network
         // the shared buffers are not transmitted so we should not
         // acquire them
-        void pack(uint32_t nodeid, Event evt,bool network=false)
+        void pack(uint32_t nodeid, const Event &evt, bool network = false)
         {
             write_value((uint32_t)nodeid);
             write_value((uint32_t)evt.event_id);
@@ -117,23 +122,32 @@ namespace arm_cmsis_stream
         };
 
     protected:
+        // Values are stored in little endian whatever the host.
+        // The byte array is written with one store by the sink.
+        void write_bytes(const void *d, std::size_t nb)
+        {
+            static_cast<Sink *>(this)->write_bytes(static_cast<const uint8_t *>(d), nb);
+        }
+
         void write_value(uint8_t res)
         {
-            serialized_object.emplace_back(uint8_t(res & 0xFF));
+            write_bytes(&res, 1);
         }
 
         void write_value(uint16_t res)
         {
-            serialized_object.emplace_back(uint8_t(res & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 8) & 0xFF));
+            const uint8_t b[2] = {uint8_t(res & 0xFF),
+                                  uint8_t((res >> 8) & 0xFF)};
+            write_bytes(b, sizeof(b));
         }
 
         void write_value(uint32_t res)
         {
-            serialized_object.emplace_back(uint8_t(res & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 8) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 16) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 24) & 0xFF));
+            const uint8_t b[4] = {uint8_t(res & 0xFF),
+                                  uint8_t((res >> 8) & 0xFF),
+                                  uint8_t((res >> 16) & 0xFF),
+                                  uint8_t((res >> 24) & 0xFF)};
+            write_bytes(b, sizeof(b));
         }
 
         void write_value(int32_t val)
@@ -145,21 +159,29 @@ namespace arm_cmsis_stream
 
         void write_value(uint64_t res)
         {
-            serialized_object.emplace_back(uint8_t(res & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 8) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 16) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 24) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 32) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 40) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 48) & 0xFF));
-            serialized_object.emplace_back(uint8_t((res >> 56) & 0xFF));
+            const uint8_t b[8] = {uint8_t(res & 0xFF),
+                                  uint8_t((res >> 8) & 0xFF),
+                                  uint8_t((res >> 16) & 0xFF),
+                                  uint8_t((res >> 24) & 0xFF),
+                                  uint8_t((res >> 32) & 0xFF),
+                                  uint8_t((res >> 40) & 0xFF),
+                                  uint8_t((res >> 48) & 0xFF),
+                                  uint8_t((res >> 56) & 0xFF)};
+            write_bytes(b, sizeof(b));
         }
 
         template <typename T>
         void pack_array(const T *d, std::size_t nbelems)
         {
             write_value((uint32_t)nbelems);
-            serialized_object.insert(serialized_object.end(), (uint8_t *)d, (uint8_t *)(d + nbelems));
+            write_bytes(d, nbelems * sizeof(T));
+        }
+
+        // Called for each shared buffer that is not packed for the
+        // network. A sink sending the file descriptors with the frame
+        // (SCM_RIGHTS) records them.
+        void record_descriptor(const Descriptor &)
+        {
         }
 
         template <typename T>
@@ -173,10 +195,15 @@ namespace arm_cmsis_stream
                 write_value((uint32_t)nbelems);
                 write_value((int32_t)(buf.getDescriptor()->global_id()));
 
-                if ((MemServer::mem_server != nullptr) && (!network))
+                if ((MemServer::mem_server != nullptr) && (!network) &&
+                    Sink::acquire_shared_buffers)
                 {
                     MemServer::mem_server->acquire(buf.getDescriptor()->global_id());
                 }
+                if (!network)
+                {
+                    static_cast<Sink *>(this)->record_descriptor(*buf.getDescriptor());
+                }
                 return;
             }
             // If file descriptor is not valid, we write 0 elements for this buffer
@@ -188,7 +215,7 @@ namespace arm_cmsis_stream
         void pack_array(const std::array<T, N> &t)
         {
             write_value((uint32_t)N);
-            serialized_object.insert(serialized_object.end(), (uint8_t *)t.data(), (uint8_t *)(t.data() + N));
+            write_bytes(t.data(), N * sizeof(T));
         }
 
         template <typename T>
@@ -433,8 +460,641 @@ namespace arm_cmsis_stream
             }
         }
 
+    };
+
+    class Pack : public PackEncoder<Pack>
+    {
+    public:
+        Pack() = default;
+
+        Pack(const std::vector<uint8_t> &data) : serialized_object(data) {}
+
+        Pack(std::vector<uint8_t> &&data) : serialized_object(std::move(data)) {}
+
+        const std::vector<uint8_t> &vector() const { return serialized_object; }
+
+        void reset()
+        {
+            serialized_object.clear();
+        }
+
+        size_t size() const
+        {
+            return serialized_object.size();
+        }
+
+    protected:
+        friend class PackEncoder<Pack>;
+        static constexpr bool acquire_shared_buffers = true;
+
+        void write_bytes(const uint8_t *d, std::size_t nb)
+        {
+            serialized_object.insert(serialized_object.end(), d, d + nb);
+        }
+
+    private:
+        std::vector<uint8_t> serialized_object;
+    };
+
+    // Only count the bytes. Shared buffers are not acquired
+    // since nothing is sent.
+    class PackSize : public PackEncoder<PackSize>
+    {
+    public:
+        std::size_t size() const { return size_; }
+
+    protected:
+        friend class PackEncoder<PackSize>;
+        static constexpr bool acquire_shared_buffers = false;
+
+        void write_bytes(const uint8_t *, std::size_t nb)
+        {
+            size_ += nb;
+        }
+
+    private:
+        std::size_t size_ = 0;
+    };
+
+    // Write into a caller provided buffer (span, ring slot ...)
+    class PackInto : public PackEncoder<PackInto>
+    {
+    public:
+        PackInto(uint8_t *dst, std::size_t capacity) : dst_(dst), capacity_(capacity) {}
+
+        std::size_t size() const { return pos_; }
+
+        // True if the buffer was too small. Nothing is written after
+        // the first overflow.
+        bool overflow() const { return overflow_; }
+
+    protected:
+        friend class PackEncoder<PackInto>;
+        static constexpr bool acquire_shared_buffers = true;
+
+        void write_bytes(const uint8_t *d, std::size_t nb)
+        {
+            if (overflow_ || (nb > capacity_ - pos_))
+            {
+                overflow_ = true;
+                return;
+            }
+            memcpy(dst_ + pos_, d, nb);
+            pos_ += nb;
+        }
+
+    private:
+        uint8_t *dst_;
+        std::size_t capacity_;
+        std::size_t pos_ = 0;
+        bool overflow_ = false;
+    };
+
+    // Exact number of bytes written by pack for this event
+    inline std::size_t packedSize(uint32_t nodeid, const Event &evt, bool network = false)
+    {
+        PackSize counter;
+        counter.pack(nodeid, evt, network);
+        return counter.size();
+    }
+
+    // Serialize the event into dst.
+    // Return the number of bytes written or 0 if capacity is too
+    // small (use packedSize to get the required capacity).
+    // The size is checked before packing: the shared buffers are
+    // acquired for the receiver when written and would not be released
+    // if the write overflowed.
+    inline std::size_t pack(uint32_t nodeid, const Event &evt,
+                            uint8_t *dst, std::size_t capacity,
+                            bool network = false)
+    {
+        if (packedSize(nodeid, evt, network) > capacity)
+        {
+            return 0;
+        }
+        PackInto writer(dst, capacity);
+        writer.pack(nodeid, evt, network);
+        if (writer.overflow())
+        {
+            return 0;
+        }
+        return writer.size();
+    }
+
+    /*
+
+    Batch frame
+
+    Several events packed in one frame to reduce the per frame
+    overhead. The frame starts with kBatchFrameMarker in place of the
+    node ID of a single event, followed by the number of events. Each
+    event is then preceded by its packed length.
+
+    */
+    constexpr uint32_t kBatchFrameMarker = 0xFFFFFFFEu;
+
+    class PackBatch : public PackEncoder<PackBatch>
+    {
+    public:
+        PackBatch()
+        {
+            reset();
+        }
+
+        const std::vector<uint8_t> &vector() const { return serialized_object; }
+
+        void reset()
+        {
+            serialized_object.clear();
+            descriptors_.clear();
+            nb_events_ = 0;
+            write_value(kBatchFrameMarker);
+            write_value(uint32_t(0));
+        }
+
+        // When enabled, the file descriptors of the shared buffers
+        // are recorded in packing order so that they can be sent with
+        // the frame. They are owned by the events: the events must be
+        // kept alive until the frame is sent.
+        void collectDescriptors(bool enable)
+        {
+            collect_descriptors_ = enable;
+        }
+
+        const std::vector<NativeHandle> &descriptors() const
+        {
+            return descriptors_;
+        }
+
+        size_t size() const
+        {
+            return serialized_object.size();
+        }
+
+        uint32_t nb_events() const
+        {
+            return nb_events_;
+        }
+
+        void add(uint32_t nodeid, const Event &evt, bool network = false)
+        {
+            const std::size_t start = serialized_object.size();
+            write_value(uint32_t(0));
+            PackEncoder<PackBatch>::pack(nodeid, evt, network);
+            patch(start, (uint32_t)(serialized_object.size() - start - 4));
+            nb_events_++;
+            patch(4, nb_events_);
+        }
+
+    protected:
+        friend class PackEncoder<PackBatch>;
+        static constexpr bool acquire_shared_buffers = true;
+
+        void write_bytes(const uint8_t *d, std::size_t nb)
+        {
+            serialized_object.insert(serialized_object.end(), d, d + nb);
+        }
+
+        void record_descriptor(const Descriptor &d)
+        {
+            if (collect_descriptors_)
+            {
+                descriptors_.push_back(d.fd());
+            }
+        }
+
+        void patch(std::size_t pos, uint32_t v)
+        {
+            serialized_object[pos] = uint8_t(v & 0xFF);
+            serialized_object[pos + 1] = uint8_t((v >> 8) & 0xFF);
+            serialized_object[pos + 2] = uint8_t((v >> 16) & 0xFF);
+            serialized_object[pos + 3] = uint8_t((v >> 24) & 0xFF);
+        }
+
     private:
         std::vector<uint8_t> serialized_object;
+        std::vector<NativeHandle> descriptors_;
+        uint32_t nb_events_ = 0;
+        bool collect_descriptors_ = false;
+    };
+
+    // Same layout as POSIX struct iovec
+    struct cg_iovec
+    {
+        const void *base;
+        std::size_t len;
+    };
+
+    /*
+
+    Scatter / gather serialization.
+
+    The small fields are packed into a header buffer and the payloads of
+    copy buffers and tensors are not copied: the segment list points
+    directly at their storage. The bytes described by the segments are the
+    same as the ones produced by Pack.
+
+    The writer is called with the segments while the read lock of all the
+    buffers of the event is held:
+
+    bool writer(const cg_iovec *segments, std::size_t nb_segments, std::size_t total_size)
+
+    so it can transmit the event with one writev / sendmsg.
+    The same buffer must not be present twice in an event since its lock
+    would be taken twice.
+
+    */
+    class PackGather : public PackEncoder<PackGather>
+    {
+    public:
+        // If withLength is true, the segments start with the 32 bits
+        // length of the packed event (the framing used with the host).
+        // Return false if a buffer could not be locked or if the writer failed.
+        template <typename Writer>
+        bool pack(uint32_t nodeid, const Event &evt, Writer &&writer,
+                  bool network = false, bool withLength = false)
+        {
+            header_.clear();
+            segments_.clear();
+            header_start_ = 0;
+            network_ = network;
+            with_length_ = withLength;
+
+            if (withLength)
+            {
+                write_value(uint32_t(0));
+            }
+            write_value((uint32_t)nodeid);
+            write_value((uint32_t)evt.event_id);
+            write_value((uint8_t)evt.priority);
+            if (std::holds_alternative<cg_value>(evt.data))
+            {
+                write_value(uint8_t(0));
+                return gather(&std::get<cg_value>(evt.data), 1, 0, writer);
+            }
+            else if (std::holds_alternative<UniquePtr<ListValue>>(evt.data))
+            {
+                write_value(uint8_t(1));
+                const ListValue &cv = *std::get<UniquePtr<ListValue>>(evt.data).get();
+                write_value(cv.nb_values);
+                return gather(cv.values.data(), cv.nb_values, 0, writer);
+            }
+            return finish(writer);
+        }
+
+    protected:
+        friend class PackEncoder<PackGather>;
+        static constexpr bool acquire_shared_buffers = true;
+
+        struct Segment
+        {
+            // nullptr for a segment of the header
+            const void *payload;
+            std::size_t offset;
+            std::size_t len;
+        };
+
+        void write_bytes(const uint8_t *d, std::size_t nb)
+        {
+            header_.insert(header_.end(), d, d + nb);
+        }
+
+        void close_header_segment()
+        {
+            if (header_.size() > header_start_)
+            {
+                segments_.push_back({nullptr, header_start_, header_.size() - header_start_});
+            }
+            header_start_ = header_.size();
+        }
+
+        void add_payload(const void *d, std::size_t nb)
+        {
+            close_header_segment();
+            if (nb > 0)
+            {
+                segments_.push_back({d, 0, nb});
+            }
+        }
+
+        template <typename T>
+        static constexpr uint8_t value_type()
+        {
+            using U = std::remove_const_t<T>;
+            if constexpr (std::is_same_v<U, int8_t>)
+                return kInt8;
+            else if constexpr (std::is_same_v<U, int16_t>)
+                return kInt16;
+            else if constexpr (std::is_same_v<U, int32_t>)
+                return kInt32;
+            else if constexpr (std::is_same_v<U, int64_t>)
+                return kInt64;
+            else if constexpr (std::is_same_v<U, uint8_t>)
+                return kUInt8;
+            else if constexpr (std::is_same_v<U, uint16_t>)
+                return kUInt16;
+            else if constexpr (std::is_same_v<U, uint32_t>)
+                return kUInt32;
+            else if constexpr (std::is_same_v<U, uint64_t>)
+                return kUInt64;
+            else if constexpr (std::is_same_v<U, float>)
+                return kFloat;
+            else
+                return kDouble;
+        }
+
+        // Values are packed in order. When a buffer is met, the remaining
+        // values are packed from inside its read lock so that all
+        // the locks are still held when the writer is called.
+        template <typename Writer>
+        bool gather(const cg_value *values, uint32_t nb, uint32_t i, Writer &writer)
+        {
+            for (; i < nb; i++)
+            {
+                const cg_value &val = values[i];
+                if (std::holds_alternative<BufferPtr>(val.value))
+                {
+                    return gather_buffer(std::get<BufferPtr>(val.value), values, nb, i, writer);
+                }
+                else if (std::holds_alternative<cg_any_tensor>(val.value))
+                {
+                    return std::visit([&](const auto &t)
+                                      { return gather_tensor(t, values, nb, i, writer); },
+                                      std::get<cg_any_tensor>(val.value));
+                }
+                else if (std::holds_alternative<cg_any_const_tensor>(val.value))
+                {
+                    return std::visit([&](const auto &t)
+                                      { return gather_tensor(t, values, nb, i, writer); },
+                                      std::get<cg_any_const_tensor>(val.value));
+                }
+                PackEncoder<PackGather>::pack(val, network_);
+            }
+            return finish(writer);
+        }
+
+        template <typename Writer>
+        bool gather_buffer(const BufferPtr &r, const cg_value *values,
+                           uint32_t nb, uint32_t i, Writer &writer)
+        {
+            write_value(uint8_t(kAny));
+            bool lockError;
+            bool ok = r.lock_shared(lockError, [&](const RawBuffer &v) -> bool
+                                    {
+                if (std::holds_alternative<UniquePtr<std::byte>>(v.data))
+                {
+                    const UniquePtr<std::byte> &buf = std::get<UniquePtr<std::byte>>(v.data);
+                    write_value(uint8_t(kCopyBuffer));
+                    write_value((uint32_t)v.buf_size);
+                    add_payload(buf.get(), v.buf_size);
+                }
+                else if (std::holds_alternative<SharedBuffer<std::byte>>(v.data))
+                {
+                    const SharedBuffer<std::byte> &buf = std::get<SharedBuffer<std::byte>>(v.data);
+                    write_value(uint8_t(kSharedBuffer));
+                    this->pack_shared(buf, v.buf_size, network_);
+                }
+                return gather(values, nb, i + 1, writer); });
+            return ok && !lockError;
+        }
+
+        template <typename T, typename Writer>
+        bool gather_tensor(const TensorPtr<T> &t, const cg_value *values,
+                           uint32_t nb, uint32_t i, Writer &writer)
+        {
+            write_value(uint8_t(kTensor));
+            bool lockError;
+            bool ok = t.lock_shared(lockError, [&](const Tensor<T> &v) -> bool
+                                    {
+                write_value(v.nb_dims);
+                this->template pack_array<uint32_t, CG_TENSOR_NB_DIMS>(v.dims);
+                write_value(value_type<T>());
+                if (std::holds_alternative<SharedBuffer<T>>(v.data))
+                {
+                    const SharedBuffer<T> &buf = std::get<SharedBuffer<T>>(v.data);
+                    write_value(uint8_t(kSharedBuffer));
+                    this->pack_shared(buf, v.size(), network_);
+                }
+                else if (std::holds_alternative<UniquePtr<T>>(v.data))
+                {
+                    const UniquePtr<T> &buf = std::get<UniquePtr<T>>(v.data);
+                    write_value(uint8_t(kCopyBuffer));
+                    write_value((uint32_t)v.size());
+                    add_payload(buf.get(), v.size() * sizeof(T));
+                }
+                return gather(values, nb, i + 1, writer); });
+            return ok && !lockError;
+        }
+
+        template <typename Writer>
+        bool finish(Writer &writer)
+        {
+            close_header_segment();
+            std::size_t total = 0;
+            iov_.clear();
+            for (const Segment &seg : segments_)
+            {
+                const void *base = seg.payload;
+                if (base == nullptr)
+                {
+                    base = header_.data() + seg.offset;
+                }
+                iov_.push_back({base, seg.len});
+                total += seg.len;
+            }
+            if (with_length_)
+            {
+                const uint32_t msg_len = (uint32_t)(total - 4);
+                header_[0] = uint8_t(msg_len & 0xFF);
+                header_[1] = uint8_t((msg_len >> 8) & 0xFF);
+                header_[2] = uint8_t((msg_len >> 16) & 0xFF);
+                header_[3] = uint8_t((msg_len >> 24) & 0xFF);
+            }
+            return writer(iov_.data(), iov_.size(), total);
+        }
+
+    private:
+        // Storage is reused between events
+        std::vector<uint8_t> header_;
+        std::vector<Segment> segments_;
+        std::vector<cg_iovec> iov_;
+        std::size_t header_start_ = 0;
+        bool network_ = false;
+        bool with_length_ = false;
+    };
+
+    /*
+
+    Receive buffer that can be aliased by the tensors and raw buffers
+    created by Unpack (zero copy mode).
+
+    The frame is reference counted: one reference for the receiver and one
+    for each unpacked buffer pointing inside the frame. Those buffers are
+    UniquePtr using release_payload as deleter. Since the deleter only gets
+    the payload address, live frames are recorded in a small table to find
+    the frame containing the payload.
+
+    When the table is full (CG_RECV_FRAME_MAX frames still referenced by
+    unpacked buffers), the frame is not recorded and Unpack copies the
+    payloads as in the copy mode.
+
+    */
+    class RecvFrame
+    {
+    public:
+        // Return nullptr if allocation failed
+        static RecvFrame *create(std::size_t size)
+        {
+            RecvFrame *frame = new (std::nothrow) RecvFrame();
+            if (frame == nullptr)
+            {
+                return nullptr;
+            }
+            frame->raw_ = static_cast<uint8_t *>(std::malloc(size + frame_alignment));
+            if (frame->raw_ == nullptr)
+            {
+                delete frame;
+                return nullptr;
+            }
+            uintptr_t base = reinterpret_cast<uintptr_t>(frame->raw_);
+            std::size_t pad = (data_shift + frame_alignment - (base % frame_alignment)) % frame_alignment;
+            frame->data_ = frame->raw_ + pad;
+            frame->size_ = size;
+
+            CG_MUTEX_ERROR_TYPE error;
+            CG_ENTER_CRITICAL_SECTION(frames_mutex_, error);
+            if (!CG_MUTEX_HAS_ERROR(error))
+            {
+                for (int i = 0; i < CG_RECV_FRAME_MAX; i++)
+                {
+                    if (frames_[i] == nullptr)
+                    {
+                        frames_[i] = frame;
+                        frame->recorded_ = true;
+                        break;
+                    }
+                }
+            }
+            CG_EXIT_CRITICAL_SECTION(frames_mutex_, error);
+
+            return frame;
+        }
+
+        uint8_t *data() noexcept { return data_; }
+        const uint8_t *data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+
+        // Release the receiver reference
+        void release()
+        {
+            if (refcount_.fetch_sub(1) == 1)
+            {
+                destroy();
+            }
+        }
+
+        // Deleter of a UniquePtr aliasing a payload inside a frame
+        static void release_payload(void *p)
+        {
+            const uint8_t *ptr = static_cast<const uint8_t *>(p);
+            RecvFrame *frame = nullptr;
+            CG_MUTEX_ERROR_TYPE error;
+            CG_ENTER_CRITICAL_SECTION(frames_mutex_, error);
+            if (!CG_MUTEX_HAS_ERROR(error))
+            {
+                for (int i = 0; i < CG_RECV_FRAME_MAX; i++)
+                {
+                    RecvFrame *f = frames_[i];
+                    if ((f != nullptr) && (ptr >= f->data_) && (ptr < f->data_ + f->size_))
+                    {
+                        frame = f;
+                        break;
+                    }
+                }
+            }
+            CG_EXIT_CRITICAL_SECTION(frames_mutex_, error);
+            if (frame != nullptr)
+            {
+                frame->release();
+            }
+        }
+
+    protected:
+        friend class Unpack;
+
+        RecvFrame() = default;
+
+        void acquire()
+        {
+            refcount_.fetch_add(1);
+        }
+
+        // False if the frame can't be aliased by the unpacked buffers
+        bool zero_copy() const noexcept
+        {
+            return recorded_;
+        }
+
+        void destroy()
+        {
+            if (!recorded_)
+            {
+                std::free(raw_);
+                delete this;
+                return;
+            }
+            CG_MUTEX_ERROR_TYPE error;
+            CG_ENTER_CRITICAL_SECTION(frames_mutex_, error);
+            if (!CG_MUTEX_HAS_ERROR(error))
+            {
+                for (int i = 0; i < CG_RECV_FRAME_MAX; i++)
+                {
+                    if (frames_[i] == this)
+                    {
+                        frames_[i] = nullptr;
+                        break;
+                    }
+                }
+            }
+            CG_EXIT_CRITICAL_SECTION(frames_mutex_, error);
+            std::free(raw_);
+            delete this;
+        }
+
+    private:
+        // The frame data is placed so that the payload of a tensor sent
+        // alone in an event is aligned on frame_alignment bytes.
+        // Payload starts after nodeid, event id, priority, data case,
+        // kTensor, nb dims, dims array, datatype, buffer type and length.
+        static constexpr std::size_t frame_alignment = 16;
+        static constexpr std::size_t data_shift =
+            (frame_alignment - ((22 + 4 * CG_TENSOR_NB_DIMS) % frame_alignment)) % frame_alignment;
+
+        uint8_t *raw_ = nullptr;
+        uint8_t *data_ = nullptr;
+        std::size_t size_ = 0;
+        std::atomic<uint32_t> refcount_ = 1;
+        bool recorded_ = false;
+
+        inline static RecvFrame *frames_[CG_RECV_FRAME_MAX] = {};
+        inline static CG_MUTEX frames_mutex_;
+    };
+
+    /*
+
+    File descriptors received with a frame (SCM_RIGHTS).
+
+    They are used in order for the shared buffers of the frame with
+    Descriptor::mk_new_descriptor in place of MemServer::get_buffer. The
+    descriptor created takes the reference acquired by the sender.
+    The receiver still owns the file descriptors from next to nb.
+
+    */
+    struct ReceivedDescriptors
+    {
+        const NativeHandle *fds;
+        uint32_t nb;
+        uint32_t next;
     };
 
     class Unpack
@@ -444,6 +1104,19 @@ namespace arm_cmsis_stream
 
         Unpack(const uint8_t *data, std::size_t size) : data_pointer(data) {}
 
+        // Zero copy mode: tensors and raw buffers reference the frame
+        // when their payload is correctly aligned. Otherwise the payload
+        // is copied.
+        // The frame can be released by the receiver as soon as
+        // the events have been unpacked.
+        Unpack(RecvFrame *frame, std::size_t offset = 0)
+            : data_pointer(frame->data() + offset), frame_(frame) {}
+
+        void setDescriptors(ReceivedDescriptors *descriptors)
+        {
+            descriptors_ = descriptors;
+        }
+
         Event unpack(uint32_t &nodeid)
         {
             nodeid = read_value<uint32_t>();
@@ -524,6 +1197,15 @@ namespace arm_cmsis_stream
         template <typename T>
         UniquePtr<T> make_typed_buffer(std::size_t n)
         {
+            if ((frame_ != nullptr) && frame_->zero_copy() && (n > 0) &&
+                ((reinterpret_cast<uintptr_t>(data_pointer) % alignof(T)) == 0))
+            {
+                frame_->acquire();
+                UniquePtr<T> buf(reinterpret_cast<T *>(const_cast<uint8_t *>(data_pointer)),
+                                 RecvFrame::release_payload);
+                data_pointer += n * sizeof(T);
+                return buf;
+            }
             UniquePtr<T> buf(n);
             read_buffer<T>(buf.get(), n);
             return buf;
@@ -531,18 +1213,56 @@ namespace arm_cmsis_stream
 
         UniquePtr<std::byte> make_raw_buffer(std::size_t n)
         {
-            UniquePtr<std::byte> buf(n);
-            read_buffer<std::byte>(buf.get(), n);
-            return buf;
+            return make_typed_buffer<std::byte>(n);
         }
 
         std::shared_ptr<char> make_string_buffer(std::size_t n)
         {
-            std::shared_ptr<char> buf(new char[n]);
+            std::shared_ptr<char> buf(new char[n], std::default_delete<char[]>());
             read_buffer<char>((char *)buf.get(), n);
             return buf;
         }
 
+        Descriptor *shared_descriptor(int32_t global_id, std::size_t size)
+        {
+            if ((descriptors_ != nullptr) && (descriptors_->next < descriptors_->nb) &&
+                (Descriptor::mk_new_descriptor != nullptr))
+            {
+                NativeHandle fd = descriptors_->fds[descriptors_->next++];
+                Descriptor *desc = Descriptor::mk_new_descriptor(fd, size, global_id);
+                if (desc == nullptr)
+                {
+                    // The receiver only closes the descriptors not yet
+                    // used and nobody takes the reference of the sender
+#ifdef CG_PACK_RECEIVED_DESCRIPTORS
+                    ::close(fd);
+#endif
+                    if (MemServer::mem_server != nullptr)
+                    {
+                        MemServer::mem_server->release(global_id);
+                    }
+                }
+                return desc;
+            }
+
+            if (MemServer::mem_server == nullptr)
+            {
+                return nullptr;
+            }
+            Descriptor *fd = MemServer::mem_server->get_buffer(global_id);
+            if (fd == nullptr)
+            {
+                return nullptr;
+            }
+            // Buffer was acquired by the pack so that the buffer
+            // is not destroyed during IPC where no process may have a
+            // file descriptor to the buffer.
+            // Now that we have a reference with get_buffer we can
+            // release the additional reference
+            MemServer::mem_server->release(global_id);
+            return fd;
+        }
+
         template <typename T>
         cg_value unpack_tensor(uint8_t nb_dims,
                                const cg_tensor_dims_t &dims)
@@ -567,21 +1287,11 @@ namespace arm_cmsis_stream
                     return cg_value();
                 }
 
-                if (MemServer::mem_server == nullptr)
-                {
-                    return cg_value();
-                }
-                Descriptor *fd = MemServer::mem_server->get_buffer(global_id);
+                Descriptor *fd = shared_descriptor(global_id, buf_size);
                 if (fd == nullptr)
                 {
                     return cg_value();
                 }
-                // Buffer was acquired by the pack so that the buffer
-                // is not destroyed during IPC where no process may have a
-                // file descriptor to the buffer.
-                // Now that we have a reference with get_buffer we can
-                // release the additional reference
-                MemServer::mem_server->release(global_id);
 
                 // Create a shared buffer with the file descriptor
                 SharedBuffer<std::byte> ptr(fd);
@@ -660,19 +1370,12 @@ namespace arm_cmsis_stream
                         return cg_value();
                     }
 
-                    if (MemServer::mem_server == nullptr)
-                    {
-                        return cg_value();
-                    }
-
-                    Descriptor *fd = MemServer::mem_server->get_buffer(global_id);
+                    Descriptor *fd = shared_descriptor(global_id, buf_size);
                     if (fd == nullptr)
                     {
                         return cg_value();
                     }
 
-                    MemServer::mem_server->release(global_id);
-                    
                     SharedBuffer<std::byte> ptr(fd);
                     BufferPtr t = BufferPtr::create_with(std::move(ptr));
                     return t;
@@ -743,6 +1446,101 @@ namespace arm_cmsis_stream
 
     private:
         const uint8_t *data_pointer = nullptr;
+        RecvFrame *frame_ = nullptr;
+        ReceivedDescriptors *descriptors_ = nullptr;
+    };
+
+    class UnpackBatch
+    {
+    public:
+        UnpackBatch() = delete;
+
+        UnpackBatch(const uint8_t *data, std::size_t size)
+            : data_(data), size_(size)
+        {
+            init();
+        }
+
+        // Zero copy mode (see Unpack)
+        UnpackBatch(RecvFrame *frame)
+            : data_(frame->data()), size_(frame->size()), frame_(frame)
+        {
+            init();
+        }
+
+        // File descriptors received with the frame (see ReceivedDescriptors)
+        void setDescriptors(ReceivedDescriptors *descriptors)
+        {
+            descriptors_ = descriptors;
+        }
+
+        static bool isBatch(const uint8_t *data, std::size_t size)
+        {
+            return ((size >= 8) && (read_u32(data) == kBatchFrameMarker));
+        }
+
+        uint32_t nb_events() const
+        {
+            return nb_events_;
+        }
+
+        // Return false when all events have been read or if
+        // the frame is truncated
+        bool next(uint32_t &nodeid, Event &evt)
+        {
+            if ((current_ >= nb_events_) || (size_ - pos_ < 4))
+            {
+                return false;
+            }
+            const uint32_t len = read_u32(data_ + pos_);
+            pos_ += 4;
+            if (size_ - pos_ < len)
+            {
+                return false;
+            }
+            if (frame_ != nullptr)
+            {
+                Unpack unpack(frame_, pos_);
+                unpack.setDescriptors(descriptors_);
+                evt = unpack.unpack(nodeid);
+            }
+            else
+            {
+                Unpack unpack(data_ + pos_, len);
+                unpack.setDescriptors(descriptors_);
+                evt = unpack.unpack(nodeid);
+            }
+            pos_ += len;
+            current_++;
+            return true;
+        }
+
+    protected:
+        static uint32_t read_u32(const uint8_t *p)
+        {
+            return (uint32_t(p[0]) |
+                    (uint32_t(p[1]) << 8) |
+                    (uint32_t(p[2]) << 16) |
+                    (uint32_t(p[3]) << 24));
+        }
+
+        void init()
+        {
+            if (isBatch(data_, size_))
+            {
+                nb_events_ = read_u32(data_ + 4);
+                pos_ = 8;
+            }
+        }
+
+    private:
+        const uint8_t *data_;
+        std::size_t size_;
+        RecvFrame *frame_ = nullptr;
+        ReceivedDescriptors *descriptors_ = nullptr;
+        std::size_t pos_ = 0;
+        uint32_t nb_events_ = 0;
+        uint32_t current_ = 0;
     };
 
 };
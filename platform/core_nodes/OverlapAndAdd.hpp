@@ -29,11 +29,12 @@
 
 namespace arm_cmsis_stream {
 
-template<typename IN,int windowSize, int overlap>
-class OverlapAdd: public GenericNode<IN,windowSize,IN,windowSize-overlap>
+template<typename IN,int windowSize, int overlap,
+         typename SRC=FIFOBase<IN>,typename DST=FIFOBase<IN>>
+class OverlapAdd: public GenericNode<IN,windowSize,IN,windowSize-overlap,SRC,DST>
 {
 public:
-    OverlapAdd(FIFOBase<IN> &src,FIFOBase<IN> &dst):GenericNode<IN,windowSize,IN,windowSize-overlap>(src,dst)
+    OverlapAdd(SRC &src,DST &dst):GenericNode<IN,windowSize,IN,windowSize-overlap,SRC,DST>(src,dst)
     {
         static_assert((windowSize-overlap)>0, "Overlap is too big");
         memory.resize(overlap);
@@ -29,11 +29,12 @@
 
 namespace arm_cmsis_stream {
 
-template<typename IN,int windowSize, int overlap>
-class SlidingBuffer: public GenericNode<IN,windowSize-overlap,IN,windowSize>
+template<typename IN,int windowSize, int overlap,
+         typename SRC=FIFOBase<IN>,typename DST=FIFOBase<IN>>
+class SlidingBuffer: public GenericNode<IN,windowSize-overlap,IN,windowSize,SRC,DST>
 {
 public:
-    SlidingBuffer(FIFOBase<IN> &src,FIFOBase<IN> &dst):GenericNode<IN,windowSize-overlap,IN,windowSize>(src,dst)
+    SlidingBuffer(SRC &src,DST &dst):GenericNode<IN,windowSize-overlap,IN,windowSize,SRC,DST>(src,dst)
     {
         static_assert((windowSize-overlap)>0, "Overlap is too big");
         memory.resize(overlap);
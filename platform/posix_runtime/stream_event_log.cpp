@@ -0,0 +1,441 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_event_log.cpp
+ * Description:  Event log recording and replay for the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_event_log.hpp"
+
+#include "cg_pack.hpp"
+#include "stream_event_queue.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STREAM_EVENT_LOG_SUPPORTED
+#endif
+
+using namespace arm_cmsis_stream;
+
+thread_local stream_event_origin cg_currentEventOrigin = STREAM_EVENT_FROM_APPLICATION;
+
+static const char log_magic[8] = {'C', 'G', 'E', 'V', 'T', 'L', 'O', 'G'};
+
+/* Kind of a record whose event could not be encoded. Skipped by the replay. */
+static constexpr uint8_t invalid_record_kind = 0xFF;
+
+/*
+ * Set in the origin byte of a record when the event references shared
+ * buffers. Only their global_id is recorded so the replay can't restore them.
+ */
+static constexpr uint8_t shared_buffer_flag = 0x80;
+
+/*
+ * Size of the encoded event and number of shared buffers it references.
+ * The encoding is the same as with network=true but the shared buffers
+ * are reported with record_descriptor. They are not acquired.
+ */
+class LogPackSize : public PackEncoder<LogPackSize> {
+  public:
+    std::size_t size() const { return size_; }
+    uint32_t nbSharedBuffers() const { return nbShared_; }
+
+  protected:
+    friend class PackEncoder<LogPackSize>;
+    static constexpr bool acquire_shared_buffers = false;
+
+    void write_bytes(const uint8_t *, std::size_t nb) { size_ += nb; }
+    void record_descriptor(const Descriptor &) { nbShared_++; }
+
+  private:
+    std::size_t size_ = 0;
+    uint32_t nbShared_ = 0;
+};
+
+static uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+#ifdef STREAM_EVENT_LOG_SUPPORTED
+
+StreamEventLog *StreamEventLog::create(const char *path, std::size_t capacity)
+{
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t total = header_size + capacity;
+    total = (total + page - 1) & ~(page - 1);
+
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        CMSISSTREAM_LOG_ERR("Can't create event log %s\n", path);
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        CMSISSTREAM_LOG_ERR("Can't allocate %zu bytes for event log %s\n", total, path);
+        ::close(fd);
+        return nullptr;
+    }
+    void *base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        CMSISSTREAM_LOG_ERR("Can't map event log %s\n", path);
+        ::close(fd);
+        return nullptr;
+    }
+
+    StreamEventLog *log = new (std::nothrow) StreamEventLog();
+    if (log == nullptr) {
+        munmap(base, total);
+        ::close(fd);
+        return nullptr;
+    }
+
+    log->fd_ = fd;
+    log->base_ = static_cast<uint8_t *>(base);
+    log->capacity_ = total;
+
+    uint32_t v = version;
+    uint32_t h = header_size;
+    memcpy(log->base_, log_magic, 8);
+    memcpy(log->base_ + 8, &v, 4);
+    memcpy(log->base_ + 12, &h, 4);
+    log->reserved_ = header_size;
+    log->flushed_ = 0;
+    log->start_ns_ = now_ns();
+
+    try {
+        log->flusher_ = new (std::nothrow) std::thread(&StreamEventLog::flusherFunction, log);
+    } catch (const std::system_error &) {
+        CMSISSTREAM_LOG_ERR("Can't start the flusher thread of event log %s\n", path);
+        log->flusher_ = nullptr;
+    }
+    if (log->flusher_ == nullptr) {
+        delete log;
+        return nullptr;
+    }
+    return log;
+}
+
+StreamEventLog::~StreamEventLog()
+{
+    if (flusher_ != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(flusher_mutex_);
+            flusher_stop_ = true;
+        }
+        flusher_cv_.notify_one();
+        flusher_->join();
+        delete flusher_;
+        flusher_ = nullptr;
+    }
+    if (base_ != nullptr) {
+        flushRange(true);
+        munmap(base_, capacity_);
+        base_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        (void)ftruncate(fd_, static_cast<off_t>(reserved_));
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool StreamEventLog::record(stream_event_log_kind kind, int32_t nodeid, int port,
+                            const Event &evt)
+{
+    LogPackSize counter;
+    counter.pack(static_cast<uint32_t>(nodeid), evt, false);
+    const std::size_t evt_size = counter.size();
+    // Records are 8 bytes aligned so that the size can be published atomically
+    const std::size_t total = (record_header_size + evt_size + 7) & ~std::size_t(7);
+
+    uint8_t *dst;
+    uint64_t timestamp;
+    {
+        std::lock_guard<std::mutex> lock(reserve_mutex_);
+        // Keep room for the final null record size
+        if (reserved_ + total + 4 > capacity_) {
+            nbDropped_++;
+            return false;
+        }
+        dst = base_ + reserved_;
+        reserved_ += total;
+        timestamp = now_ns() - start_ns_;
+    }
+
+    uint8_t origin = static_cast<uint8_t>(cg_currentEventOrigin);
+    if (counter.nbSharedBuffers() > 0) {
+        origin |= shared_buffer_flag;
+    }
+    uint16_t p = static_cast<uint16_t>(port);
+    memcpy(dst + 4, &timestamp, 8);
+    dst[12] = static_cast<uint8_t>(kind);
+    dst[13] = origin;
+    memcpy(dst + 14, &p, 2);
+
+    if (pack(static_cast<uint32_t>(nodeid), evt, dst + record_header_size, evt_size, true) !=
+        evt_size) {
+        // The event changed between the size computation and the encoding
+        dst[12] = invalid_record_kind;
+    }
+
+    __atomic_store_n(reinterpret_cast<uint32_t *>(dst), static_cast<uint32_t>(total - 4),
+                     __ATOMIC_RELEASE);
+    nbRecords_++;
+    return true;
+}
+
+void StreamEventLog::flushRange(bool synchronous)
+{
+    std::size_t end;
+    {
+        std::lock_guard<std::mutex> lock(reserve_mutex_);
+        end = reserved_;
+    }
+
+    std::lock_guard<std::mutex> lock(flusher_mutex_);
+    if (end > flushed_ || synchronous) {
+        const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t start = synchronous ? 0 : (flushed_ & ~(page - 1));
+        (void)msync(base_ + start, end - start, synchronous ? MS_SYNC : MS_ASYNC);
+        flushed_ = end;
+    }
+}
+
+void StreamEventLog::flusherFunction()
+{
+    std::unique_lock<std::mutex> lock(flusher_mutex_);
+    while (!flusher_stop_) {
+        flusher_cv_.wait_for(lock, std::chrono::milliseconds(CMSISSTREAM_EVENT_LOG_FLUSH_MS),
+                             [this] { return flusher_stop_; });
+        if (flusher_stop_) {
+            break;
+        }
+        lock.unlock();
+        flushRange(false);
+        lock.lock();
+    }
+}
+
+void StreamEventLog::sync()
+{
+    flushRange(true);
+}
+
+std::size_t StreamEventLog::size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    return reserved_;
+}
+
+bool stream_replay_event_log(const char *path,
+                             EventQueue *queue,
+                             stream_replay_node_resolver resolver,
+                             void *resolver_data,
+                             stream_replay_timing timing,
+                             uint32_t origin_mask,
+                             stream_replay_stats_t *stats)
+{
+    stream_replay_stats_t result = {0, 0, 0, 0, 0, false};
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        CMSISSTREAM_LOG_ERR("Can't open event log %s\n", path);
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) ||
+        (static_cast<std::size_t>(st.st_size) < StreamEventLog::header_size)) {
+        ::close(fd);
+        CMSISSTREAM_LOG_ERR("Invalid event log %s\n", path);
+        return false;
+    }
+    const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        CMSISSTREAM_LOG_ERR("Can't map event log %s\n", path);
+        return false;
+    }
+    const uint8_t *base = static_cast<const uint8_t *>(mapping);
+
+    uint32_t v;
+    uint32_t h;
+    memcpy(&v, base + 8, 4);
+    memcpy(&h, base + 12, 4);
+    if ((memcmp(base, log_magic, 8) != 0) || (v != StreamEventLog::version) ||
+        (h > file_size)) {
+        munmap(mapping, file_size);
+        CMSISSTREAM_LOG_ERR("Invalid event log %s\n", path);
+        return false;
+    }
+
+    PosixEventQueue *posix_queue = static_cast<PosixEventQueue *>(queue);
+    const auto start = std::chrono::steady_clock::now();
+    bool first = true;
+    uint64_t first_timestamp = 0;
+    std::size_t pos = h;
+
+    while (pos + StreamEventLog::record_header_size <= file_size) {
+        uint32_t record_size;
+        memcpy(&record_size, base + pos, 4);
+        if ((record_size == 0) || (pos + 4 + record_size > file_size)) {
+            break;
+        }
+        const uint8_t *rec = base + pos;
+        pos += 4 + record_size;
+
+        uint64_t timestamp;
+        uint16_t port;
+        memcpy(&timestamp, rec + 4, 8);
+        const uint8_t kind = rec[12];
+        const uint8_t origin = rec[13];
+        memcpy(&port, rec + 14, 2);
+
+        if ((kind == STREAM_LOG_NODE_EVENT) && ((origin & shared_buffer_flag) != 0)) {
+            result.nb_shared_buffer++;
+            continue;
+        }
+        if ((kind != STREAM_LOG_NODE_EVENT) || (origin >= 32) ||
+            ((origin_mask & STREAM_EVENT_ORIGIN_MASK(origin)) == 0)) {
+            result.nb_skipped++;
+            continue;
+        }
+
+        Unpack unpack(rec + StreamEventLog::record_header_size,
+                      4 + record_size - StreamEventLog::record_header_size);
+        uint32_t nodeid;
+        Event evt = unpack.unpack(nodeid);
+        StreamNode *node = resolver(resolver_data, static_cast<int32_t>(nodeid));
+        if (node == nullptr) {
+            result.nb_unknown_node++;
+            continue;
+        }
+
+        if (timing == STREAM_REPLAY_ORIGINAL_TIMING) {
+            if (first) {
+                first_timestamp = timestamp;
+            }
+            std::this_thread::sleep_until(start +
+                                          std::chrono::nanoseconds(timestamp - first_timestamp));
+        }
+        first = false;
+
+        // The queue is not allowed to overflow: it would be reported as
+        // a runtime error. Half of the queue is left to the events
+        // generated by the graph.
+        while (!posix_queue->hasRoom(evt.priority, (POSIX_QUEUE_MAX_ELEMS + 1) / 2)) {
+            if (queue->mustEnd() || queue->mustPause()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (!queue->push(LocalDestination{node, port}, std::move(evt))) {
+            result.interrupted = true;
+            break;
+        }
+        result.nb_injected++;
+    }
+
+    result.duration_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+            .count());
+    munmap(mapping, file_size);
+    if (stats != nullptr) {
+        *stats = result;
+    }
+    return true;
+}
+
+#else
+
+StreamEventLog *StreamEventLog::create(const char *path, std::size_t capacity)
+{
+    (void)path;
+    (void)capacity;
+    CMSISSTREAM_LOG_ERR("Event log is not supported on this platform\n");
+    return nullptr;
+}
+
+StreamEventLog::~StreamEventLog()
+{
+}
+
+bool StreamEventLog::record(stream_event_log_kind kind, int32_t nodeid, int port,
+                            const Event &evt)
+{
+    (void)kind;
+    (void)nodeid;
+    (void)port;
+    (void)evt;
+    return false;
+}
+
+void StreamEventLog::flushRange(bool synchronous)
+{
+    (void)synchronous;
+}
+
+void StreamEventLog::flusherFunction()
+{
+}
+
+void StreamEventLog::sync()
+{
+}
+
+std::size_t StreamEventLog::size() const noexcept
+{
+    return 0;
+}
+
+bool stream_replay_event_log(const char *path,
+                             EventQueue *queue,
+                             stream_replay_node_resolver resolver,
+                             void *resolver_data,
+                             stream_replay_timing timing,
+                             uint32_t origin_mask,
+                             stream_replay_stats_t *stats)
+{
+    (void)path;
+    (void)queue;
+    (void)resolver;
+    (void)resolver_data;
+    (void)timing;
+    (void)origin_mask;
+    (void)stats;
+    CMSISSTREAM_LOG_ERR("Event log is not supported on this platform\n");
+    return false;
+}
+
+#endif
+
+void StreamEventLog::setAppHandler(void *data, EventQueue::AppHandler handler)
+{
+    appHandlerData_ = data;
+    appHandler_ = handler;
+    EventQueue::setHandler(this, &StreamEventLog::appHandler);
+}
+
+bool StreamEventLog::appHandler(int src_node_id, void *data, Event &&evt)
+{
+    StreamEventLog *log = static_cast<StreamEventLog *>(data);
+    (void)log->record(STREAM_LOG_APP_EVENT, src_node_id, 0, evt);
+    if (log->appHandler_ != nullptr) {
+        return log->appHandler_(src_node_id, log->appHandlerData_, std::move(evt));
+    }
+    return false;
+}
@@ -0,0 +1,191 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_event_log.hpp
+ * Description:  Event log recording and replay for the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "EventQueue.hpp"
+#include "StreamNode.hpp"
+#include "stream_platform_config.hpp"
+#include "stream_runtime_init.hpp"
+
+/*
+ * Who pushed an event. It is used by the replay to only re-inject the
+ * events coming from outside of the graph: the other ones are generated
+ * again by the graph when it processes the replayed events.
+ */
+enum stream_event_origin : uint8_t {
+    /* Thread outside of the runtime (application, host communication) */
+    STREAM_EVENT_FROM_APPLICATION = 0,
+    /* Node or application handler running on an event thread */
+    STREAM_EVENT_FROM_EVENT_HANDLER = 1,
+    /* Node running on a stream (dataflow) thread */
+    STREAM_EVENT_FROM_DATAFLOW = 2
+};
+
+#define STREAM_EVENT_ORIGIN_MASK(origin) (1U << (origin))
+
+extern thread_local stream_event_origin cg_currentEventOrigin;
+
+enum stream_event_log_kind : uint8_t {
+    /* Event pushed to a node input port */
+    STREAM_LOG_NODE_EVENT = 0,
+    /* Event received by the application handler */
+    STREAM_LOG_APP_EVENT = 1
+};
+
+/*
+ * Append-only binary log of the events going through PosixEventQueue::push
+ * and of the events received by the application handler.
+ *
+ * The log is a file of fixed capacity mapped in memory. Each record is
+ * written directly in the mapping and a background thread asynchronously
+ * flushes the dirty pages every CMSISSTREAM_EVENT_LOG_FLUSH_MS.
+ * When the log is full, new events are dropped and counted.
+ *
+ * File layout (little endian):
+ *
+ *   header : "CGEVTLOG", u32 version, u32 header size
+ *   record : u32 size of the record after this field
+ *            u64 timestamp in nanoseconds since the creation of the log
+ *            u8 kind, u8 origin, u16 destination port
+ *            event encoded with cg_pack (node id is the destination node
+ *            for a node event and the source node for an application event).
+ *
+ * Shared buffers are not copied in the log: as with the network encoding of
+ * cg_pack, only their number of elements and global_id are recorded. The
+ * bit 7 of the origin of such a record is set and the replay skips it
+ * since the buffer may no longer exist.
+ *
+ * A record size of 0 ends the log.
+ *
+ * Only available on Linux and macOS. create returns nullptr on other
+ * platforms.
+ */
+class StreamEventLog {
+  public:
+    static constexpr uint32_t version = 2;
+    static constexpr std::size_t header_size = 16;
+    static constexpr std::size_t record_header_size = 16;
+
+    /*
+     * Create (or truncate) the log file with room for capacity bytes.
+     * Return nullptr in case of error.
+     */
+    static StreamEventLog *create(const char *path, std::size_t capacity);
+
+    /* Flush the log, truncate the file to the used size and close it */
+    ~StreamEventLog();
+
+    StreamEventLog(const StreamEventLog &) = delete;
+    StreamEventLog &operator=(const StreamEventLog &) = delete;
+
+    /*
+     * Append an event. Return false if the log is full.
+     * Can be called from any thread.
+     */
+    bool record(stream_event_log_kind kind, int32_t nodeid, int port,
+                const arm_cmsis_stream::Event &evt);
+
+    /*
+     * Install handler as the application handler (as EventQueue::setHandler)
+     * and record all the events it receives.
+     */
+    void setAppHandler(void *data, arm_cmsis_stream::EventQueue::AppHandler handler);
+
+    /* Synchronously write the recorded events to the file */
+    void sync();
+
+    uint64_t nbRecords() const noexcept { return nbRecords_.load(); }
+    uint64_t nbDropped() const noexcept { return nbDropped_.load(); }
+    std::size_t size() const noexcept;
+
+  private:
+    StreamEventLog() = default;
+
+    static bool appHandler(int src_node_id, void *data, arm_cmsis_stream::Event &&evt);
+    void flusherFunction();
+    void flushRange(bool synchronous);
+
+    int fd_ = -1;
+    uint8_t *base_ = nullptr;
+    std::size_t capacity_ = 0;
+
+    mutable std::mutex reserve_mutex_;
+    std::size_t reserved_ = 0;
+    uint64_t start_ns_ = 0;
+
+    std::atomic<uint64_t> nbRecords_ = 0;
+    std::atomic<uint64_t> nbDropped_ = 0;
+
+    std::size_t flushed_ = 0;
+    std::mutex flusher_mutex_;
+    std::condition_variable flusher_cv_;
+    bool flusher_stop_ = false;
+    std::thread *flusher_ = nullptr;
+
+    void *appHandlerData_ = nullptr;
+    arm_cmsis_stream::EventQueue::AppHandler appHandler_ = nullptr;
+};
+
+enum stream_replay_timing {
+    /* Events are injected with the delays of the recording */
+    STREAM_REPLAY_ORIGINAL_TIMING,
+    /* Events are injected as soon as the event queue has room for them */
+    STREAM_REPLAY_AS_FAST_AS_POSSIBLE
+};
+
+typedef struct {
+    /* Events pushed to the event queue */
+    uint64_t nb_injected;
+    /* Events filtered out by the origin mask or application events */
+    uint64_t nb_skipped;
+    /* Events for a node unknown to the resolver */
+    uint64_t nb_unknown_node;
+    /* Node events referencing shared buffers (not restored by the replay) */
+    uint64_t nb_shared_buffer;
+    /* Duration of the replay in nanoseconds */
+    uint64_t duration_ns;
+    /* True when the replay stopped because the queue was paused or ended */
+    bool interrupted;
+} stream_replay_stats_t;
+
+/*
+ * Return the node with identifier nodeid or nullptr.
+ * With the generated schedulers, it is the obj field of the CStreamNode
+ * returned by get_scheduler_xxx_node.
+ */
+typedef arm_cmsis_stream::StreamNode *(*stream_replay_node_resolver)(void *data, int32_t nodeid);
+
+/*
+ * Re-inject the node events of the log at path into queue (created with
+ * stream_new_event_queue). Only the events whose origin is in origin_mask
+ * are injected. With STREAM_EVENT_ORIGIN_MASK(STREAM_EVENT_FROM_APPLICATION),
+ * the graph is driven by the external traffic of the recording.
+ * The events referencing shared buffers are skipped and counted in
+ * nb_shared_buffer.
+ *
+ * The function returns when the whole log has been injected. It does not
+ * wait for the injected events to be processed.
+ * Return false if the log can't be read.
+ */
+extern bool stream_replay_event_log(const char *path,
+                                    arm_cmsis_stream::EventQueue *queue,
+                                    stream_replay_node_resolver resolver,
+                                    void *resolver_data,
+                                    stream_replay_timing timing,
+                                    uint32_t origin_mask,
+                                    stream_replay_stats_t *stats);
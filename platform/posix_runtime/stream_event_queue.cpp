@@ -10,6 +10,7 @@
  */
 
 #include "stream_event_queue.hpp"
+#include "stream_event_log.hpp"
 
 #include <atomic>
 #include <cstdint>
@@ -112,7 +113,18 @@ bool PosixEventQueue::push(arm_cmsis_stream::Message &&event)
         }
         if (nb_elems[p] < POSIX_QUEUE_MAX_ELEMS) {
             event.timestamp = CG_GET_TIME_STAMP();
-            queue[p][write[p]++] = std::move(event);
+            arm_cmsis_stream::Message &stored = queue[p][write[p]++];
+            stored = std::move(event);
+            // Only the events accepted by the queue are recorded. It is done
+            // before leaving the critical section since the event may be
+            // consumed as soon as the lock is released.
+            StreamEventLog *log = eventLog_.load();
+            if ((log != nullptr) &&
+                std::holds_alternative<LocalDestination>(stored.destination)) {
+                const LocalDestination &local = std::get<LocalDestination>(stored.destination);
+                (void)log->record(STREAM_LOG_NODE_EVENT, local.dst->nodeID(), local.dstPort,
+                                  stored.event);
+            }
             if (write[p] == POSIX_QUEUE_MAX_ELEMS) {
                 write[p] = 0;
             }
@@ -132,6 +144,23 @@ bool PosixEventQueue::push(arm_cmsis_stream::Message &&event)
     return ok;
 }
 
+bool PosixEventQueue::hasRoom(uint32_t priority, uint32_t nb)
+{
+    bool r = false;
+    if (priority >= nb_priorities) {
+        priority = nb_priorities - 1;
+    }
+    CG_MUTEX_ERROR_TYPE error;
+    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+    if (!CG_MUTEX_HAS_ERROR(error)) {
+        r = nb_elems[priority] + nb <= POSIX_QUEUE_MAX_ELEMS;
+    } else {
+        this->setError(CG_OS_ERROR, CG_UNIDENTIFIED_NODE, static_cast<int32_t>(error));
+    }
+    CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
+    return r;
+}
+
 bool PosixEventQueue::isEmpty()
 {
     bool r = true;
@@ -192,66 +221,105 @@ void PosixEventQueue::notifyQueue() noexcept
         event_ = true;
     }
     cv_.notify_one();
+    std::lock_guard<std::mutex> lock(notifier_mutex_);
+    if (readyNotifier_ != nullptr) {
+        readyNotifier_(readyNotifierData_);
+    }
 }
 
-void PosixEventQueue::execute()
+void PosixEventQueue::setEventLog(StreamEventLog *log) noexcept
 {
-    CG_MUTEX_ERROR_TYPE error;
-    while ((!this->mustEnd()) && (!this->mustPause())) {
-        while ((!this->mustEnd()) && (!this->mustPause()) && (!isEmpty())) {
-            Message msg;
-            bool messageWasReceived = false;
-            CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+    eventLog_.store(log);
+}
 
-            if (!CG_MUTEX_HAS_ERROR(error)) {
-                for (int32_t p = nb_priorities - 1; p >= 0; p--) {
-                    if (nb_elems[p] != 0) {
-                        msg = std::move(queue[p][read[p]++]);
-                        if (read[p] == POSIX_QUEUE_MAX_ELEMS) {
-                            read[p] = 0;
-                        }
+void PosixEventQueue::setReadyNotifier(ReadyNotifier notifier, void *data) noexcept
+{
+    std::lock_guard<std::mutex> lock(notifier_mutex_);
+    readyNotifierData_ = data;
+    readyNotifier_ = notifier;
+}
 
-                        nb_elems[p]--;
-                        messageWasReceived = true;
-                        break;
-                    }
+bool PosixEventQueue::executeOne()
+{
+    CG_MUTEX_ERROR_TYPE error;
+    Message msg;
+    bool messageWasReceived = false;
+    CG_ENTER_CRITICAL_SECTION(queue_mutex, error);
+
+    if (!CG_MUTEX_HAS_ERROR(error)) {
+        for (int32_t p = nb_priorities - 1; p >= 0; p--) {
+            if (nb_elems[p] != 0) {
+                msg = std::move(queue[p][read[p]++]);
+                if (read[p] == POSIX_QUEUE_MAX_ELEMS) {
+                    read[p] = 0;
                 }
-            } else {
-                this->setError(CG_OS_ERROR, CG_UNIDENTIFIED_NODE, static_cast<int32_t>(error));
+
+                nb_elems[p]--;
+                messageWasReceived = true;
+                break;
             }
-            CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
+        }
+    } else {
+        this->setError(CG_OS_ERROR, CG_UNIDENTIFIED_NODE, static_cast<int32_t>(error));
+    }
+    CG_EXIT_CRITICAL_SECTION(queue_mutex, error);
 
-            if (messageWasReceived) {
-                bool eventExpired = false;
-                if (msg.event.ttl != 0) {
-                    uint32_t limitMs = msg.timestamp + msg.event.ttl;
-                    uint32_t nowMs = CG_GET_TIME_STAMP();
-                    if (nowMs > limitMs) {
-                        eventExpired = true;
-                    }
-                }
-                if (!eventExpired) {
-                    uint32_t p = msg.event.priority;
-                    if (p >= nb_priorities) {
-                        p = nb_priorities - 1;
-                    }
-                    stream_set_current_thread_priority(priorities[p]);
+    if (!messageWasReceived) {
+        return false;
+    }
 
-                    if (std::holds_alternative<LocalDestination>(msg.destination)) {
-                        LocalDestination &local = std::get<LocalDestination>(msg.destination);
-                        cg_status status = local.dst->processEvent(local.dstPort, std::move(msg.event));
-                        if (status != CG_SUCCESS) {
-                            this->setError(status, local.dst->nodeID());
-                        }
-                    } else if (std::holds_alternative<DistantDestination>(msg.destination)) {
-                        DistantDestination &dist = std::get<DistantDestination>(msg.destination);
-                        if (!this->callAsyncHandler(dist.src_node_id, std::move(msg.event))) {
-                            this->setError(CG_EVENT_QUEUE_FULL, dist.src_node_id);
-                        }
-                    }
-                    stream_set_current_thread_priority(priorities[nb_priorities - 1]);
-                }
+    bool eventExpired = false;
+    if (msg.event.ttl != 0) {
+        uint32_t limitMs = msg.timestamp + msg.event.ttl;
+        uint32_t nowMs = CG_GET_TIME_STAMP();
+        if (nowMs > limitMs) {
+            eventExpired = true;
+        }
+    }
+    if (!eventExpired) {
+        uint32_t p = msg.event.priority;
+        if (p >= nb_priorities) {
+            p = nb_priorities - 1;
+        }
+        stream_set_current_thread_priority(priorities[p]);
+        const stream_event_origin origin = cg_currentEventOrigin;
+        cg_currentEventOrigin = STREAM_EVENT_FROM_EVENT_HANDLER;
+
+        if (std::holds_alternative<LocalDestination>(msg.destination)) {
+            LocalDestination &local = std::get<LocalDestination>(msg.destination);
+            cg_status status = local.dst->processEvent(local.dstPort, std::move(msg.event));
+            if (status != CG_SUCCESS) {
+                this->setError(status, local.dst->nodeID());
             }
+        } else if (std::holds_alternative<DistantDestination>(msg.destination)) {
+            DistantDestination &dist = std::get<DistantDestination>(msg.destination);
+            if (!this->callAsyncHandler(dist.src_node_id, std::move(msg.event))) {
+                this->setError(CG_EVENT_QUEUE_FULL, dist.src_node_id);
+            }
+        }
+        cg_currentEventOrigin = origin;
+        stream_set_current_thread_priority(priorities[nb_priorities - 1]);
+    }
+    return true;
+}
+
+uint32_t PosixEventQueue::executeBatch(uint32_t maxEvents)
+{
+    uint32_t nb = 0;
+    while ((nb < maxEvents) && (!this->mustEnd()) && (!this->mustPause())) {
+        if (!executeOne()) {
+            break;
+        }
+        nb++;
+    }
+    return nb;
+}
+
+void PosixEventQueue::execute()
+{
+    while ((!this->mustEnd()) && (!this->mustPause())) {
+        while ((!this->mustEnd()) && (!this->mustPause()) && (!isEmpty())) {
+            (void)executeOne();
         }
         if (this->mustEnd() || this->mustPause()) {
             return;
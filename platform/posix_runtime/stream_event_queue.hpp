@@ -10,6 +10,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <utility>
@@ -21,6 +22,8 @@
 
 #define POSIX_QUEUE_MAX_ELEMS CMSISSTREAM_EVENT_QUEUE_LENGTH
 
+class StreamEventLog;
+
 class PosixEventQueue : public arm_cmsis_stream::EventQueue {
   public:
     PosixEventQueue(ThreadPriority low, ThreadPriority normal, ThreadPriority high);
@@ -33,10 +36,46 @@ class PosixEventQueue : public arm_cmsis_stream::EventQueue {
     void end() noexcept final;
     void pause() noexcept final;
 
+    /*
+     * Used when the queue is one shard of a multi-graph runtime.
+     * The notifier is called each time the queue state may have
+     * changed (new event, pause or end) so that an event worker can
+     * be scheduled. It must be set before the queue is used.
+     * When the function returns, the previous notifier is no more
+     * running and will not be called again.
+     */
+    using ReadyNotifier = void (*)(void *data);
+    void setReadyNotifier(ReadyNotifier notifier, void *data) noexcept;
+
+    /*
+     * Process at most maxEvents pending events without waiting.
+     * Return the number of events that were processed.
+     */
+    uint32_t executeBatch(uint32_t maxEvents);
+
+    /*
+     * Record in log all the events pushed to a node of this queue.
+     * nullptr stops the recording.
+     */
+    void setEventLog(StreamEventLog *log) noexcept;
+
+    /*
+     * True if nb events with this priority can be pushed without
+     * overflowing the queue.
+     */
+    bool hasRoom(uint32_t priority, uint32_t nb = 1);
+
   private:
+    bool executeOne();
     void waitEvent();
     void notifyQueue() noexcept;
 
+    // Protects the notifier and is held while it is called
+    std::mutex notifier_mutex_;
+    ReadyNotifier readyNotifier_ = nullptr;
+    void *readyNotifierData_ = nullptr;
+    std::atomic<StreamEventLog *> eventLog_ = nullptr;
+
     CG_MUTEX queue_mutex;
     std::condition_variable cv_;
     bool event_ = false;
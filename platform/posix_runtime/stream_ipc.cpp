@@ -0,0 +1,37 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_ipc.cpp
+ * Description:  Helpers for the IPC transports of the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_ipc.hpp"
+
+using namespace arm_cmsis_stream;
+
+uint32_t stream_ipc_dispatch(IPC *ipc, EventQueue *queue, stream_ipc_node_resolver resolver,
+                             void *resolver_data)
+{
+    uint32_t nb_lost = 0;
+    while (true) {
+        uint32_t nodeid;
+        Event evt = ipc->receive_message(nodeid);
+        if (!evt) {
+            break;
+        }
+        StreamNode *node = resolver(resolver_data, static_cast<int32_t>(nodeid));
+        if (node == nullptr) {
+            CMSISSTREAM_LOG_ERR("IPC event for unknown node %u\n", nodeid);
+            nb_lost++;
+            continue;
+        }
+        if (!queue->push(LocalDestination{node, 0}, std::move(evt))) {
+            nb_lost++;
+        }
+    }
+    return nb_lost;
+}
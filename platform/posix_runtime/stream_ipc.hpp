@@ -0,0 +1,44 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_ipc.hpp
+ * Description:  Helpers for the IPC transports of the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "EventQueue.hpp"
+#include "StreamNode.hpp"
+#include "stream_platform_config.hpp"
+
+/*
+ * A graph split across processes exchanges events through an IPC:
+ *
+ * - In the sending process, the node sends the event to the application
+ *   (DistantDestination) and the application handler forwards it with
+ *   ipc->send_message(remote_node_id, std::move(evt)).
+ * - In the receiving process, a thread runs stream_ipc_dispatch to push
+ *   the received events to the port 0 of the destination nodes.
+ *
+ * Shared buffers are transmitted by global_id (MemServer::mem_server must
+ * be set in both processes). Other buffers are copied.
+ */
+
+/* Return the node with identifier nodeid or nullptr */
+typedef arm_cmsis_stream::StreamNode *(*stream_ipc_node_resolver)(void *data, int32_t nodeid);
+
+/*
+ * Receive the events from ipc and push them to queue until the IPC is
+ * closed (receive_message returns an empty event).
+ * Return the number of events that could not be delivered (unknown node
+ * or queue full).
+ */
+extern uint32_t stream_ipc_dispatch(arm_cmsis_stream::IPC *ipc,
+                                    arm_cmsis_stream::EventQueue *queue,
+                                    stream_ipc_node_resolver resolver,
+                                    void *resolver_data);
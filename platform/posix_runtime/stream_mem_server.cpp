@@ -0,0 +1,1095 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_mem_server.cpp
+ * Description:  Reference MemServer implementation for Linux
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_mem_server.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define STREAM_MEM_SERVER_SUPPORTED
+#endif
+
+using namespace arm_cmsis_stream;
+
+#ifdef STREAM_MEM_SERVER_SUPPORTED
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex word must be lock free");
+static_assert(std::atomic<int32_t>::is_always_lock_free, "Refcount must be lock free");
+
+/* Messages exchanged with the server (SOCK_SEQPACKET) */
+enum mem_msg_type : uint32_t {
+    kMemHello = 0,
+    kMemRegister = 1,
+    kMemGet = 2,
+    kMemFree = 3,
+    kMemAck = 4,
+    kMemNotify = 5,
+    kMemReply = 6
+};
+
+struct mem_msg_t {
+    uint32_t type;
+    int32_t global_id;
+    int32_t node_id;
+    int32_t local_id;
+    uint64_t size;
+    int32_t status;
+    uint32_t nb_entries;
+};
+
+enum mem_entry_state : uint32_t {
+    kEntryFree = 0,
+    kEntryUsed = 1,
+    kEntryNotified = 2
+};
+
+/* Bit of the lock word set when a writer holds the lock.
+   The other bits are the number of readers. */
+static constexpr uint32_t writer_bit = 0x80000000u;
+
+static long futex(std::atomic<uint32_t> *word, int op, uint32_t val)
+{
+    // Not FUTEX_PRIVATE: the word is shared between processes
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), op, val, nullptr, nullptr, 0);
+}
+
+static bool send_msg(int sock, const mem_msg_t &msg, int fd)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<mem_msg_t *>(&msg);
+    iov.iov_len = sizeof(msg);
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    if (fd >= 0) {
+        memset(control, 0, sizeof(control));
+        hdr.msg_control = control;
+        hdr.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    ssize_t n;
+    do {
+        n = sendmsg(sock, &hdr, MSG_NOSIGNAL);
+    } while ((n < 0) && (errno == EINTR));
+    return n == static_cast<ssize_t>(sizeof(msg));
+}
+
+/* Return 1 if a message was received, 0 if none is available (non
+   blocking), -1 on error or when the peer closed the connection */
+static int recv_msg(int sock, mem_msg_t &msg, int *fd, int flags)
+{
+    struct iovec iov;
+    iov.iov_base = &msg;
+    iov.iov_len = sizeof(msg);
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = recvmsg(sock, &hdr, flags | MSG_CMSG_CLOEXEC);
+    } while ((n < 0) && (errno == EINTR));
+    if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+        return 0;
+    }
+    if (n != static_cast<ssize_t>(sizeof(msg))) {
+        return -1;
+    }
+
+    int received = -1;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+            memcpy(&received, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+    if (fd != nullptr) {
+        *fd = received;
+    } else if (received >= 0) {
+        close(received);
+    }
+    return 1;
+}
+
+/*
+ *
+ * Mapping cache
+ *
+ */
+PosixMappingCache::~PosixMappingCache()
+{
+    for (auto &m : mappings_) {
+        munmap(m.second.data, m.second.size);
+    }
+}
+
+void *PosixMappingCache::map(int32_t global_id, uint32_t generation, int fd, std::size_t size)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = mappings_.find(key(global_id, generation));
+    if (it != mappings_.end()) {
+        Mapping &m = it->second;
+        if (m.users == 0) {
+            lru_.erase(m.lru);
+        }
+        m.users++;
+        stats_.nb_hits++;
+        return m.data;
+    }
+
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+    mappings_[key(global_id, generation)] = Mapping{p, size, 1, lru_.end()};
+    stats_.nb_maps++;
+    stats_.mapped_bytes += size;
+    if (stats_.mapped_bytes > stats_.peak_mapped_bytes) {
+        stats_.peak_mapped_bytes = stats_.mapped_bytes;
+    }
+    evict();
+    if (stats_.mapped_bytes > budget_) {
+        stats_.nb_over_budget++;
+    }
+    return p;
+}
+
+void PosixMappingCache::unmap(int32_t global_id, uint32_t generation)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = mappings_.find(key(global_id, generation));
+    if (it == mappings_.end()) {
+        return;
+    }
+    Mapping &m = it->second;
+    if (--m.users == 0) {
+        m.lru = lru_.insert(lru_.end(), it->first);
+        evict();
+    }
+}
+
+void PosixMappingCache::forget(int32_t global_id)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto it = lru_.begin(); it != lru_.end();) {
+        if (static_cast<int32_t>(*it >> 32) == global_id) {
+            Mapping &m = mappings_[*it];
+            munmap(m.data, m.size);
+            stats_.nb_unmaps++;
+            stats_.mapped_bytes -= m.size;
+            mappings_.erase(*it);
+            it = lru_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Must be called with the mutex
+void PosixMappingCache::evict()
+{
+    while ((stats_.mapped_bytes > budget_) && (!lru_.empty())) {
+        auto it = mappings_.find(lru_.front());
+        lru_.pop_front();
+        munmap(it->second.data, it->second.size);
+        stats_.nb_unmaps++;
+        stats_.mapped_bytes -= it->second.size;
+        mappings_.erase(it);
+    }
+}
+
+void PosixMappingCache::setBudget(std::size_t budget)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    budget_ = budget;
+    evict();
+}
+
+void PosixMappingCache::stats(stream_mapping_cache_stats_t &stats) const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    stats = stats_;
+}
+
+/*
+ *
+ * Descriptor
+ *
+ */
+static const PosixMemServer *posix_mem_server()
+{
+    return static_cast<const PosixMemServer *>(MemServer::mem_server);
+}
+
+PosixDescriptor::PosixDescriptor(NativeHandle fd, size_t size, int32_t global_id)
+    : Descriptor(size, global_id), fd_(fd)
+{
+    const PosixMemServer *server = posix_mem_server();
+    if ((server != nullptr) && (global_id != -1)) {
+        generation_ = server->generation(global_id);
+    }
+}
+
+PosixDescriptor::~PosixDescriptor()
+{
+    const PosixMemServer *server = posix_mem_server();
+    if (data_ != nullptr) {
+        if (cached_ && (server != nullptr)) {
+            server->mappingCache().unmap(global_id_, generation_);
+        } else {
+            munmap(data_, size_);
+        }
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    if ((server != nullptr) && (global_id_ != -1)) {
+        (void)server->release(global_id_);
+    }
+}
+
+Descriptor *PosixDescriptor::make(NativeHandle fd, size_t size, int32_t global_id)
+{
+    return new (std::nothrow) PosixDescriptor(fd, size, global_id);
+}
+
+void PosixDescriptor::mapDescriptor() const
+{
+    if ((data_ != nullptr) || (fd_ < 0) || (size_ == 0)) {
+        return;
+    }
+    const PosixMemServer *server = posix_mem_server();
+    if ((server != nullptr) && (global_id_ != -1)) {
+        data_ = server->mappingCache().map(global_id_, generation_, fd_, size_);
+        cached_ = true;
+    } else {
+        void *p = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        data_ = (p == MAP_FAILED) ? nullptr : p;
+    }
+    if (data_ == nullptr) {
+        CMSISSTREAM_LOG_ERR("Can't map shared buffer %d\n", global_id_);
+    }
+}
+
+NativeHandle PosixDescriptor::fd() const noexcept
+{
+    return fd_;
+}
+
+PosixDescriptor::operator bool() const noexcept
+{
+    return fd_ >= 0;
+}
+
+/*
+ *
+ * Client
+ *
+ */
+PosixMemServer *PosixMemServer::connect(const char *socket_path)
+{
+    struct sockaddr_un addr;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        return nullptr;
+    }
+    int sock = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        return nullptr;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+    if (::connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        CMSISSTREAM_LOG_ERR("Can't connect to mem server %s\n", socket_path);
+        close(sock);
+        return nullptr;
+    }
+
+    // The server sends the table of entries when the connection is accepted
+    mem_msg_t hello;
+    int table_fd = -1;
+    if ((recv_msg(sock, hello, &table_fd, 0) != 1) || (hello.type != kMemHello) ||
+        (table_fd < 0)) {
+        if (table_fd >= 0) {
+            close(table_fd);
+        }
+        close(sock);
+        return nullptr;
+    }
+    const size_t table_size = hello.nb_entries * sizeof(stream_mem_entry_t);
+    void *table = mmap(nullptr, table_size, PROT_READ | PROT_WRITE, MAP_SHARED, table_fd, 0);
+    close(table_fd);
+    if (table == MAP_FAILED) {
+        close(sock);
+        return nullptr;
+    }
+
+    PosixMemServer *server = new (std::nothrow) PosixMemServer();
+    if (server == nullptr) {
+        munmap(table, table_size);
+        close(sock);
+        return nullptr;
+    }
+    server->sock_ = sock;
+    server->table_ = static_cast<stream_mem_entry_t *>(table);
+    server->nb_entries_ = hello.nb_entries;
+    return server;
+}
+
+PosixMemServer::~PosixMemServer()
+{
+    if (table_ != nullptr) {
+        munmap(table_, nb_entries_ * sizeof(stream_mem_entry_t));
+        table_ = nullptr;
+    }
+    if (sock_ >= 0) {
+        close(sock_);
+        sock_ = -1;
+    }
+}
+
+stream_mem_entry_t *PosixMemServer::entry(int32_t offset) const noexcept
+{
+    if ((offset < 0) || (static_cast<uint32_t>(offset) >= nb_entries_)) {
+        return nullptr;
+    }
+    return &table_[offset];
+}
+
+bool PosixMemServer::request(uint32_t type, int32_t global_id, int32_t node_id, int32_t local_id,
+                             uint64_t size, int send_fd, int32_t &status, int *recv_fd) const
+{
+    mem_msg_t msg = {type, global_id, node_id, local_id, size, 0, 0};
+    bool ok = false;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (send_msg(sock_, msg, send_fd)) {
+            // Notifications may be received before the reply
+            while (true) {
+                mem_msg_t reply;
+                int fd = -1;
+                if (recv_msg(sock_, reply, &fd, 0) != 1) {
+                    break;
+                }
+                if (reply.type == kMemNotify) {
+                    notifications_.push_back({reply.node_id, reply.local_id, reply.global_id});
+                    continue;
+                }
+                status = reply.status;
+                if (recv_fd != nullptr) {
+                    *recv_fd = fd;
+                } else if (fd >= 0) {
+                    close(fd);
+                }
+                ok = true;
+                break;
+            }
+        }
+    }
+    dispatchNotifications();
+    return ok;
+}
+
+void PosixMemServer::dispatchNotifications() const
+{
+    while (true) {
+        Notification n;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (notifications_.empty()) {
+                return;
+            }
+            n = notifications_.front();
+            notifications_.pop_front();
+        }
+        if (notificationHandler_ != nullptr) {
+            notificationHandler_(notificationData_, n.node_id, n.local_id, n.global_id);
+        }
+    }
+}
+
+void PosixMemServer::setNotificationHandler(NotificationHandler handler, void *data) noexcept
+{
+    notificationData_ = data;
+    notificationHandler_ = handler;
+}
+
+void PosixMemServer::pollNotifications() const
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        mem_msg_t msg;
+        while (recv_msg(sock_, msg, nullptr, MSG_DONTWAIT) == 1) {
+            if (msg.type == kMemNotify) {
+                notifications_.push_back({msg.node_id, msg.local_id, msg.global_id});
+            }
+        }
+    }
+    dispatchNotifications();
+}
+
+int PosixMemServer::read_lock(int32_t offset) const
+{
+    stream_mem_entry_t *e = entry(offset);
+    if (e == nullptr) {
+        return -1;
+    }
+    while (true) {
+        uint32_t v = e->lock.load(std::memory_order_relaxed);
+        if ((v & writer_bit) == 0) {
+            if (e->lock.compare_exchange_weak(v, v + 1, std::memory_order_acquire)) {
+                return 0;
+            }
+        } else {
+            (void)futex(&e->lock, FUTEX_WAIT, v);
+        }
+    }
+}
+
+int PosixMemServer::read_unlock(int32_t offset) const
+{
+    stream_mem_entry_t *e = entry(offset);
+    if (e == nullptr) {
+        return -1;
+    }
+    uint32_t v = e->lock.fetch_sub(1, std::memory_order_release);
+    if (v == 1) {
+        // Last reader: wake the waiting writers
+        (void)futex(&e->lock, FUTEX_WAKE, INT_MAX);
+    }
+    return 0;
+}
+
+int PosixMemServer::lock(int32_t offset) const
+{
+    stream_mem_entry_t *e = entry(offset);
+    if (e == nullptr) {
+        return -1;
+    }
+    while (true) {
+        uint32_t v = 0;
+        if (e->lock.compare_exchange_weak(v, writer_bit, std::memory_order_acquire)) {
+            return 0;
+        }
+        if (v != 0) {
+            (void)futex(&e->lock, FUTEX_WAIT, v);
+        }
+    }
+}
+
+int PosixMemServer::unlock(int32_t offset) const
+{
+    stream_mem_entry_t *e = entry(offset);
+    if (e == nullptr) {
+        return -1;
+    }
+    e->lock.store(0, std::memory_order_release);
+    (void)futex(&e->lock, FUTEX_WAKE, INT_MAX);
+    return 0;
+}
+
+// Refcount changes take the read lock so that they are blocked
+// while a write lock is held.
+// A buffer whose refcount reached 0 is being destroyed and may already
+// be recycled by the server: it can't be acquired again.
+int PosixMemServer::acquire(int32_t offset) const
+{
+    if (read_lock(offset) != 0) {
+        return -1;
+    }
+    std::atomic<int32_t> &rc = entry(offset)->refcount;
+    int32_t v = rc.load(std::memory_order_relaxed);
+    int res = -1;
+    while (v > 0) {
+        if (rc.compare_exchange_weak(v, v + 1, std::memory_order_relaxed)) {
+            res = 0;
+            break;
+        }
+    }
+    (void)read_unlock(offset);
+    return res;
+}
+
+int PosixMemServer::release(int32_t offset) const
+{
+    if (read_lock(offset) != 0) {
+        return -1;
+    }
+    int32_t v = entry(offset)->refcount.fetch_sub(1, std::memory_order_acq_rel);
+    (void)read_unlock(offset);
+    if (v == 1) {
+        // No process is using the buffer anymore
+        cache_.forget(offset);
+        mem_msg_t msg = {kMemFree, offset, 0, 0, 0, 0, 0};
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!send_msg(sock_, msg, -1)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+uint32_t PosixMemServer::generation(int32_t global_id) const noexcept
+{
+    stream_mem_entry_t *e = entry(global_id);
+    if (e == nullptr) {
+        return 0;
+    }
+    return e->generation;
+}
+
+int32_t PosixMemServer::refcount(int32_t offset) const
+{
+    stream_mem_entry_t *e = entry(offset);
+    if (e == nullptr) {
+        return -1;
+    }
+    return e->refcount.load(std::memory_order_acquire);
+}
+
+Descriptor *PosixMemServer::register_buffer(size_t size, NativeHandle fd, int32_t node_id,
+                                            int32_t local_id) const
+{
+    int copy = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (copy < 0) {
+        return nullptr;
+    }
+    int32_t status = -1;
+    if (!request(kMemRegister, -1, node_id, local_id, size, fd, status, nullptr) ||
+        (status < 0)) {
+        close(copy);
+        return nullptr;
+    }
+    Descriptor *d = PosixDescriptor::make(copy, size, status);
+    if (d == nullptr) {
+        close(copy);
+        (void)release(status);
+    }
+    return d;
+}
+
+Descriptor *PosixMemServer::new_buffer(size_t size) const
+{
+    int fd = memfd_create("cmsis_stream_buffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    int32_t status = -1;
+    if (!request(kMemRegister, -1, CG_UNIDENTIFIED_NODE, -1, size, fd, status, nullptr) ||
+        (status < 0)) {
+        close(fd);
+        return nullptr;
+    }
+    Descriptor *d = PosixDescriptor::make(fd, size, status);
+    if (d == nullptr) {
+        close(fd);
+        (void)release(status);
+    }
+    return d;
+}
+
+Descriptor *PosixMemServer::get_buffer(int32_t global_id) const
+{
+    if (entry(global_id) == nullptr) {
+        return nullptr;
+    }
+    // The server increments the refcount. The read lock blocks it while
+    // a write lock is held.
+    if (read_lock(global_id) != 0) {
+        return nullptr;
+    }
+    int32_t status = -1;
+    int fd = -1;
+    bool ok = request(kMemGet, global_id, 0, 0, 0, -1, status, &fd);
+    (void)read_unlock(global_id);
+    if (!ok || (status < 0) || (fd < 0)) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return nullptr;
+    }
+    Descriptor *d = PosixDescriptor::make(fd, static_cast<size_t>(entry(global_id)->size),
+                                          global_id);
+    if (d == nullptr) {
+        close(fd);
+        (void)release(global_id);
+    }
+    return d;
+}
+
+void PosixMemServer::ack_notification() const
+{
+    mem_msg_t msg = {kMemAck, -1, 0, 0, 0, 0, 0};
+    std::lock_guard<std::mutex> guard(mutex_);
+    (void)send_msg(sock_, msg, -1);
+}
+
+/*
+ *
+ * Server
+ *
+ */
+namespace {
+struct ServerEntry {
+    int fd = -1;
+    /* Connection of the process that registered the buffer, -1 for new_buffer */
+    int owner = -1;
+    int32_t node_id = CG_UNIDENTIFIED_NODE;
+    int32_t local_id = -1;
+};
+
+struct ServerClient {
+    int sock;
+    /* Notified entries waiting for an acknowledge, in order */
+    std::deque<int32_t> pending;
+};
+
+class Server {
+  public:
+    Server(stream_mem_entry_t *table, uint32_t nb_entries, int table_fd)
+        : table_(table), entries_(nb_entries), nb_entries_(nb_entries), table_fd_(table_fd)
+    {
+    }
+
+    ~Server()
+    {
+        for (ServerEntry &e : entries_) {
+            if (e.fd >= 0) {
+                close(e.fd);
+            }
+        }
+        for (ServerClient &c : clients_) {
+            close(c.sock);
+        }
+    }
+
+    void accept_client(int sock)
+    {
+        mem_msg_t hello = {kMemHello, -1, 0, 0, 0, 0, nb_entries_};
+        if (!send_msg(sock, hello, table_fd_)) {
+            close(sock);
+            return;
+        }
+        clients_.push_back({sock, {}});
+    }
+
+    std::vector<ServerClient> &clients() { return clients_; }
+
+    /* Return false when the client must be disconnected */
+    bool handle(ServerClient &client)
+    {
+        mem_msg_t msg;
+        int fd = -1;
+        if (recv_msg(client.sock, msg, &fd, 0) != 1) {
+            return false;
+        }
+        switch (msg.type) {
+        case kMemRegister:
+            return register_buffer(client, msg, fd);
+        case kMemGet:
+            return get_buffer(client, msg);
+        case kMemFree:
+            free_buffer(msg.global_id);
+            break;
+        case kMemAck:
+            if (!client.pending.empty()) {
+                int32_t id = client.pending.front();
+                client.pending.pop_front();
+                recycle(id);
+            }
+            break;
+        default:
+            break;
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        return true;
+    }
+
+    void disconnect(size_t i)
+    {
+        ServerClient &client = clients_[i];
+        for (int32_t id : client.pending) {
+            recycle(id);
+        }
+        for (ServerEntry &e : entries_) {
+            if (e.owner == client.sock) {
+                e.owner = -1;
+            }
+        }
+        close(client.sock);
+        clients_.erase(clients_.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+  private:
+    bool reply(int sock, int32_t status, int fd)
+    {
+        mem_msg_t msg = {kMemReply, -1, 0, 0, 0, status, 0};
+        return send_msg(sock, msg, fd);
+    }
+
+    bool register_buffer(ServerClient &client, const mem_msg_t &msg, int fd)
+    {
+        if (fd < 0) {
+            return reply(client.sock, -1, -1);
+        }
+        for (uint32_t n = 0; n < nb_entries_; n++) {
+            uint32_t id = (next_ + n) % nb_entries_;
+            if (table_[id].state == kEntryFree) {
+                next_ = (id + 1) % nb_entries_;
+                ServerEntry &e = entries_[id];
+                e.fd = fd;
+                e.owner = (msg.local_id != -1) ? client.sock : -1;
+                e.node_id = msg.node_id;
+                e.local_id = msg.local_id;
+                table_[id].size = msg.size;
+                table_[id].generation++;
+                table_[id].lock.store(0);
+                table_[id].refcount.store(1);
+                table_[id].state = kEntryUsed;
+                return reply(client.sock, static_cast<int32_t>(id), -1);
+            }
+        }
+        CMSISSTREAM_LOG_ERR("Mem server table is full\n");
+        close(fd);
+        return reply(client.sock, -1, -1);
+    }
+
+    bool get_buffer(ServerClient &client, const mem_msg_t &msg)
+    {
+        if ((msg.global_id < 0) || (static_cast<uint32_t>(msg.global_id) >= nb_entries_) ||
+            (table_[msg.global_id].state != kEntryUsed)) {
+            return reply(client.sock, -1, -1);
+        }
+        // A buffer whose refcount reached 0 is being destroyed
+        std::atomic<int32_t> &rc = table_[msg.global_id].refcount;
+        int32_t v = rc.load();
+        while (v > 0) {
+            if (rc.compare_exchange_weak(v, v + 1)) {
+                return reply(client.sock, 0, entries_[msg.global_id].fd);
+            }
+        }
+        return reply(client.sock, -1, -1);
+    }
+
+    void free_buffer(int32_t id)
+    {
+        if ((id < 0) || (static_cast<uint32_t>(id) >= nb_entries_) ||
+            (table_[id].state != kEntryUsed) || (table_[id].refcount.load() != 0)) {
+            return;
+        }
+        ServerEntry &e = entries_[id];
+        if (e.owner >= 0) {
+            for (ServerClient &c : clients_) {
+                if (c.sock == e.owner) {
+                    mem_msg_t msg = {kMemNotify, id, e.node_id, e.local_id, 0, 0, 0};
+                    if (send_msg(c.sock, msg, -1)) {
+                        table_[id].state = kEntryNotified;
+                        c.pending.push_back(id);
+                        return;
+                    }
+                }
+            }
+        }
+        recycle(id);
+    }
+
+    void recycle(int32_t id)
+    {
+        ServerEntry &e = entries_[id];
+        if (e.fd >= 0) {
+            close(e.fd);
+        }
+        e = ServerEntry();
+        table_[id].size = 0;
+        table_[id].state = kEntryFree;
+    }
+
+    stream_mem_entry_t *table_;
+    std::vector<ServerEntry> entries_;
+    std::vector<ServerClient> clients_;
+    uint32_t nb_entries_;
+    uint32_t next_ = 0;
+    int table_fd_;
+};
+} // namespace
+
+int stream_run_mem_server(const char *socket_path, uint32_t nb_entries,
+                          const std::atomic<bool> *stop)
+{
+    struct sockaddr_un addr;
+    if ((nb_entries == 0) || (nb_entries > INT32_MAX) ||
+        (strlen(socket_path) >= sizeof(addr.sun_path))) {
+        return -1;
+    }
+
+    const size_t table_size = nb_entries * sizeof(stream_mem_entry_t);
+    int table_fd = memfd_create("cmsis_stream_mem_table", MFD_CLOEXEC);
+    if (table_fd < 0) {
+        return -1;
+    }
+    if (ftruncate(table_fd, static_cast<off_t>(table_size)) != 0) {
+        close(table_fd);
+        return -1;
+    }
+    void *table = mmap(nullptr, table_size, PROT_READ | PROT_WRITE, MAP_SHARED, table_fd, 0);
+    if (table == MAP_FAILED) {
+        close(table_fd);
+        return -1;
+    }
+    // The file is filled with 0: all entries are free and unlocked
+
+    int listener = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        munmap(table, table_size);
+        close(table_fd);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if ((bind(listener, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) ||
+        (listen(listener, 16) != 0)) {
+        CMSISSTREAM_LOG_ERR("Can't listen on %s\n", socket_path);
+        close(listener);
+        munmap(table, table_size);
+        close(table_fd);
+        return -1;
+    }
+
+    {
+        Server server(static_cast<stream_mem_entry_t *>(table), nb_entries, table_fd);
+        std::vector<struct pollfd> fds;
+
+        while ((stop == nullptr) || (!stop->load())) {
+            fds.clear();
+            fds.push_back({listener, POLLIN, 0});
+            for (ServerClient &c : server.clients()) {
+                fds.push_back({c.sock, POLLIN, 0});
+            }
+            int n = poll(fds.data(), fds.size(), 100);
+            if (n <= 0) {
+                continue;
+            }
+            // Clients are handled from the end so that a disconnection
+            // does not change the index of the remaining clients to handle
+            for (size_t i = fds.size() - 1; i > 0; i--) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                if (((fds[i].revents & POLLIN) == 0) || !server.handle(server.clients()[i - 1])) {
+                    server.disconnect(i - 1);
+                }
+            }
+            if ((fds[0].revents & POLLIN) != 0) {
+                int client = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client >= 0) {
+                    server.accept_client(client);
+                }
+            }
+        }
+    }
+
+    close(listener);
+    unlink(socket_path);
+    munmap(table, table_size);
+    close(table_fd);
+    return 0;
+}
+
+#else
+
+PosixMappingCache::~PosixMappingCache()
+{
+}
+
+void *PosixMappingCache::map(int32_t, uint32_t, int, std::size_t)
+{
+    return nullptr;
+}
+
+void PosixMappingCache::unmap(int32_t, uint32_t)
+{
+}
+
+void PosixMappingCache::forget(int32_t)
+{
+}
+
+void PosixMappingCache::evict()
+{
+}
+
+void PosixMappingCache::setBudget(std::size_t budget)
+{
+    budget_ = budget;
+}
+
+void PosixMappingCache::stats(stream_mapping_cache_stats_t &stats) const
+{
+    stats = stats_;
+}
+
+PosixDescriptor::PosixDescriptor(NativeHandle fd, size_t size, int32_t global_id)
+    : Descriptor(size, global_id), fd_(-1)
+{
+    (void)fd;
+}
+
+PosixDescriptor::~PosixDescriptor()
+{
+}
+
+Descriptor *PosixDescriptor::make(NativeHandle fd, size_t size, int32_t global_id)
+{
+    (void)fd;
+    (void)size;
+    (void)global_id;
+    return nullptr;
+}
+
+void PosixDescriptor::mapDescriptor() const
+{
+}
+
+NativeHandle PosixDescriptor::fd() const noexcept
+{
+    return NativeHandle();
+}
+
+PosixDescriptor::operator bool() const noexcept
+{
+    return false;
+}
+
+PosixMemServer *PosixMemServer::connect(const char *socket_path)
+{
+    (void)socket_path;
+    CMSISSTREAM_LOG_ERR("Mem server is only supported on Linux\n");
+    return nullptr;
+}
+
+PosixMemServer::~PosixMemServer()
+{
+}
+
+int PosixMemServer::lock(int32_t) const
+{
+    return -1;
+}
+
+int PosixMemServer::unlock(int32_t) const
+{
+    return -1;
+}
+
+int PosixMemServer::read_lock(int32_t) const
+{
+    return -1;
+}
+
+int PosixMemServer::read_unlock(int32_t) const
+{
+    return -1;
+}
+
+int PosixMemServer::acquire(int32_t) const
+{
+    return -1;
+}
+
+int PosixMemServer::release(int32_t) const
+{
+    return -1;
+}
+
+int32_t PosixMemServer::refcount(int32_t) const
+{
+    return -1;
+}
+
+uint32_t PosixMemServer::generation(int32_t) const noexcept
+{
+    return 0;
+}
+
+Descriptor *PosixMemServer::new_buffer(size_t) const
+{
+    return nullptr;
+}
+
+Descriptor *PosixMemServer::get_buffer(int32_t) const
+{
+    return nullptr;
+}
+
+Descriptor *PosixMemServer::register_buffer(size_t, NativeHandle, int32_t, int32_t) const
+{
+    return nullptr;
+}
+
+void PosixMemServer::ack_notification() const
+{
+}
+
+void PosixMemServer::setNotificationHandler(NotificationHandler handler, void *data) noexcept
+{
+    notificationData_ = data;
+    notificationHandler_ = handler;
+}
+
+void PosixMemServer::pollNotifications() const
+{
+}
+
+int stream_run_mem_server(const char *socket_path, uint32_t nb_entries,
+                          const std::atomic<bool> *stop)
+{
+    (void)socket_path;
+    (void)nb_entries;
+    (void)stop;
+    CMSISSTREAM_LOG_ERR("Mem server is only supported on Linux\n");
+    return -1;
+}
+
+#endif
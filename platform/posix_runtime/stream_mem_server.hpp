@@ -0,0 +1,231 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_mem_server.hpp
+ * Description:  Reference MemServer implementation for Linux
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "StreamNode.hpp"
+#include "stream_platform_config.hpp"
+
+/*
+ * Reference implementation of the MemServer and Descriptor APIs for Linux.
+ *
+ * Shared buffers are memfd files. A server process owns a table of
+ * entries in shared memory (also a memfd). The global_id of a buffer is
+ * the index of its entry. Each entry contains the reference count and a
+ * reader / writer lock (futex) so that acquire, release, refcount and the
+ * locks don't need any communication with the server.
+ *
+ * The server is only contacted through an AF_UNIX socket to:
+ * - register a new buffer (the memfd is sent to the server),
+ * - get the memfd of a buffer from its global_id,
+ * - tell the server that a buffer is no more used by any process.
+ *
+ * When a buffer created with register_buffer is no more used, the
+ * server sends a notification (node_id, local_id, global_id) to the
+ * process that registered it instead of destroying it. The entry is
+ * recycled when the notification is acknowledged with ack_notification.
+ *
+ * Mappings are shared by all the descriptors of a process for the same
+ * buffer and kept in a cache after the descriptors are destroyed (see
+ * PosixMappingCache).
+ *
+ * Only available on Linux.
+ */
+
+struct stream_mem_entry_t {
+    /* Futex word of the reader / writer lock */
+    std::atomic<uint32_t> lock;
+    std::atomic<int32_t> refcount;
+    /* Written by the server only */
+    uint32_t state;
+    /* Incremented each time the entry is used for a new buffer */
+    uint32_t generation;
+    uint64_t size;
+};
+
+typedef struct {
+    /* Maps done because the buffer was not in the cache */
+    uint64_t nb_maps;
+    /* Descriptors mapped without a new map */
+    uint64_t nb_hits;
+    uint64_t nb_unmaps;
+    uint64_t mapped_bytes;
+    uint64_t peak_mapped_bytes;
+    /* Maps that left the cache above its budget because all the
+       cached mappings were still used by a descriptor */
+    uint64_t nb_over_budget;
+} stream_mapping_cache_stats_t;
+
+/*
+ * Mappings of the shared buffers of a process, keyed by global_id.
+ *
+ * A mapping is shared by all the descriptors of the same buffer. When no
+ * descriptor is using it, it is kept in a LRU list so that a buffer
+ * received again (a recycled buffer or a tensor sent again to this
+ * process) is not mapped again. Unused mappings are unmapped, least
+ * recently used first, when the mapped bytes are above the budget
+ * (CMSISSTREAM_MAPPING_CACHE_BYTES by default).
+ *
+ * The generation of the table entry is part of the key so that a
+ * global_id recycled for another buffer never reuses an old mapping.
+ */
+class PosixMappingCache {
+  public:
+    explicit PosixMappingCache(std::size_t budget) : budget_(budget) {}
+    ~PosixMappingCache();
+
+    /* Return nullptr if the buffer can't be mapped */
+    void *map(int32_t global_id, uint32_t generation, int fd, std::size_t size);
+    void unmap(int32_t global_id, uint32_t generation);
+    /* Unmap the unused mappings of a buffer that has been destroyed */
+    void forget(int32_t global_id);
+
+    void setBudget(std::size_t budget);
+    void stats(stream_mapping_cache_stats_t &stats) const;
+
+  private:
+    struct Mapping {
+        void *data;
+        std::size_t size;
+        uint32_t users;
+        std::list<uint64_t>::iterator lru;
+    };
+
+    static uint64_t key(int32_t global_id, uint32_t generation) noexcept
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(global_id)) << 32) | generation;
+    }
+    void evict();
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Mapping> mappings_;
+    /* Unused mappings. Least recently used first. */
+    std::list<uint64_t> lru_;
+    std::size_t budget_;
+    stream_mapping_cache_stats_t stats_ = {0, 0, 0, 0, 0, 0};
+};
+
+/*
+ * Descriptors are mapped through the mapping cache of
+ * MemServer::mem_server that must be a PosixMemServer.
+ */
+class PosixDescriptor : public arm_cmsis_stream::Descriptor {
+  public:
+    /* fd is owned by the descriptor */
+    PosixDescriptor(arm_cmsis_stream::NativeHandle fd, size_t size, int32_t global_id);
+    ~PosixDescriptor();
+
+    /* Used for Descriptor::mk_new_descriptor */
+    static arm_cmsis_stream::Descriptor *make(arm_cmsis_stream::NativeHandle fd, size_t size,
+                                              int32_t global_id);
+
+    void mapDescriptor() const final;
+    arm_cmsis_stream::NativeHandle fd() const noexcept final;
+    explicit operator bool() const noexcept final;
+
+  private:
+    int fd_;
+    uint32_t generation_ = 0;
+    /* The mapping belongs to the mapping cache */
+    mutable bool cached_ = false;
+};
+
+class PosixMemServer : public arm_cmsis_stream::MemServer {
+  public:
+    /*
+     * Connect to the server listening on socket_path.
+     * Return nullptr in case of error.
+     */
+    static PosixMemServer *connect(const char *socket_path);
+    ~PosixMemServer();
+
+    PosixMemServer(const PosixMemServer &) = delete;
+    PosixMemServer &operator=(const PosixMemServer &) = delete;
+
+    int lock(int32_t offset) const final;
+    int unlock(int32_t offset) const final;
+    int read_lock(int32_t offset) const final;
+    int read_unlock(int32_t offset) const final;
+    int acquire(int32_t offset) const final;
+    int release(int32_t offset) const final;
+    int32_t refcount(int32_t offset) const final;
+
+    arm_cmsis_stream::Descriptor *new_buffer(size_t size) const final;
+    arm_cmsis_stream::Descriptor *get_buffer(int32_t global_id) const final;
+    arm_cmsis_stream::Descriptor *register_buffer(size_t size,
+                                                  arm_cmsis_stream::NativeHandle fd,
+                                                  int32_t node_id,
+                                                  int32_t local_id) const final;
+    void ack_notification() const final;
+
+    /*
+     * Called for each notification received from the server.
+     * The handler is called from the thread using the mem server.
+     */
+    using NotificationHandler = void (*)(void *data, int32_t node_id, int32_t local_id,
+                                         int32_t global_id);
+    void setNotificationHandler(NotificationHandler handler, void *data) noexcept;
+
+    /*
+     * Read the notifications already sent by the server without waiting.
+     * socket() can be used to wait for them with poll.
+     */
+    void pollNotifications() const;
+    int socket() const noexcept { return sock_; }
+
+    /* Generation of the table entry used by a buffer */
+    uint32_t generation(int32_t global_id) const noexcept;
+
+    PosixMappingCache &mappingCache() const noexcept { return cache_; }
+
+  private:
+    PosixMemServer() = default;
+
+    struct Notification {
+        int32_t node_id;
+        int32_t local_id;
+        int32_t global_id;
+    };
+
+    stream_mem_entry_t *entry(int32_t offset) const noexcept;
+    bool request(uint32_t type, int32_t global_id, int32_t node_id, int32_t local_id,
+                 uint64_t size, int send_fd, int32_t &status, int *recv_fd) const;
+    void dispatchNotifications() const;
+
+    int sock_ = -1;
+    stream_mem_entry_t *table_ = nullptr;
+    uint32_t nb_entries_ = 0;
+
+    mutable std::mutex mutex_;
+    mutable std::deque<Notification> notifications_;
+    NotificationHandler notificationHandler_ = nullptr;
+    void *notificationData_ = nullptr;
+
+    mutable PosixMappingCache cache_{CMSISSTREAM_MAPPING_CACHE_BYTES};
+};
+
+/*
+ * Run the server until *stop is true (checked every 100 ms).
+ * It can be called from a dedicated process or from a thread of
+ * one of the processes of the graph.
+ * nb_entries is the maximum number of shared buffers alive at the
+ * same time. Return 0 when the server stopped normally.
+ */
+extern int stream_run_mem_server(const char *socket_path,
+                                 uint32_t nb_entries,
+                                 const std::atomic<bool> *stop);
@@ -0,0 +1,187 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_node_profiler.cpp
+ * Description:  Per-node execution profiler for the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_node_profiler.hpp"
+
+#include <cinttypes>
+#include <new>
+
+thread_local StreamNodeProfiler *cg_currentNodeProfiler = nullptr;
+
+StreamNodeProfiler *StreamNodeProfiler::create(uint32_t nbNodes)
+{
+    StreamNodeProfiler *profiler = new (std::nothrow) StreamNodeProfiler();
+    if (profiler == nullptr) {
+        return nullptr;
+    }
+    if (nbNodes > 0) {
+        profiler->stats_ = new (std::nothrow) NodeStats[nbNodes];
+        if (profiler->stats_ == nullptr) {
+            delete profiler;
+            return nullptr;
+        }
+    }
+    profiler->nbNodes_ = nbNodes;
+    profiler->reset();
+    return profiler;
+}
+
+StreamNodeProfiler::~StreamNodeProfiler()
+{
+    delete[] stats_;
+}
+
+uint32_t StreamNodeProfiler::bin(uint64_t ns) noexcept
+{
+    constexpr uint64_t maxValue = (uint64_t(2) << maxExponent) - 1;
+    if (ns > maxValue) {
+        ns = maxValue;
+    }
+    if (ns < (2U << subBinBits)) {
+        return static_cast<uint32_t>(ns);
+    }
+    uint32_t e = 63U - static_cast<uint32_t>(__builtin_clzll(ns));
+    uint32_t sub = static_cast<uint32_t>(ns >> (e - subBinBits)) & ((1U << subBinBits) - 1U);
+    return (2U << subBinBits) + ((e - subBinBits - 1U) << subBinBits) + sub;
+}
+
+uint64_t StreamNodeProfiler::binUpperBound(uint32_t b) noexcept
+{
+    if (b < (2U << subBinBits)) {
+        return b;
+    }
+    b -= (2U << subBinBits);
+    uint32_t e = (b >> subBinBits) + subBinBits + 1U;
+    uint64_t sub = b & ((1U << subBinBits) - 1U);
+    uint64_t width = uint64_t(1) << (e - subBinBits);
+    return ((uint64_t(1) << subBinBits) + sub) * width + width - 1U;
+}
+
+/*
+ * Single writer: the counters are updated with relaxed loads and stores
+ * rather than read-modify-write operations.
+ */
+void StreamNodeProfiler::record(int32_t id, uint64_t ns) noexcept
+{
+    if ((id < 0) || (static_cast<uint32_t>(id) >= nbNodes_)) {
+        return;
+    }
+    NodeStats &s = stats_[id];
+    uint64_t count = s.count.load(std::memory_order_relaxed);
+    if ((count == 0) || (ns < s.min.load(std::memory_order_relaxed))) {
+        s.min.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > s.max.load(std::memory_order_relaxed)) {
+        s.max.store(ns, std::memory_order_relaxed);
+    }
+    s.total.store(s.total.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    std::atomic<uint32_t> &b = s.bins[bin(ns)];
+    b.store(b.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    s.count.store(count + 1U, std::memory_order_relaxed);
+}
+
+void StreamNodeProfiler::nodeSkipped(int32_t id) noexcept
+{
+    started_ = false;
+    if ((id < 0) || (static_cast<uint32_t>(id) >= nbNodes_)) {
+        return;
+    }
+    NodeStats &s = stats_[id];
+    s.skips.store(s.skips.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+}
+
+void StreamNodeProfiler::reset() noexcept
+{
+    for (uint32_t i = 0; i < nbNodes_; i++) {
+        NodeStats &s = stats_[i];
+        s.count.store(0, std::memory_order_relaxed);
+        s.skips.store(0, std::memory_order_relaxed);
+        s.total.store(0, std::memory_order_relaxed);
+        s.min.store(0, std::memory_order_relaxed);
+        s.max.store(0, std::memory_order_relaxed);
+        for (uint32_t b = 0; b < nbBins; b++) {
+            s.bins[b].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void StreamNodeProfiler::snapshotNode(uint32_t id, stream_node_profile_t &p) const noexcept
+{
+    const NodeStats &s = stats_[id];
+    p.node_id = static_cast<int32_t>(id);
+    p.nb_executions = s.count.load(std::memory_order_relaxed);
+    p.nb_skips = s.skips.load(std::memory_order_relaxed);
+    p.total_ns = s.total.load(std::memory_order_relaxed);
+    p.min_ns = s.min.load(std::memory_order_relaxed);
+    p.max_ns = s.max.load(std::memory_order_relaxed);
+    p.p99_ns = 0;
+
+    // The bins may be read while they are updated so the rank is
+    // computed from their sum rather than from the count
+    uint64_t nb = 0;
+    uint32_t bins[nbBins];
+    for (uint32_t b = 0; b < nbBins; b++) {
+        bins[b] = s.bins[b].load(std::memory_order_relaxed);
+        nb += bins[b];
+    }
+    if (nb == 0) {
+        return;
+    }
+    uint64_t rank = (nb * 99U + 99U) / 100U;
+    uint64_t sum = 0;
+    for (uint32_t b = 0; b < nbBins; b++) {
+        sum += bins[b];
+        if (sum >= rank) {
+            uint64_t upper = binUpperBound(b);
+            p.p99_ns = (upper < p.max_ns) ? upper : p.max_ns;
+            return;
+        }
+    }
+}
+
+uint32_t StreamNodeProfiler::snapshot(stream_node_profile_t *profiles, uint32_t nb) const noexcept
+{
+    if (nb > nbNodes_) {
+        nb = nbNodes_;
+    }
+    for (uint32_t i = 0; i < nb; i++) {
+        snapshotNode(i, profiles[i]);
+    }
+    return nb;
+}
+
+bool StreamNodeProfiler::writeJSON(std::FILE *f) const
+{
+    bool first = true;
+    if (std::fprintf(f, "{\"nodes\":[") < 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < nbNodes_; i++) {
+        stream_node_profile_t p;
+        snapshotNode(i, p);
+        if ((p.nb_executions == 0) && (p.nb_skips == 0)) {
+            continue;
+        }
+        uint64_t mean = (p.nb_executions > 0) ? p.total_ns / p.nb_executions : 0;
+        int res = std::fprintf(f,
+                               "%s\n{\"id\":%" PRId32 ",\"count\":%" PRIu64
+                               ",\"skips\":%" PRIu64 ",\"total_ns\":%" PRIu64
+                               ",\"min_ns\":%" PRIu64 ",\"max_ns\":%" PRIu64
+                               ",\"mean_ns\":%" PRIu64 ",\"p99_ns\":%" PRIu64 "}",
+                               first ? "" : ",", p.node_id, p.nb_executions, p.nb_skips,
+                               p.total_ns, p.min_ns, p.max_ns, mean, p.p99_ns);
+        if (res < 0) {
+            return false;
+        }
+        first = false;
+    }
+    return std::fprintf(f, "\n]}\n") >= 0;
+}
@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_node_profiler.hpp
+ * Description:  Per-node execution profiler for the POSIX runtime
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "stream_platform_config.hpp"
+
+typedef struct {
+    int32_t node_id;
+    uint64_t nb_executions;
+    // CG_NODE_NOT_EXECUTED (asynchronous mode)
+    uint64_t nb_skips;
+    // Execution times in nanoseconds. min_ns and max_ns are 0 when the
+    // node was never executed.
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    // Estimated from a histogram with a relative error below 12.5%
+    uint64_t p99_ns;
+} stream_node_profile_t;
+
+/*
+ * Execution statistics of the nodes of a scheduler, collected by the hooks
+ * CG_BEFORE_NODE_EXECUTION, CG_AFTER_NODE_EXECUTION and CG_NODE_NOT_EXECUTED
+ * (see config/app_config.hpp) with steady_clock.
+ *
+ * The profiler of a context is set in the profiler field of the
+ * stream_execution_context_t. The statistics are indexed with the node IDs
+ * of the generated scheduler (the ID argument of the hooks). IDs greater or
+ * equal to nbNodes are ignored.
+ *
+ * Only the stream thread running the scheduler updates the statistics. The
+ * other threads can read them with snapshot at any time. reset is exact
+ * only when the scheduler is paused: an execution in progress during the
+ * reset may be partially counted.
+ *
+ * In asynchronous mode, the measured time includes the prepareForRunning
+ * check of the node.
+ */
+class StreamNodeProfiler {
+  public:
+    /* Return nullptr in case of allocation failure */
+    static StreamNodeProfiler *create(uint32_t nbNodes);
+    ~StreamNodeProfiler();
+
+    StreamNodeProfiler(const StreamNodeProfiler &) = delete;
+    StreamNodeProfiler &operator=(const StreamNodeProfiler &) = delete;
+
+    /* Called by the hooks on the stream thread */
+    void beforeNode() noexcept
+    {
+        start_ns_ = now_ns();
+        started_ = true;
+    }
+
+    void afterNode(int32_t id) noexcept
+    {
+        if (started_) {
+            started_ = false;
+            record(id, now_ns() - start_ns_);
+        }
+    }
+
+    void nodeSkipped(int32_t id) noexcept;
+
+    uint32_t nbNodes() const noexcept { return nbNodes_; }
+
+    /*
+     * Copy the statistics of the first nb nodes to profiles.
+     * Return the number of copied nodes.
+     */
+    uint32_t snapshot(stream_node_profile_t *profiles, uint32_t nb) const noexcept;
+    void reset() noexcept;
+
+    /*
+     * Write the statistics of the nodes executed or skipped at least once
+     * as a JSON object:
+     * {"nodes":[{"id":0,"count":..,"skips":..,"total_ns":..,"min_ns":..,
+     *            "max_ns":..,"mean_ns":..,"p99_ns":..},...]}
+     * Return false in case of write error.
+     */
+    bool writeJSON(std::FILE *f) const;
+
+  private:
+    /*
+     * Log-linear histogram: exact values below 16 ns, then 8 bins for each
+     * power of two up to 2^40 ns.
+     */
+    static constexpr uint32_t subBinBits = 3;
+    static constexpr uint32_t maxExponent = 40;
+    static constexpr uint32_t nbBins =
+        (2U << subBinBits) + (maxExponent - subBinBits) * (1U << subBinBits);
+
+    struct NodeStats {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> skips;
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+        std::atomic<uint32_t> bins[nbBins];
+    };
+
+    StreamNodeProfiler() = default;
+
+    static uint64_t now_ns() noexcept
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(
+            duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    static uint32_t bin(uint64_t ns) noexcept;
+    static uint64_t binUpperBound(uint32_t b) noexcept;
+
+    void record(int32_t id, uint64_t ns) noexcept;
+    void snapshotNode(uint32_t id, stream_node_profile_t &p) const noexcept;
+
+    NodeStats *stats_ = nullptr;
+    uint32_t nbNodes_ = 0;
+
+    // Only used by the stream thread
+    uint64_t start_ns_ = 0;
+    bool started_ = false;
+};
+
+/*
+ * Profiler of the scheduler running on the current stream thread.
+ * It is the profiler field of its execution context.
+ */
+extern thread_local StreamNodeProfiler *cg_currentNodeProfiler;
+
+/*
+ * Hooks used by config/app_config.hpp. When CMSISSTREAM_NODE_PROFILER is 0
+ * they are empty. Otherwise, they only test cg_currentNodeProfiler when no
+ * profiler is set.
+ */
+#if CMSISSTREAM_NODE_PROFILER
+#define STREAM_PROFILE_BEFORE_NODE(ID)                                              \
+    {                                                                               \
+        StreamNodeProfiler *cg_profiler = cg_currentNodeProfiler;                   \
+        if (cg_profiler != nullptr)                                                 \
+        {                                                                           \
+            cg_profiler->beforeNode();                                              \
+        }                                                                           \
+    }
+
+#define STREAM_PROFILE_AFTER_NODE(ID)                                               \
+    {                                                                               \
+        StreamNodeProfiler *cg_profiler = cg_currentNodeProfiler;                   \
+        if (cg_profiler != nullptr)                                                 \
+        {                                                                           \
+            cg_profiler->afterNode((ID));                                           \
+        }                                                                           \
+    }
+
+#define STREAM_PROFILE_NODE_SKIPPED(ID)                                             \
+    {                                                                               \
+        StreamNodeProfiler *cg_profiler = cg_currentNodeProfiler;                   \
+        if (cg_profiler != nullptr)                                                 \
+        {                                                                           \
+            cg_profiler->nodeSkipped((ID));                                         \
+        }                                                                           \
+    }
+#else
+#define STREAM_PROFILE_BEFORE_NODE(ID)
+#define STREAM_PROFILE_AFTER_NODE(ID)
+#define STREAM_PROFILE_NODE_SKIPPED(ID)
+#endif
@@ -40,6 +40,42 @@ enum class ThreadPriority
 #define CMSISSTREAM_EVENT_QUEUE_LENGTH 20
 #endif
 
+#ifndef CMSISSTREAM_NB_EVENT_WORKERS
+#define CMSISSTREAM_NB_EVENT_WORKERS 2
+#endif
+
+#ifndef CMSISSTREAM_EVENT_SHARD_QUANTUM
+#define CMSISSTREAM_EVENT_SHARD_QUANTUM 8
+#endif
+
+#ifndef CMSISSTREAM_NB_INIT_WORKERS
+#define CMSISSTREAM_NB_INIT_WORKERS 4
+#endif
+
+#ifndef CMSISSTREAM_NODE_PROFILER
+#define CMSISSTREAM_NODE_PROFILER 0
+#endif
+
+#ifndef CMSISSTREAM_EVENT_LOG_FLUSH_MS
+#define CMSISSTREAM_EVENT_LOG_FLUSH_MS 100
+#endif
+
+#ifndef CMSISSTREAM_MAPPING_CACHE_BYTES
+#define CMSISSTREAM_MAPPING_CACHE_BYTES (64 * 1024 * 1024)
+#endif
+
+#ifndef CMSISSTREAM_IPC_SPIN_COUNT
+#define CMSISSTREAM_IPC_SPIN_COUNT 2000
+#endif
+
+#ifndef CMSISSTREAM_IPC_BATCH_BYTES
+#define CMSISSTREAM_IPC_BATCH_BYTES 65536
+#endif
+
+#ifndef CMSISSTREAM_IPC_MAX_FDS
+#define CMSISSTREAM_IPC_MAX_FDS 64
+#endif
+
 #ifndef CMSISSTREAM_EVT_HIGH_PRIORITY
 #define CMSISSTREAM_EVT_HIGH_PRIORITY ThreadPriority::High
 #endif
@@ -3,15 +3,20 @@
 #include "EventQueue.hpp"
 #include "StreamNode.hpp"
 #include "cg_enums.h"
+#include "stream_event_log.hpp"
 #include "stream_event_queue.hpp"
+#include "stream_node_profiler.hpp"
 #include "stream_rtos_events.h"
 #include "stream_runtime_init.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <memory_resource>
 #include <new>
 #include <thread>
+#include <vector>
 
 using namespace arm_cmsis_stream;
 
@@ -19,6 +24,7 @@ std::pmr::synchronized_pool_resource pool;
 
 stream_event_flags cg_streamEvent;
 stream_event_flags cg_streamReplyEvent;
+thread_local stream_event_flags *cg_currentStreamEvent = &cg_streamEvent;
 
 extern void stream_set_current_thread_priority(ThreadPriority priority);
 
@@ -184,6 +190,87 @@ static void pause_peer_stream_thread(stream_execution_context_t *context)
     }
 }
 
+static std::atomic<stream_execution_context_t *> standby_context = nullptr;
+static std::mutex switch_mutex;
+// Written with switch_mutex held before STREAM_SWITCH_EVENT is posted
+static std::chrono::steady_clock::time_point switch_request;
+static std::mutex switch_stats_mutex;
+static stream_switch_stats_t switch_stats = {};
+static thread_local bool iteration_switch = false;
+// True while the stream thread runs its scheduler: only then is a switch
+// request consumed by stream_iteration_switch.
+// switch_state_mutex makes the check of stream_running and the switch
+// request atomic with respect to the stream thread leaving the scheduler.
+static std::mutex switch_state_mutex;
+static bool stream_running = false;
+
+bool stream_iteration_switch()
+{
+    if (cg_currentStreamEvent->wait(STREAM_SWITCH_EVENT, true, 0) == 0U) {
+        return false;
+    }
+    iteration_switch = true;
+    return true;
+}
+
+/*
+ * Called by the stream thread when it enters or leaves its scheduler.
+ * A switch still pending when the scheduler is left is cancelled and the
+ * waiting stream_switch_scheduler is woken.
+ */
+static void set_stream_running(bool running)
+{
+    std::lock_guard<std::mutex> lock(switch_state_mutex);
+    stream_running = running;
+    if (!running && (standby_context.exchange(nullptr) != nullptr)) {
+        cg_streamEvent.clear(STREAM_SWITCH_EVENT);
+        cg_streamReplyEvent.post(STREAM_SWITCHED_EVENT);
+    }
+}
+
+/*
+ * Called by the stream thread when the scheduler has been paused.
+ * Return true when the pause was an iteration switch.
+ */
+static bool switch_to_standby(stream_execution_context_t *context)
+{
+    if (!iteration_switch) {
+        return false;
+    }
+    iteration_switch = false;
+
+    stream_execution_context_t *standby = standby_context.exchange(nullptr);
+    if (standby == nullptr) {
+        // Switch cancelled after a timeout
+        return true;
+    }
+
+    standby->evtQueue->resume();
+    set_current_context(standby);
+    // The event thread leaves the paused queue and serves the new one
+    context->evtQueue->pause();
+    if (context->pause_all_nodes) {
+        context->pause_all_nodes(context);
+    }
+    if (standby->resume_all_nodes) {
+        standby->resume_all_nodes(standby);
+    }
+
+    uint32_t us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                            std::chrono::steady_clock::now() - switch_request)
+                                            .count());
+    {
+        std::lock_guard<std::mutex> lock(switch_stats_mutex);
+        switch_stats.nb_switches++;
+        switch_stats.last_us = us;
+        switch_stats.max_us = std::max(switch_stats.max_us, us);
+        switch_stats.total_us += us;
+    }
+    cg_streamReplyEvent.post(STREAM_SWITCHED_EVENT);
+    CMSISSTREAM_LOG_DBG("Switched scheduler in %u us\n", us);
+    return true;
+}
+
 static void event_thread_function()
 {
     stream_set_current_thread_priority(CMSISSTREAM_EVT_HIGH_PRIORITY);
@@ -202,6 +289,10 @@ static void event_thread_function()
             int32_t event_error_info;
             bool has_error = queue->consumeError(event_error, event_error_node,
                                                  event_error_info);
+            if (!has_error && (current_context.load() != context)) {
+                // The stream thread switched to a standby context
+                continue;
+            }
             if (has_error) {
                 pause_peer_stream_thread(context);
             }
@@ -227,15 +318,23 @@ static void event_thread_function()
 static void stream_thread_function()
 {
     stream_set_current_thread_priority(CMSISSTREAM_STREAM_THREAD_PRIORITY);
+    cg_currentEventOrigin = STREAM_EVENT_FROM_DATAFLOW;
 
-    uint32_t nb_iter = 0;
+    [[maybe_unused]] uint32_t nb_iter = 0;
     int error = CG_SUCCESS;
     bool done = false;
     CMSISSTREAM_LOG_DBG("Stream thread started\n");
 
     while (!done) {
         stream_execution_context_t *context = current_context.load();
+        cg_currentNodeProfiler = context->profiler;
+        set_stream_running(true);
         nb_iter = context->dataflow_scheduler(&error);
+        if ((error == CG_PAUSED_SCHEDULER) && switch_to_standby(context)) {
+            continue;
+        }
+        // No switch is possible until the scheduler is running again
+        set_stream_running(false);
         if (is_runtime_scheduler_error(error)) {
             CMSISSTREAM_LOG_ERR("Scheduler error %d\n", error);
             pause_stream_thread_on_error(context, static_cast<cg_status>(error));
@@ -324,6 +423,88 @@ bool stream_resume_scheduler(stream_execution_context_t *context)
     return true;
 }
 
+bool stream_prepare_standby(stream_execution_context_t *context)
+{
+    if ((context == nullptr) || (context->evtQueue == nullptr)) {
+        CMSISSTREAM_LOG_ERR("Can't prepare standby scheduler with invalid context\n");
+        return false;
+    }
+    if (context == current_context.load()) {
+        CMSISSTREAM_LOG_ERR("The current scheduler can't be a standby scheduler\n");
+        return false;
+    }
+    context->evtQueue->pause();
+    context->reset_fifos(1);
+    if (context->pause_all_nodes) {
+        context->pause_all_nodes(context);
+    }
+    return true;
+}
+
+bool stream_switch_scheduler(stream_execution_context_t *context, uint32_t timeout_ms)
+{
+    std::lock_guard<std::mutex> lock(switch_mutex);
+    stream_execution_context_t *current = current_context.load();
+    if ((context == nullptr) || (context->evtQueue == nullptr) || (current == nullptr)) {
+        CMSISSTREAM_LOG_ERR("Can't switch stream scheduler with invalid context\n");
+        return false;
+    }
+    if (context == current) {
+        return true;
+    }
+    if ((context->scheduler_length == 0) || (current->scheduler_length == 0)) {
+        CMSISSTREAM_LOG_ERR("Can't switch to or from a scheduler without dataflow\n");
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> state_lock(switch_state_mutex);
+        // A paused or stopped scheduler never reaches the iteration switch
+        if (!stream_running) {
+            CMSISSTREAM_LOG_ERR("Can't switch a stream scheduler that is not running\n");
+            return false;
+        }
+        switch_request = std::chrono::steady_clock::now();
+        cg_streamReplyEvent.clear(STREAM_SWITCHED_EVENT);
+        standby_context.store(context);
+        cg_streamEvent.post(STREAM_SWITCH_EVENT);
+    }
+
+    uint32_t res = cg_streamReplyEvent.wait(STREAM_SWITCHED_EVENT, true, timeout_ms);
+    if (res == 0U) {
+        if (standby_context.exchange(nullptr) != nullptr) {
+            cg_streamEvent.clear(STREAM_SWITCH_EVENT);
+            CMSISSTREAM_LOG_ERR("Stream scheduler not switched after %u ms\n", timeout_ms);
+            return false;
+        }
+        // The stream thread is already switching or has left its scheduler
+        res = cg_streamReplyEvent.wait(STREAM_SWITCHED_EVENT, true, timeout_ms);
+        if (res == 0U) {
+            CMSISSTREAM_LOG_ERR("Stream scheduler not switched after %u ms\n", timeout_ms);
+            return false;
+        }
+    }
+    // The switch is cancelled when the scheduler is left before the
+    // next iteration
+    if (current_context.load() != context) {
+        CMSISSTREAM_LOG_ERR("Stream scheduler left before the switch\n");
+        return false;
+    }
+    return true;
+}
+
+void stream_switch_stats(stream_switch_stats_t *stats)
+{
+    std::lock_guard<std::mutex> lock(switch_stats_mutex);
+    *stats = switch_stats;
+}
+
+void stream_reset_switch_stats()
+{
+    std::lock_guard<std::mutex> lock(switch_stats_mutex);
+    switch_stats = {};
+}
+
 int stream_init_memory()
 {
     CMSISSTREAM_LOG_DBG("Initializing stream memory\n");
@@ -445,3 +626,594 @@ EventQueue *stream_new_event_queue()
                                                                CMSISSTREAM_EVT_HIGH_PRIORITY);
     return static_cast<EventQueue *>(queue);
 }
+
+enum node_init_state_t {
+    kInitNotStarted,
+    kInitPending,
+    kInitDone
+};
+
+static std::mutex init_mutex;
+static std::condition_variable init_done_cv;
+// Indexed by node ID. Protected by init_mutex
+static std::vector<node_init_state_t> init_states;
+static std::vector<std::chrono::steady_clock::time_point> init_starts;
+static std::vector<stream_node_init_time_t> init_times;
+static uint32_t init_nb_pending = 0;
+static cg_status init_error = CG_SUCCESS;
+
+static void init_worker_function(stream_execution_context_t *context,
+                                 std::atomic<uint32_t> *next_node)
+{
+    while (true) {
+        uint32_t nodeID = next_node->fetch_add(1);
+        if (nodeID >= context->nb_identified_nodes) {
+            return;
+        }
+
+        // The node is pending before the event is sent because the
+        // completion may be reported before the callback returns
+        {
+            std::lock_guard<std::mutex> lock(init_mutex);
+            init_states[nodeID] = kInitPending;
+            init_starts[nodeID] = std::chrono::steady_clock::now();
+            init_nb_pending++;
+        }
+
+        bool started = context->start_node_initialization(context, static_cast<int32_t>(nodeID));
+        if (!started) {
+            std::lock_guard<std::mutex> lock(init_mutex);
+            if (init_states[nodeID] == kInitPending) {
+                init_states[nodeID] = kInitNotStarted;
+                init_nb_pending--;
+                if (init_nb_pending == 0) {
+                    init_done_cv.notify_all();
+                }
+            }
+        }
+    }
+}
+
+static void end_node_init(uint32_t nodeID, cg_status status)
+{
+    auto end = std::chrono::steady_clock::now();
+    uint32_t us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - init_starts[nodeID]).count());
+    init_states[nodeID] = kInitDone;
+    init_times.push_back({static_cast<int32_t>(nodeID), static_cast<int32_t>(status), us});
+    if ((status != CG_SUCCESS) && (init_error == CG_SUCCESS)) {
+        init_error = status;
+    }
+    init_nb_pending--;
+    if (init_nb_pending == 0) {
+        init_done_cv.notify_all();
+    }
+}
+
+cg_status stream_init_nodes(stream_execution_context_t *context, uint32_t timeout_ms)
+{
+    if (context == nullptr) {
+        CMSISSTREAM_LOG_ERR("Can't initialize nodes with invalid context\n");
+        return CG_INIT_FAILURE;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(init_mutex);
+        init_states.assign(context->nb_identified_nodes, kInitNotStarted);
+        init_starts.resize(context->nb_identified_nodes);
+        init_times.clear();
+        init_times.reserve(context->nb_identified_nodes);
+        init_nb_pending = 0;
+        init_error = CG_SUCCESS;
+    }
+
+    if ((context->start_node_initialization == nullptr) ||
+        (context->nb_identified_nodes == 0)) {
+        return CG_SUCCESS;
+    }
+
+    CMSISSTREAM_LOG_DBG("Starting asynchronous node initializations\n");
+    auto start = std::chrono::steady_clock::now();
+
+    std::atomic<uint32_t> next_node = 0;
+    uint32_t nb_workers = std::min<uint32_t>(CMSISSTREAM_NB_INIT_WORKERS,
+                                             context->nb_identified_nodes);
+    std::vector<std::thread> workers;
+    workers.reserve(nb_workers);
+    try {
+        for (uint32_t i = 0; i < nb_workers; i++) {
+            workers.emplace_back(init_worker_function, context, &next_node);
+        }
+    } catch (...) {
+        CMSISSTREAM_LOG_ERR("Failed to start all the node initialization workers\n");
+    }
+    // Without any worker, the initializations are started from this thread
+    if (workers.empty()) {
+        init_worker_function(context, &next_node);
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    cg_status status;
+    {
+        std::unique_lock<std::mutex> lock(init_mutex);
+        auto done = [] { return init_nb_pending == 0; };
+        bool finished = true;
+        if (timeout_ms == STREAM_WAIT_FOREVER) {
+            init_done_cv.wait(lock, done);
+        } else {
+            finished = init_done_cv.wait_until(lock, start + std::chrono::milliseconds(timeout_ms), done);
+        }
+
+        if (!finished) {
+            for (uint32_t nodeID = 0; nodeID < init_states.size(); nodeID++) {
+                if (init_states[nodeID] == kInitPending) {
+                    CMSISSTREAM_LOG_ERR("Node %u not initialized after %u ms\n", nodeID, timeout_ms);
+                    end_node_init(nodeID, CG_INIT_FAILURE);
+                }
+            }
+        }
+
+        for ([[maybe_unused]] const stream_node_init_time_t &t : init_times) {
+            CMSISSTREAM_LOG_DBG("Node %d initialized in %u us (status %d)\n",
+                                t.node_id, t.init_time_us, t.status);
+        }
+        status = init_error;
+    }
+
+    [[maybe_unused]] uint32_t total_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+            .count());
+    CMSISSTREAM_LOG_DBG("Node initializations done in %u us\n", total_us);
+    return status;
+}
+
+bool stream_node_init_event(int src_node_id, Event &evt)
+{
+    (void)src_node_id;
+    uint32_t nodeID = 0;
+    cg_status status = CG_SUCCESS;
+
+    if ((evt.event_id == kNodeWasInitialized) && evt.wellFormed<uint32_t>()) {
+        nodeID = evt.get<uint32_t>();
+    } else if ((evt.event_id == kError) && evt.wellFormed<uint32_t, int32_t>()) {
+        evt.apply<uint32_t, int32_t>([&nodeID, &status](uint32_t id, int32_t error) {
+            nodeID = id;
+            status = static_cast<cg_status>(error);
+        });
+    } else {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(init_mutex);
+    if ((nodeID >= init_states.size()) || (init_states[nodeID] != kInitPending)) {
+        return false;
+    }
+    end_node_init(nodeID, status);
+    return true;
+}
+
+uint32_t stream_node_init_times(const stream_node_init_time_t **times)
+{
+    std::lock_guard<std::mutex> lock(init_mutex);
+    if (times != nullptr) {
+        *times = init_times.data();
+    }
+    return static_cast<uint32_t>(init_times.size());
+}
+
+struct stream_shard_t_ {
+    stream_execution_context_t *context = nullptr;
+    PosixEventQueue *queue = nullptr;
+    std::thread *stream_thread = nullptr;
+    stream_event_flags streamEvent;
+    stream_event_flags replyEvent;
+    std::atomic<bool> stop_requested = false;
+
+    // Protected by shard_mutex
+    bool queued = false;
+    bool running = false;
+    bool pending = false;
+    bool release_when_idle = false;
+
+    // Only used by the shard stream thread
+    bool release_on_stream_exit = false;
+};
+
+static std::mutex shard_mutex;
+static std::condition_variable shard_ready_cv;
+static std::condition_variable shard_idle_cv;
+static std::deque<stream_shard_t *> ready_shards;
+static std::vector<stream_shard_t *> active_shards;
+static std::thread *event_workers[CMSISSTREAM_NB_EVENT_WORKERS] = {};
+static bool event_workers_started = false;
+static bool event_workers_stop_requested = false;
+
+static thread_local stream_shard_t *worker_shard = nullptr;
+static thread_local stream_shard_t *stream_thread_shard = nullptr;
+
+// Called with shard_mutex held
+static void enqueue_shard(stream_shard_t *shard)
+{
+    if (shard->running) {
+        shard->pending = true;
+        return;
+    }
+    if (!shard->queued) {
+        shard->queued = true;
+        ready_shards.push_back(shard);
+        shard_ready_cv.notify_one();
+    }
+}
+
+static void shard_ready_notifier(void *data)
+{
+    std::lock_guard<std::mutex> lock(shard_mutex);
+    enqueue_shard(static_cast<stream_shard_t *>(data));
+}
+
+static void wait_shard_idle(stream_shard_t *shard)
+{
+    if (worker_shard == shard) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(shard_mutex);
+    shard_idle_cv.wait(lock, [shard] { return !shard->running; });
+}
+
+static void pause_shard_nodes(stream_shard_t *shard)
+{
+    stream_execution_context_t *context = shard->context;
+    if (context->pause_all_nodes) {
+        context->pause_all_nodes(context);
+    }
+}
+
+static void shard_event_error(stream_shard_t *shard, cg_status status,
+                              int32_t node_id, int32_t info)
+{
+    shard->queue->pause();
+    if (shard->stream_thread != nullptr) {
+        // The stream thread pauses the nodes once this worker has
+        // released the shard.
+        shard->streamEvent.post(STREAM_PAUSE_EVENT);
+    } else {
+        pause_shard_nodes(shard);
+    }
+    report_runtime_error(kEventThread, status, node_id, info);
+}
+
+static void event_worker_function()
+{
+    stream_set_current_thread_priority(CMSISSTREAM_EVT_HIGH_PRIORITY);
+    CMSISSTREAM_LOG_DBG("Started event worker\n");
+
+    while (true) {
+        stream_shard_t *shard = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(shard_mutex);
+            shard_ready_cv.wait(lock, [] {
+                return event_workers_stop_requested || !ready_shards.empty();
+            });
+            if (event_workers_stop_requested) {
+                break;
+            }
+            shard = ready_shards.front();
+            ready_shards.pop_front();
+            shard->queued = false;
+            shard->pending = false;
+            shard->running = true;
+        }
+
+        worker_shard = shard;
+        PosixEventQueue *queue = shard->queue;
+        (void)queue->executeBatch(CMSISSTREAM_EVENT_SHARD_QUANTUM);
+
+        cg_status event_error;
+        int32_t event_error_node;
+        int32_t event_error_info;
+        if (queue->consumeError(event_error, event_error_node, event_error_info)) {
+            shard_event_error(shard, event_error, event_error_node, event_error_info);
+        }
+        bool more = !queue->mustEnd() && !queue->mustPause() && !queue->isEmpty();
+        worker_shard = nullptr;
+
+        bool release = false;
+        {
+            std::lock_guard<std::mutex> lock(shard_mutex);
+            shard->running = false;
+            if (shard->release_when_idle) {
+                release = true;
+            } else if ((more || shard->pending) && !shard->stop_requested.load()) {
+                // Go to the end of the ready list so that other shards
+                // are served before this one is run again.
+                enqueue_shard(shard);
+            }
+            shard->pending = false;
+        }
+        shard_idle_cv.notify_all();
+        if (release) {
+            delete shard;
+        }
+    }
+    CMSISSTREAM_LOG_DBG("Event worker done\n");
+}
+
+static bool start_event_workers()
+{
+    std::lock_guard<std::mutex> lock(shard_mutex);
+    if (event_workers_started) {
+        return true;
+    }
+    event_workers_stop_requested = false;
+    try {
+        for (uint32_t i = 0; i < CMSISSTREAM_NB_EVENT_WORKERS; i++) {
+            event_workers[i] = new std::thread(event_worker_function);
+        }
+    } catch (...) {
+        CMSISSTREAM_LOG_ERR("Failed to start event workers\n");
+        event_workers_stop_requested = true;
+        shard_ready_cv.notify_all();
+        for (uint32_t i = 0; i < CMSISSTREAM_NB_EVENT_WORKERS; i++) {
+            if (event_workers[i] != nullptr) {
+                // Workers exit as soon as they can lock shard_mutex
+                event_workers[i]->detach();
+                delete event_workers[i];
+                event_workers[i] = nullptr;
+            }
+        }
+        return false;
+    }
+    event_workers_started = true;
+    CMSISSTREAM_LOG_DBG("Event workers started\n");
+    return true;
+}
+
+static void stop_event_workers(bool callerIsRuntimeThread)
+{
+    {
+        std::lock_guard<std::mutex> lock(shard_mutex);
+        if (!event_workers_started) {
+            return;
+        }
+        event_workers_stop_requested = true;
+        event_workers_started = false;
+    }
+    shard_ready_cv.notify_all();
+
+    for (uint32_t i = 0; i < CMSISSTREAM_NB_EVENT_WORKERS; i++) {
+        std::atomic<bool> started = true;
+        stop_thread(event_workers[i], started, callerIsRuntimeThread);
+    }
+}
+
+static bool wait_shard_resume(stream_shard_t *shard)
+{
+    stream_execution_context_t *context = shard->context;
+    while (true) {
+        uint32_t res = shard->streamEvent.wait(STREAM_RESUME_EVENT | STREAM_DONE_EVENT, true);
+        if (shard->stop_requested.load() || ((res & STREAM_DONE_EVENT) != 0)) {
+            return false;
+        }
+        if ((res & STREAM_RESUME_EVENT) == 0) {
+            continue;
+        }
+
+        context->reset_fifos(1);
+        if (context->resume_all_nodes) {
+            context->resume_all_nodes(context);
+        }
+        shard->replyEvent.post(STREAM_RESUMED_EVENT);
+        return true;
+    }
+}
+
+static void shard_stream_thread_function(stream_shard_t *shard)
+{
+    stream_set_current_thread_priority(CMSISSTREAM_STREAM_THREAD_PRIORITY);
+    cg_currentStreamEvent = &shard->streamEvent;
+    cg_currentEventOrigin = STREAM_EVENT_FROM_DATAFLOW;
+    stream_thread_shard = shard;
+
+    stream_execution_context_t *context = shard->context;
+    [[maybe_unused]] uint32_t nb_iter = 0;
+    int error = CG_SUCCESS;
+    CMSISSTREAM_LOG_DBG("Shard stream thread started\n");
+
+    while (!shard->stop_requested.load()) {
+        cg_currentNodeProfiler = context->profiler;
+        nb_iter = context->dataflow_scheduler(&error);
+        if (shard->stop_requested.load()) {
+            break;
+        }
+        if (is_runtime_scheduler_error(error)) {
+            CMSISSTREAM_LOG_ERR("Scheduler error %d\n", error);
+            shard->queue->pause();
+            wait_shard_idle(shard);
+            pause_shard_nodes(shard);
+            report_runtime_error(kStreamThread, static_cast<cg_status>(error),
+                                 CG_UNIDENTIFIED_NODE, 0);
+        } else if (error == CG_STOP_SCHEDULER) {
+            CMSISSTREAM_LOG_DBG("Scheduler requested stop graph\n");
+            shard->queue->pause();
+            wait_shard_idle(shard);
+            pause_shard_nodes(shard);
+            report_stop_graph();
+        } else if (error == CG_PAUSED_SCHEDULER) {
+            wait_shard_idle(shard);
+            pause_shard_nodes(shard);
+        } else {
+            break;
+        }
+        shard->replyEvent.post(STREAM_PAUSED_EVENT);
+        if (!wait_shard_resume(shard)) {
+            break;
+        }
+    }
+    CMSISSTREAM_LOG_DBG("Shard scheduler done after %u iterations\n", nb_iter);
+    if (shard->release_on_stream_exit) {
+        delete shard;
+    }
+}
+
+stream_shard_t *stream_start_shard(stream_execution_context_t *context)
+{
+    if ((context == nullptr) || (context->evtQueue == nullptr)) {
+        CMSISSTREAM_LOG_ERR("Can't start shard with invalid context\n");
+        return nullptr;
+    }
+
+    if (!start_event_workers()) {
+        return nullptr;
+    }
+
+    stream_shard_t *shard = new (std::nothrow) stream_shard_t;
+    if (shard == nullptr) {
+        CMSISSTREAM_LOG_ERR("Can't allocate shard\n");
+        return nullptr;
+    }
+    shard->context = context;
+    shard->queue = static_cast<PosixEventQueue *>(context->evtQueue);
+    shard->queue->setReadyNotifier(shard_ready_notifier, shard);
+
+    if (context->scheduler_length > 0) {
+        try {
+            shard->stream_thread = new std::thread(shard_stream_thread_function, shard);
+        } catch (...) {
+            CMSISSTREAM_LOG_ERR("Failed to start shard stream thread\n");
+            shard->queue->setReadyNotifier(nullptr, nullptr);
+            delete shard;
+            return nullptr;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shard_mutex);
+        active_shards.push_back(shard);
+        // Events may have been pushed before the shard was started
+        enqueue_shard(shard);
+    }
+
+    CMSISSTREAM_LOG_DBG("Shard started\n");
+    return shard;
+}
+
+bool stream_pause_shard(stream_shard_t *shard)
+{
+    if (shard == nullptr) {
+        return false;
+    }
+    CMSISSTREAM_LOG_DBG("Try to pause shard\n");
+    shard->queue->pause();
+
+    if (shard->stream_thread != nullptr) {
+        shard->streamEvent.post(STREAM_PAUSE_EVENT);
+        (void)shard->replyEvent.wait(STREAM_PAUSED_EVENT, true);
+    } else {
+        wait_shard_idle(shard);
+        pause_shard_nodes(shard);
+    }
+
+    wait_shard_idle(shard);
+    shard->queue->clear();
+    CMSISSTREAM_LOG_DBG("Shard paused\n");
+    return true;
+}
+
+bool stream_resume_shard(stream_shard_t *shard)
+{
+    if (shard == nullptr) {
+        return false;
+    }
+    CMSISSTREAM_LOG_DBG("Resuming shard\n");
+    stream_execution_context_t *context = shard->context;
+    shard->queue->resume();
+
+    if (shard->stream_thread != nullptr) {
+        shard->replyEvent.clear(STREAM_PAUSED_EVENT);
+        shard->streamEvent.post(STREAM_RESUME_EVENT);
+        uint32_t res = shard->replyEvent.wait(STREAM_RESUMED_EVENT | STREAM_PAUSED_EVENT, true);
+        if ((res & STREAM_PAUSED_EVENT) != 0) {
+            CMSISSTREAM_LOG_ERR("Shard stream thread failed to resume\n");
+            shard->queue->pause();
+            report_runtime_error(kStreamThread, CG_RESUME_FAILURE, CG_UNIDENTIFIED_NODE, 0);
+            return false;
+        }
+    } else if (context->resume_all_nodes) {
+        context->resume_all_nodes(context);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shard_mutex);
+        enqueue_shard(shard);
+    }
+    CMSISSTREAM_LOG_DBG("Shard resumed\n");
+    return true;
+}
+
+void stream_stop_shard(stream_shard_t *shard, bool callerIsRuntimeThread)
+{
+    if (shard == nullptr) {
+        return;
+    }
+
+    shard->stop_requested.store(true);
+    shard->queue->end();
+    // Wait for the notifications in progress and prevent new ones
+    // so that the shard can't be queued again once it is removed
+    // from the ready list
+    shard->queue->setReadyNotifier(nullptr, nullptr);
+    shard->streamEvent.post(STREAM_DONE_EVENT | STREAM_RESUME_EVENT);
+    shard->replyEvent.post(STREAM_PAUSED_EVENT | STREAM_RESUMED_EVENT);
+
+    if (shard->stream_thread != nullptr) {
+        std::atomic<bool> started = true;
+        stop_thread(shard->stream_thread, started, callerIsRuntimeThread);
+    }
+
+    bool release = true;
+    if (stream_thread_shard == shard) {
+        // Called from the shard stream thread which has been detached:
+        // the shard is released when the thread function returns.
+        shard->release_on_stream_exit = true;
+        release = false;
+    }
+    {
+        std::unique_lock<std::mutex> lock(shard_mutex);
+        if (shard->queued) {
+            ready_shards.erase(std::find(ready_shards.begin(), ready_shards.end(), shard));
+            shard->queued = false;
+        }
+        active_shards.erase(std::find(active_shards.begin(), active_shards.end(), shard));
+        if (worker_shard == shard) {
+            // Called from an event of this shard: the worker releases
+            // the shard when the current batch is finished.
+            shard->release_when_idle = true;
+            release = false;
+        } else {
+            shard_idle_cv.wait(lock, [shard] { return !shard->running; });
+        }
+    }
+
+    if (release) {
+        delete shard;
+    }
+    CMSISSTREAM_LOG_DBG("Shard stopped\n");
+}
+
+void stream_stop_shards(bool callerIsRuntimeThread)
+{
+    while (true) {
+        stream_shard_t *shard = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(shard_mutex);
+            if (active_shards.empty()) {
+                break;
+            }
+            shard = active_shards.back();
+        }
+        stream_stop_shard(shard, callerIsRuntimeThread);
+    }
+    stop_event_workers(callerIsRuntimeThread);
+}
@@ -24,13 +24,22 @@ class stream_event_flags {
 extern stream_event_flags cg_streamEvent;
 extern stream_event_flags cg_streamReplyEvent;
 
+/*
+ * Flags polled by CG_BEFORE_NODE_EXECUTION in the scheduler running on the
+ * current thread. It is cg_streamEvent for the single-context runtime and
+ * the shard flags for a stream thread started with stream_start_shard.
+ */
+extern thread_local stream_event_flags *cg_currentStreamEvent;
+
 struct stream_execution_context_t_;
+class StreamNodeProfiler;
 
 typedef uint32_t (*stream_scheduler)(int *error);
 typedef void (*stream_reset_fifos)(int all);
 typedef void (*pause_nodes)(const struct stream_execution_context_t_ *);
 typedef void (*resume_nodes)(const struct stream_execution_context_t_ *);
 typedef void *(*get_scheduler_node)(int32_t nodeID);
+typedef bool (*start_node_init)(const struct stream_execution_context_t_ *, int32_t nodeID);
 
 typedef struct stream_execution_context_t_ {
     stream_scheduler dataflow_scheduler;
@@ -41,10 +50,55 @@ typedef struct stream_execution_context_t_ {
     arm_cmsis_stream::EventQueue *evtQueue;
     uint32_t nb_identified_nodes;
     uint32_t scheduler_length;
+    // Send kStartNodeInitialization to a node. Return false when the
+    // node does not need an asynchronous initialization. Can be null.
+    start_node_init start_node_initialization;
+    // Statistics of the node executions (stream_node_profiler.hpp).
+    // Can be null.
+    StreamNodeProfiler *profiler;
 } stream_execution_context_t;
 
 extern void stream_pause_current_scheduler();
 extern bool stream_resume_scheduler(stream_execution_context_t *context);
+
+/*
+ * Double-buffered graph switching.
+ *
+ * stream_prepare_standby puts an initialized context in a standby state:
+ * FIFOs in their initial state, nodes paused and event queue paused.
+ * stream_switch_scheduler then makes it the active context. The stream
+ * thread swaps the contexts at the start of its next iteration, without
+ * resetting the FIFOs or clearing the event queues, so the previous context
+ * is itself left in a standby state and can be switched back later.
+ *
+ * The hook CG_BEFORE_ITERATION must call stream_iteration_switch (as in the
+ * config/app_config.hpp template). Both contexts must have a dataflow part.
+ * Use stream_pause_current_scheduler and stream_resume_scheduler otherwise.
+ *
+ * stream_switch_scheduler returns false when the current scheduler is not
+ * running (paused, stopped or threads not started), when it is left before
+ * its next iteration, or when the switch is not done within timeout_ms.
+ *
+ * The switch latency is the time between the request and the swap in the
+ * stream thread.
+ */
+typedef struct {
+    uint32_t nb_switches;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+} stream_switch_stats_t;
+
+extern bool stream_prepare_standby(stream_execution_context_t *context);
+extern bool stream_switch_scheduler(stream_execution_context_t *context,
+                                    uint32_t timeout_ms = STREAM_WAIT_FOREVER);
+/*
+ * Return true when a switch is requested. Called from CG_BEFORE_ITERATION
+ * that must then leave the scheduler with CG_PAUSED_SCHEDULER.
+ */
+extern bool stream_iteration_switch();
+extern void stream_switch_stats(stream_switch_stats_t *stats);
+extern void stream_reset_switch_stats();
 extern int stream_init_memory();
 extern bool stream_start_threads(stream_execution_context_t *context);
 /*
@@ -63,3 +117,72 @@ extern void stream_stop_threads(bool callerIsRuntimeThread = false);
 extern void stream_wait_for_threads_end();
 extern void stream_free_memory();
 extern arm_cmsis_stream::EventQueue *stream_new_event_queue();
+
+/*
+ * Asynchronous node initialization.
+ *
+ * stream_init_nodes calls start_node_initialization for all the identified
+ * nodes of the context from a pool of CMSISSTREAM_NB_INIT_WORKERS threads so
+ * that the initializations of the nodes overlap. It returns when all the
+ * started initializations are finished or after timeout_ms. It must be
+ * called before the stream thread is started.
+ *
+ * A node reports the end of its initialization to the application with
+ * kNodeWasInitialized (node ID as uint32_t) or kError (node ID as uint32_t
+ * and error code as int32_t). The application handler must forward those
+ * events to stream_node_init_event. The event thread is not yet running, so
+ * the events must be sent to the application synchronously.
+ *
+ * Return CG_SUCCESS, the error code of the first node that failed or
+ * CG_INIT_FAILURE when the timeout is reached.
+ */
+typedef struct {
+    int32_t node_id;
+    // CG_INIT_FAILURE when the initialization did not finish in time
+    int32_t status;
+    uint32_t init_time_us;
+} stream_node_init_time_t;
+
+extern cg_status stream_init_nodes(stream_execution_context_t *context,
+                                   uint32_t timeout_ms = STREAM_WAIT_FOREVER);
+/*
+ * Return true when the event was the end of an initialization started by
+ * stream_init_nodes.
+ */
+extern bool stream_node_init_event(int src_node_id, arm_cmsis_stream::Event &evt);
+/*
+ * Initialization times of the nodes with an asynchronous initialization
+ * during the last call to stream_init_nodes, in the order of completion.
+ * The array is valid until the next call to stream_init_nodes.
+ */
+extern uint32_t stream_node_init_times(const stream_node_init_time_t **times);
+
+/*
+ * Sharded runtime.
+ *
+ * Several execution contexts can be active at the same time. Each context
+ * owns a shard: its event queue and, when the graph has a dataflow part,
+ * its own stream thread. The event queues of all shards are served by a
+ * pool of CMSISSTREAM_NB_EVENT_WORKERS workers. A shard is run by only one
+ * worker at a time and at most CMSISSTREAM_EVENT_SHARD_QUANTUM events are
+ * processed before the worker moves to the next ready shard (round robin).
+ *
+ * The event queue of the context must be created with stream_new_event_queue.
+ * A generated scheduler uses global state, so two active contexts must come
+ * from different graphs.
+ */
+typedef struct stream_shard_t_ stream_shard_t;
+
+extern stream_shard_t *stream_start_shard(stream_execution_context_t *context);
+extern bool stream_pause_shard(stream_shard_t *shard);
+extern bool stream_resume_shard(stream_shard_t *shard);
+/*
+ * Stop the threads of a shard and release it. The shard pointer must no
+ * longer be used. callerIsRuntimeThread has the same meaning as for
+ * stream_stop_threads.
+ */
+extern void stream_stop_shard(stream_shard_t *shard, bool callerIsRuntimeThread = false);
+/*
+ * Stop all active shards and the event workers.
+ */
+extern void stream_stop_shards(bool callerIsRuntimeThread = false);
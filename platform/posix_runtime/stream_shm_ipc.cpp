@@ -0,0 +1,484 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_shm_ipc.cpp
+ * Description:  Shared memory IPC transport for Linux
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_shm_ipc.hpp"
+
+#include "cg_pack.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define STREAM_SHM_IPC_SUPPORTED
+#endif
+
+using namespace arm_cmsis_stream;
+
+#ifdef STREAM_SHM_IPC_SUPPORTED
+
+static constexpr uint32_t shm_ipc_magic = 0x43475348; // "CGSH"
+static constexpr uint32_t shm_ipc_version = 1;
+
+/* Length of a message going to the end of the ring: the reader restarts
+   from the beginning of the ring */
+static constexpr uint32_t wrap_marker = 0xFFFFFFFFu;
+/* Bit set in the length of a message that must be skipped */
+static constexpr uint32_t skip_bit = 0x80000000u;
+
+/*
+ * Encode an event in the ring. The shared buffers are acquired for the
+ * receiver as with PackInto and their global_id are recorded so that
+ * they can be released if the message is skipped.
+ */
+class RingPackInto : public PackEncoder<RingPackInto> {
+  public:
+    RingPackInto(uint8_t *dst, std::size_t capacity, std::vector<int32_t> &acquired)
+        : dst_(dst), capacity_(capacity), acquired_(acquired)
+    {
+        acquired_.clear();
+    }
+
+    /* False if the encoding does not exactly fill the buffer */
+    bool ok() const { return !overflow_ && (pos_ == capacity_); }
+
+    void releaseAcquired()
+    {
+        if (MemServer::mem_server != nullptr) {
+            for (int32_t id : acquired_) {
+                MemServer::mem_server->release(id);
+            }
+        }
+        acquired_.clear();
+    }
+
+  protected:
+    friend class PackEncoder<RingPackInto>;
+    static constexpr bool acquire_shared_buffers = true;
+
+    void write_bytes(const uint8_t *d, std::size_t nb)
+    {
+        if (overflow_ || (nb > capacity_ - pos_)) {
+            overflow_ = true;
+            return;
+        }
+        memcpy(dst_ + pos_, d, nb);
+        pos_ += nb;
+    }
+
+    void record_descriptor(const Descriptor &desc)
+    {
+        if (MemServer::mem_server != nullptr) {
+            acquired_.push_back(desc.global_id());
+        }
+    }
+
+  private:
+    uint8_t *dst_;
+    std::size_t capacity_;
+    std::size_t pos_ = 0;
+    bool overflow_ = false;
+    std::vector<int32_t> &acquired_;
+};
+
+/* Positions are free running and the size of a ring is a power of 2 */
+struct shm_ipc_ring_t {
+    alignas(64) std::atomic<uint32_t> head;
+    std::atomic<uint32_t> receiver_waiting;
+    alignas(64) std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> sender_waiting;
+};
+
+struct shm_ipc_segment_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring_size;
+    std::atomic<uint32_t> closed;
+    shm_ipc_ring_t rings[2];
+};
+
+static constexpr std::size_t data_offset = (sizeof(shm_ipc_segment_t) + 63) & ~std::size_t(63);
+
+static std::size_t segment_size(uint32_t ring_size)
+{
+    return data_offset + 2 * static_cast<std::size_t>(ring_size);
+}
+
+static uint32_t align8(std::size_t n)
+{
+    return static_cast<uint32_t>((n + 7) & ~std::size_t(7));
+}
+
+static void futex_wait(std::atomic<uint32_t> *word, uint32_t val)
+{
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, val, nullptr,
+                  nullptr, 0);
+}
+
+static void futex_wake(std::atomic<uint32_t> *word, int nb)
+{
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, nb, nullptr,
+                  nullptr, 0);
+}
+
+/* Spinning is useless when the peer can't run at the same time */
+static uint32_t spin_count()
+{
+    static const uint32_t count =
+        (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? CMSISSTREAM_IPC_SPIN_COUNT : 0;
+    return count;
+}
+
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+ShmIPC *ShmIPC::attach(int fd, std::size_t size)
+{
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+    ShmIPC *ipc = new (std::nothrow) ShmIPC();
+    if (ipc == nullptr) {
+        munmap(p, size);
+        return nullptr;
+    }
+    ipc->fd_ = fd;
+    ipc->segment_ = static_cast<shm_ipc_segment_t *>(p);
+    ipc->segment_size_ = size;
+    return ipc;
+}
+
+ShmIPC *ShmIPC::create(const char *name, std::size_t ring_size)
+{
+    uint32_t size = 4096;
+    while ((size < ring_size) && (size < (1U << 30))) {
+        size <<= 1;
+    }
+
+    int fd;
+    if (name != nullptr) {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    } else {
+        fd = memfd_create("cmsis_stream_ipc", MFD_CLOEXEC);
+    }
+    if (fd < 0) {
+        CMSISSTREAM_LOG_ERR("Can't create IPC shared memory\n");
+        return nullptr;
+    }
+    const std::size_t total = segment_size(size);
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        ::close(fd);
+        if (name != nullptr) {
+            shm_unlink(name);
+        }
+        return nullptr;
+    }
+    ShmIPC *ipc = attach(fd, total);
+    if (ipc == nullptr) {
+        ::close(fd);
+        if (name != nullptr) {
+            shm_unlink(name);
+        }
+        return nullptr;
+    }
+    if (name != nullptr) {
+        ipc->name_ = strdup(name);
+    }
+
+    // The segment is filled with 0: rings are empty
+    ipc->segment_->version = shm_ipc_version;
+    ipc->segment_->ring_size = size;
+    std::atomic_thread_fence(std::memory_order_release);
+    ipc->segment_->magic = shm_ipc_magic;
+
+    ipc->ring_size_ = size;
+    ipc->tx_ = &ipc->segment_->rings[0];
+    ipc->rx_ = &ipc->segment_->rings[1];
+    ipc->tx_data_ = reinterpret_cast<uint8_t *>(ipc->segment_) + data_offset;
+    ipc->rx_data_ = ipc->tx_data_ + size;
+    return ipc;
+}
+
+ShmIPC *ShmIPC::open(const char *name)
+{
+    int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        CMSISSTREAM_LOG_ERR("Can't open IPC shared memory %s\n", name);
+        return nullptr;
+    }
+    IPC *ipc = make(fd);
+    if (ipc == nullptr) {
+        ::close(fd);
+    }
+    return static_cast<ShmIPC *>(ipc);
+}
+
+IPC *ShmIPC::make(NativeHandle fd)
+{
+    struct stat st;
+    if ((fstat(fd, &st) != 0) ||
+        (static_cast<std::size_t>(st.st_size) < data_offset)) {
+        return nullptr;
+    }
+    const std::size_t total = static_cast<std::size_t>(st.st_size);
+    ShmIPC *ipc = attach(fd, total);
+    if (ipc == nullptr) {
+        return nullptr;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32_t size = ipc->segment_->ring_size;
+    if ((ipc->segment_->magic != shm_ipc_magic) || (ipc->segment_->version != shm_ipc_version) ||
+        (segment_size(size) != total)) {
+        // Don't close the fd owned by the caller
+        ipc->fd_ = -1;
+        delete ipc;
+        return nullptr;
+    }
+    ipc->ring_size_ = size;
+    ipc->tx_ = &ipc->segment_->rings[1];
+    ipc->rx_ = &ipc->segment_->rings[0];
+    ipc->rx_data_ = reinterpret_cast<uint8_t *>(ipc->segment_) + data_offset;
+    ipc->tx_data_ = ipc->rx_data_ + size;
+    return ipc;
+}
+
+ShmIPC::~ShmIPC()
+{
+    if (segment_ != nullptr) {
+        munmap(segment_, segment_size_);
+        segment_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    if (name_ != nullptr) {
+        shm_unlink(name_);
+        free(name_);
+        name_ = nullptr;
+    }
+}
+
+void ShmIPC::close() noexcept
+{
+    segment_->closed.store(1);
+    for (shm_ipc_ring_t &r : segment_->rings) {
+        futex_wake(&r.head, INT_MAX);
+        futex_wake(&r.tail, INT_MAX);
+    }
+}
+
+/* Wait until there are at least n free bytes in the ring.
+   Return false if the IPC was closed. */
+static bool wait_space(shm_ipc_segment_t *segment, shm_ipc_ring_t *ring, uint32_t ring_size,
+                       uint32_t head, uint32_t n)
+{
+    for (uint32_t i = 0; i < spin_count(); i++) {
+        if (ring_size - (head - ring->tail.load(std::memory_order_acquire)) >= n) {
+            return true;
+        }
+        cpu_relax();
+    }
+    while (true) {
+        ring->sender_waiting.store(1);
+        uint32_t tail = ring->tail.load();
+        if (ring_size - (head - tail) >= n) {
+            ring->sender_waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        if (segment->closed.load() != 0) {
+            return false;
+        }
+        futex_wait(&ring->tail, tail);
+    }
+}
+
+static void publish(shm_ipc_ring_t *ring, uint32_t head)
+{
+    ring->head.store(head);
+    if (ring->receiver_waiting.load() != 0) {
+        futex_wake(&ring->head, 1);
+    }
+}
+
+void ShmIPC::send_message(int dstPortOrNodeId, Event &&evt)
+{
+    const uint32_t nodeid = static_cast<uint32_t>(dstPortOrNodeId);
+    const std::size_t len = packedSize(nodeid, evt, false);
+    const uint32_t need = align8(4 + len);
+    if ((need > ring_size_ / 2) || (segment_->closed.load() != 0)) {
+        CMSISSTREAM_LOG_ERR("IPC event for node %u dropped\n", nodeid);
+        nbDropped_++;
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(send_mutex_);
+    const uint32_t mask = ring_size_ - 1;
+    uint32_t head = tx_->head.load(std::memory_order_relaxed);
+    uint32_t pos = head & mask;
+    if (pos + need > ring_size_) {
+        // Not enough contiguous space at the end of the ring
+        const uint32_t skip = ring_size_ - pos;
+        if (!wait_space(segment_, tx_, ring_size_, head, skip)) {
+            nbDropped_++;
+            return;
+        }
+        memcpy(tx_data_ + pos, &wrap_marker, 4);
+        head += skip;
+        publish(tx_, head);
+        pos = 0;
+    }
+    if (!wait_space(segment_, tx_, ring_size_, head, need)) {
+        nbDropped_++;
+        return;
+    }
+
+    uint8_t *dst = tx_data_ + pos;
+    uint32_t length = static_cast<uint32_t>(len);
+    RingPackInto encoder(dst + 4, len, acquired_);
+    encoder.pack(nodeid, evt, false);
+    if (!encoder.ok()) {
+        // The event changed between the size computation and the encoding.
+        // The receiver won't take the references of the shared buffers.
+        encoder.releaseAcquired();
+        length |= skip_bit;
+        nbDropped_++;
+    }
+    memcpy(dst, &length, 4);
+    publish(tx_, head + need);
+}
+
+/* Wait until the ring is not empty.
+   Return false if the ring is empty and the IPC was closed. */
+static bool wait_data(shm_ipc_segment_t *segment, shm_ipc_ring_t *ring, uint32_t tail)
+{
+    for (uint32_t i = 0; i < spin_count(); i++) {
+        if (ring->head.load(std::memory_order_acquire) != tail) {
+            return true;
+        }
+        cpu_relax();
+    }
+    while (true) {
+        ring->receiver_waiting.store(1);
+        uint32_t head = ring->head.load();
+        if (head != tail) {
+            ring->receiver_waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        if (segment->closed.load() != 0) {
+            ring->receiver_waiting.store(0, std::memory_order_relaxed);
+            return false;
+        }
+        futex_wait(&ring->head, head);
+    }
+}
+
+static void consume(shm_ipc_ring_t *ring, uint32_t tail)
+{
+    ring->tail.store(tail);
+    if (ring->sender_waiting.load() != 0) {
+        futex_wake(&ring->tail, 1);
+    }
+}
+
+Event ShmIPC::receive_message(uint32_t &nodeId)
+{
+    std::lock_guard<std::mutex> guard(receive_mutex_);
+    const uint32_t mask = ring_size_ - 1;
+    while (true) {
+        uint32_t tail = rx_->tail.load(std::memory_order_relaxed);
+        if (!wait_data(segment_, rx_, tail)) {
+            nodeId = static_cast<uint32_t>(CG_UNIDENTIFIED_NODE);
+            return Event();
+        }
+        const uint32_t pos = tail & mask;
+        uint32_t length;
+        memcpy(&length, rx_data_ + pos, 4);
+        if (length == wrap_marker) {
+            consume(rx_, tail + (ring_size_ - pos));
+            continue;
+        }
+        const uint32_t need = align8(4 + (length & ~skip_bit));
+        if ((length & skip_bit) != 0) {
+            consume(rx_, tail + need);
+            continue;
+        }
+        // Unpack copies the buffers: the ring memory can be reused
+        // as soon as the event is decoded
+        Unpack unpack(rx_data_ + pos + 4, length);
+        Event evt = unpack.unpack(nodeId);
+        consume(rx_, tail + need);
+        return evt;
+    }
+}
+
+#else
+
+ShmIPC *ShmIPC::create(const char *name, std::size_t ring_size)
+{
+    (void)name;
+    (void)ring_size;
+    CMSISSTREAM_LOG_ERR("Shared memory IPC is only supported on Linux\n");
+    return nullptr;
+}
+
+ShmIPC *ShmIPC::open(const char *name)
+{
+    (void)name;
+    CMSISSTREAM_LOG_ERR("Shared memory IPC is only supported on Linux\n");
+    return nullptr;
+}
+
+IPC *ShmIPC::make(NativeHandle fd)
+{
+    (void)fd;
+    return nullptr;
+}
+
+ShmIPC *ShmIPC::attach(int, std::size_t)
+{
+    return nullptr;
+}
+
+ShmIPC::~ShmIPC()
+{
+}
+
+void ShmIPC::close() noexcept
+{
+}
+
+void ShmIPC::send_message(int, Event &&)
+{
+    nbDropped_++;
+}
+
+Event ShmIPC::receive_message(uint32_t &nodeId)
+{
+    nodeId = static_cast<uint32_t>(CG_UNIDENTIFIED_NODE);
+    return Event();
+}
+
+#endif
@@ -0,0 +1,92 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_shm_ipc.hpp
+ * Description:  Shared memory IPC transport for Linux
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "StreamNode.hpp"
+#include "stream_ipc.hpp"
+#include "stream_platform_config.hpp"
+
+struct shm_ipc_segment_t;
+struct shm_ipc_ring_t;
+
+/*
+ * IPC between two local processes using two ring buffers (one per
+ * direction) in a shared memory segment.
+ *
+ * Events are encoded with cg_pack directly in the ring. Shared buffers
+ * are transmitted by global_id. A message must fit in half of a ring:
+ * use SharedBuffer for big tensors.
+ *
+ * A receiver waiting for an event first spins for
+ * CMSISSTREAM_IPC_SPIN_COUNT iterations (when there is more than one CPU)
+ * and then sleeps on a futex.
+ * The sender only makes a system call when the receiver is sleeping.
+ *
+ * Only available on Linux.
+ */
+class ShmIPC : public arm_cmsis_stream::IPC {
+  public:
+    /*
+     * Create the segment with rings of ring_size bytes (rounded up to a
+     * power of 2). With a name, the segment is created with shm_open and
+     * the peer uses open. Without a name, it is an anonymous memfd and fd()
+     * must be transmitted to the peer (fork or SCM_RIGHTS) that uses make.
+     */
+    static ShmIPC *create(const char *name, std::size_t ring_size);
+    /* Attach to the segment created by the peer */
+    static ShmIPC *open(const char *name);
+    /* Attach to the segment from its file descriptor (for IPC::mk_new_ipc) */
+    static arm_cmsis_stream::IPC *make(arm_cmsis_stream::NativeHandle fd);
+
+    ~ShmIPC();
+
+    ShmIPC(const ShmIPC &) = delete;
+    ShmIPC &operator=(const ShmIPC &) = delete;
+
+    /* dstPortOrNodeId is the identifier of the node in the peer process */
+    void send_message(int dstPortOrNodeId, arm_cmsis_stream::Event &&evt) final;
+    /* Wait for an event. Return an empty event when the IPC is closed. */
+    arm_cmsis_stream::Event receive_message(uint32_t &nodeId) final;
+
+    /* Wake the receivers of both processes. No more events are sent. */
+    void close() noexcept;
+
+    arm_cmsis_stream::NativeHandle fd() const noexcept { return fd_; }
+    /* Events dropped because they are too big for the ring or because
+       the IPC is closed */
+    uint64_t nbDropped() const noexcept { return nbDropped_.load(); }
+
+  private:
+    ShmIPC() = default;
+    static ShmIPC *attach(int fd, std::size_t segment_size);
+
+    int fd_ = -1;
+    char *name_ = nullptr;
+    shm_ipc_segment_t *segment_ = nullptr;
+    std::size_t segment_size_ = 0;
+    shm_ipc_ring_t *tx_ = nullptr;
+    shm_ipc_ring_t *rx_ = nullptr;
+    uint8_t *tx_data_ = nullptr;
+    uint8_t *rx_data_ = nullptr;
+    uint32_t ring_size_ = 0;
+
+    std::mutex send_mutex_;
+    // Shared buffers acquired for the message being sent (send_mutex_)
+    std::vector<int32_t> acquired_;
+    std::mutex receive_mutex_;
+    std::atomic<uint64_t> nbDropped_ = 0;
+};
@@ -0,0 +1,401 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_socket_ipc.cpp
+ * Description:  Socket IPC transport with file descriptor passing
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "stream_socket_ipc.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace arm_cmsis_stream;
+
+static_assert(CMSISSTREAM_IPC_MAX_FDS >= CG_MAX_VALUES,
+              "A frame must be able to contain the descriptors of one event");
+
+#ifdef MSG_NOSIGNAL
+static constexpr int send_flags = MSG_NOSIGNAL;
+#else
+static constexpr int send_flags = 0;
+#endif
+
+#ifdef MSG_CMSG_CLOEXEC
+static constexpr int recv_flags = MSG_CMSG_CLOEXEC;
+#else
+static constexpr int recv_flags = 0;
+#endif
+
+static constexpr std::size_t frame_header_size = 8;
+
+union socket_ipc_control_t {
+    struct cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(int) * CMSISSTREAM_IPC_MAX_FDS)];
+};
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = uint8_t(v & 0xFF);
+    p[1] = uint8_t((v >> 8) & 0xFF);
+    p[2] = uint8_t((v >> 16) & 0xFF);
+    p[3] = uint8_t((v >> 24) & 0xFF);
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+            (uint32_t(p[3]) << 24));
+}
+
+static bool read_all(int sock, uint8_t *dst, std::size_t size)
+{
+    while (size > 0) {
+        ssize_t n = recv(sock, dst, size, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) {
+            return false;
+        }
+        dst += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+static int unix_socket(const char *path, struct sockaddr_un &addr)
+{
+    if (std::strlen(path) >= sizeof(addr.sun_path)) {
+        CMSISSTREAM_LOG_ERR("Socket path too long: %s\n", path);
+        return -1;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+int SocketIPC::listen(const char *path)
+{
+    struct sockaddr_un addr;
+    int sock = unix_socket(path, addr);
+    if (sock < 0) {
+        return -1;
+    }
+    unlink(path);
+    if ((bind(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) ||
+        (::listen(sock, 8) != 0)) {
+        CMSISSTREAM_LOG_ERR("Can't listen on %s\n", path);
+        ::close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+SocketIPC *SocketIPC::accept(int listen_fd)
+{
+    int sock;
+    do {
+        sock = ::accept(listen_fd, nullptr, nullptr);
+    } while ((sock < 0) && (errno == EINTR));
+    if (sock < 0) {
+        return nullptr;
+    }
+    IPC *ipc = make(sock);
+    if (ipc == nullptr) {
+        ::close(sock);
+    }
+    return static_cast<SocketIPC *>(ipc);
+}
+
+SocketIPC *SocketIPC::connect(const char *path)
+{
+    struct sockaddr_un addr;
+    int sock = unix_socket(path, addr);
+    if (sock < 0) {
+        return nullptr;
+    }
+    if (::connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        CMSISSTREAM_LOG_ERR("Can't connect to %s\n", path);
+        ::close(sock);
+        return nullptr;
+    }
+    IPC *ipc = make(sock);
+    if (ipc == nullptr) {
+        ::close(sock);
+    }
+    return static_cast<SocketIPC *>(ipc);
+}
+
+IPC *SocketIPC::make(NativeHandle sock)
+{
+    return new (std::nothrow) SocketIPC(sock);
+}
+
+SocketIPC::SocketIPC(int sock) : sock_(sock)
+{
+    struct sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    if (getsockname(sock, reinterpret_cast<struct sockaddr *>(&addr), &len) == 0) {
+        if (addr.ss_family == AF_UNIX) {
+            pass_fds_ = true;
+        } else if ((addr.ss_family == AF_INET) || (addr.ss_family == AF_INET6)) {
+            // Events are already batched
+            int one = 1;
+            (void)setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+    }
+    pending_.collectDescriptors(pass_fds_);
+    sender_ = std::thread([this] { senderThread(); });
+}
+
+SocketIPC::~SocketIPC()
+{
+    close();
+    closeUnusedDescriptors();
+    ::close(sock_);
+}
+
+void SocketIPC::send_message(int dstPortOrNodeId, Event &&evt)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] {
+        return closed_ || broken_ || (pending_.nb_events() == 0) ||
+               ((pending_.size() < CMSISSTREAM_IPC_BATCH_BYTES) &&
+                (pending_.descriptors().size() + CG_MAX_VALUES <= CMSISSTREAM_IPC_MAX_FDS));
+    });
+    if (closed_ || broken_) {
+        nbDropped_++;
+        return;
+    }
+    const std::size_t nb_fds = pending_.descriptors().size();
+    pending_.add(static_cast<uint32_t>(dstPortOrNodeId), evt, false);
+    if (pending_.descriptors().size() != nb_fds) {
+        // The file descriptors must stay open until the frame is sent
+        pending_events_.push_back(std::move(evt));
+    }
+    cond_.notify_all();
+}
+
+void SocketIPC::senderThread()
+{
+    PackBatch sending;
+    sending.collectDescriptors(pass_fds_);
+    std::vector<Event> events;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] { return closed_ || (pending_.nb_events() > 0); });
+        if (pending_.nb_events() == 0) {
+            break;
+        }
+        // The events sent while this frame is written are
+        // accumulated in the next one
+        std::swap(pending_, sending);
+        events.swap(pending_events_);
+        sending_ = true;
+        const bool broken = broken_;
+        cond_.notify_all();
+        lock.unlock();
+
+        const bool ok = !broken && writeFrame(sending);
+        events.clear();
+
+        lock.lock();
+        sending_ = false;
+        if (ok) {
+            stats_.nb_frames++;
+            stats_.nb_events += sending.nb_events();
+            stats_.nb_descriptors += sending.descriptors().size();
+            stats_.nb_bytes += frame_header_size + sending.size();
+        } else {
+            broken_ = true;
+            nbDropped_ += sending.nb_events();
+        }
+        sending.reset();
+        cond_.notify_all();
+    }
+}
+
+bool SocketIPC::writeFrame(const PackBatch &batch)
+{
+    const std::vector<uint8_t> &data = batch.vector();
+    const std::vector<NativeHandle> &fds = batch.descriptors();
+
+    uint8_t header[frame_header_size];
+    put_u32(header, static_cast<uint32_t>(data.size()));
+    put_u32(header + 4, static_cast<uint32_t>(fds.size()));
+
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = const_cast<uint8_t *>(data.data());
+    iov[1].iov_len = data.size();
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    socket_ipc_control_t control;
+    if (!fds.empty()) {
+        std::memset(&control, 0, sizeof(control));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    }
+
+    std::size_t remaining = sizeof(header) + data.size();
+    while (remaining > 0) {
+        ssize_t n = sendmsg(sock_, &msg, send_flags);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            CMSISSTREAM_LOG_ERR("IPC socket write error %d\n", errno);
+            return false;
+        }
+        remaining -= static_cast<std::size_t>(n);
+        // The file descriptors are sent with the first bytes only
+        msg.msg_control = nullptr;
+        msg.msg_controllen = 0;
+        std::size_t done = static_cast<std::size_t>(n);
+        while ((msg.msg_iovlen > 0) && (done >= msg.msg_iov->iov_len)) {
+            done -= msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov->iov_base = static_cast<uint8_t *>(msg.msg_iov->iov_base) + done;
+            msg.msg_iov->iov_len -= done;
+        }
+    }
+    return true;
+}
+
+void SocketIPC::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return broken_ || ((pending_.nb_events() == 0) && !sending_); });
+}
+
+void SocketIPC::close() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        cond_.notify_all();
+    }
+    // The thread sends the pending events before stopping
+    if (sender_.joinable()) {
+        sender_.join();
+    }
+    (void)shutdown(sock_, SHUT_RDWR);
+}
+
+void SocketIPC::stats(stream_socket_ipc_stats_t &stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats = stats_;
+}
+
+void SocketIPC::closeUnusedDescriptors()
+{
+    for (uint32_t i = rx_descriptors_.next; i < rx_descriptors_.nb; i++) {
+        ::close(rx_fds_[i]);
+    }
+    rx_fds_.clear();
+    rx_descriptors_ = {nullptr, 0, 0};
+}
+
+bool SocketIPC::readFrame()
+{
+    uint8_t header[frame_header_size];
+    struct iovec iov;
+    iov.iov_base = header;
+    iov.iov_len = sizeof(header);
+
+    socket_ipc_control_t control;
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    ssize_t n;
+    do {
+        n = recvmsg(sock_, &msg, recv_flags);
+    } while ((n < 0) && (errno == EINTR));
+    if (n <= 0) {
+        return false;
+    }
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+            const std::size_t nb = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const int *received = reinterpret_cast<const int *>(CMSG_DATA(cmsg));
+            rx_fds_.insert(rx_fds_.end(), received, received + nb);
+        }
+    }
+    rx_descriptors_ = {rx_fds_.data(), static_cast<uint32_t>(rx_fds_.size()), 0};
+
+    if ((static_cast<std::size_t>(n) < sizeof(header)) &&
+        !read_all(sock_, header + n, sizeof(header) - static_cast<std::size_t>(n))) {
+        return false;
+    }
+    const uint32_t size = get_u32(header);
+    const uint32_t nb_fds = get_u32(header + 4);
+    if (((msg.msg_flags & MSG_CTRUNC) != 0) || (nb_fds != rx_fds_.size())) {
+        CMSISSTREAM_LOG_ERR("IPC frame with %u file descriptors but %u received\n", nb_fds,
+                            static_cast<uint32_t>(rx_fds_.size()));
+        return false;
+    }
+
+    rx_buffer_.resize(size);
+    if (!read_all(sock_, rx_buffer_.data(), size)) {
+        return false;
+    }
+    rx_batch_ = UnpackBatch(rx_buffer_.data(), size);
+    rx_batch_.setDescriptors(&rx_descriptors_);
+    return true;
+}
+
+Event SocketIPC::receive_message(uint32_t &nodeId)
+{
+    std::lock_guard<std::mutex> guard(receive_mutex_);
+    while (true) {
+        Event evt;
+        if (rx_batch_.next(nodeId, evt)) {
+            return evt;
+        }
+        // Descriptors of the frame not used by a shared buffer
+        closeUnusedDescriptors();
+        if (!readFrame()) {
+            closeUnusedDescriptors();
+            rx_batch_ = UnpackBatch(nullptr, 0);
+            nodeId = static_cast<uint32_t>(CG_UNIDENTIFIED_NODE);
+            return Event();
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS Stream Library
+ * Title:        stream_socket_ipc.hpp
+ * Description:  Socket IPC transport with file descriptor passing
+ * --------------------------------------------------------------------
+ *
+ * Copyright (C) 2026 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "StreamNode.hpp"
+#include "cg_pack.hpp"
+#include "stream_ipc.hpp"
+#include "stream_platform_config.hpp"
+
+typedef struct {
+    /* sendmsg calls (one frame each) */
+    uint64_t nb_frames;
+    uint64_t nb_events;
+    /* File descriptors sent with SCM_RIGHTS */
+    uint64_t nb_descriptors;
+    uint64_t nb_bytes;
+} stream_socket_ipc_stats_t;
+
+/*
+ * IPC over a connected stream socket.
+ *
+ * Events sent while the previous frame is being written are packed in
+ * the same batch frame so that several events are sent with one
+ * sendmsg under load, without adding latency to an isolated event.
+ * send_message only packs the event: a thread of the IPC sends the
+ * frames. It blocks when the pending batch is bigger than
+ * CMSISSTREAM_IPC_BATCH_BYTES.
+ *
+ * On an AF_UNIX socket, the file descriptors of the shared buffers are
+ * sent with the frame (SCM_RIGHTS, at most CMSISSTREAM_IPC_MAX_FDS per
+ * frame) and the receiver creates the descriptors with
+ * Descriptor::mk_new_descriptor: the MemServer is not contacted to get
+ * the buffers. On other sockets (TCP), shared buffers are sent by
+ * global_id.
+ *
+ * Frame: 32 bits payload size, 32 bits number of file descriptors,
+ * batch frame (see PackBatch).
+ */
+class SocketIPC : public arm_cmsis_stream::IPC {
+  public:
+    /* Listening AF_UNIX socket. Return -1 in case of error. */
+    static int listen(const char *path);
+    static SocketIPC *accept(int listen_fd);
+    static SocketIPC *connect(const char *path);
+    /* The IPC owns the connected socket (for IPC::mk_new_ipc) */
+    static arm_cmsis_stream::IPC *make(arm_cmsis_stream::NativeHandle sock);
+
+    ~SocketIPC();
+
+    SocketIPC(const SocketIPC &) = delete;
+    SocketIPC &operator=(const SocketIPC &) = delete;
+
+    /* dstPortOrNodeId is the identifier of the node in the peer process */
+    void send_message(int dstPortOrNodeId, arm_cmsis_stream::Event &&evt) final;
+    /* Wait for an event. Return an empty event when the connection is closed. */
+    arm_cmsis_stream::Event receive_message(uint32_t &nodeId) final;
+
+    /* Wait until the pending events have been written to the socket */
+    void flush();
+    /* Send the pending events and shutdown the connection */
+    void close() noexcept;
+
+    arm_cmsis_stream::NativeHandle fd() const noexcept { return sock_; }
+    bool passDescriptors() const noexcept { return pass_fds_; }
+    /* Events not sent because the connection is closed or broken */
+    uint64_t nbDropped() const noexcept { return nbDropped_.load(); }
+    void stats(stream_socket_ipc_stats_t &stats) const;
+
+  private:
+    explicit SocketIPC(int sock);
+
+    void senderThread();
+    bool writeFrame(const arm_cmsis_stream::PackBatch &batch);
+    bool readFrame();
+    void closeUnusedDescriptors();
+
+    int sock_;
+    bool pass_fds_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    arm_cmsis_stream::PackBatch pending_;
+    /* Events owning the file descriptors of the pending batch */
+    std::vector<arm_cmsis_stream::Event> pending_events_;
+    bool sending_ = false;
+    bool closed_ = false;
+    bool broken_ = false;
+    std::thread sender_;
+    stream_socket_ipc_stats_t stats_ = {0, 0, 0, 0};
+
+    std::mutex receive_mutex_;
+    std::vector<uint8_t> rx_buffer_;
+    std::vector<arm_cmsis_stream::NativeHandle> rx_fds_;
+    arm_cmsis_stream::ReceivedDescriptors rx_descriptors_ = {nullptr, 0, 0};
+    arm_cmsis_stream::UnpackBatch rx_batch_{nullptr, 0};
+
+    std::atomic<uint64_t> nbDropped_ = 0;
+};